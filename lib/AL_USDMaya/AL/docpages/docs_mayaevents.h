@@ -107,6 +107,21 @@ The following table lists the registered event name, and the type of callback fu
 \li \b "BeforePluginUnload" - AL::maya::event::MayaCallbackType::kStringArrayFunction
 \li \b "AfterPluginUnload" - AL::maya::event::MayaCallbackType::kStringArrayFunction
 
+Callbacks on the "NodeAdded" and "NodeRemoved" events are triggered for every node created or deleted in the scene. If
+a callback is only interested in a single node type, register it with AL::maya::event::MayaEventManager::registerNodeTypeCallback
+instead, which installs one maya callback per node type (as the event "NodeAdded:<nodeType>"), so the callback is never
+dispatched for nodes of other types:
+
+\code
+  g_callback = AL::maya::event::MayaEventManager::instance().registerNodeTypeCallback(
+    onTransformAdded,
+    "NodeAdded",
+    "transform",
+    "MyPlugin_MyCallback",
+    99999,
+    nullptr);
+\endcode
+
 \section mayaevent_example example code
 
 A quick example of replacing a MSceneMessage::kAfterNew message with the events system
@@ -28,7 +28,6 @@ class StageData;
 class StageCache;
 
 namespace cmds {
-struct CompareLayerHandle;
 class LayerCommandBase;
 class LayerConstructTree;
 class LayerCreateSubLayer;
@@ -15,6 +15,7 @@
 //
 #include "AL/usdmaya/Global.h"
 #include "AL/usdmaya/StageCache.h"
+#include "AL/usdmaya/StageData.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/TypeIDs.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
@@ -225,6 +226,7 @@ AL::event::CallbackId Global::m_postRead;
 AL::event::CallbackId Global::m_fileNew;
 AL::event::CallbackId Global::m_preExport;
 AL::event::CallbackId Global::m_postExport;
+AL::event::CallbackId Global::m_mayaExiting;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -509,6 +511,12 @@ static void postFileExport(void* p)
   postFileSave(p);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+static void onMayaExiting(void*)
+{
+  StageData::releaseAllStages();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Global::onPluginLoad()
 {
@@ -522,6 +530,7 @@ void Global::onPluginLoad()
   m_postRead = manager.registerCallback(postFileRead, "AfterFileRead", "usdmaya_postFileRead", 0x1000);
   m_preExport = manager.registerCallback(preFileExport, "BeforeExport", "usdmaya_preFileExport", 0x1000);
   m_postExport = manager.registerCallback(postFileExport, "AfterExport", "usdmaya_postFileExport", 0x1000);
+  m_mayaExiting = manager.registerCallback(onMayaExiting, "MayaExiting", "DestroyStageDataOnExit", 0x10000);
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("Registering USD plugins\n");
   // Let USD know about the additional plugins
@@ -552,6 +561,7 @@ void Global::onPluginUnload()
   manager.unregisterCallback(m_postRead);
   manager.unregisterCallback(m_preExport);
   manager.unregisterCallback(m_postExport);
+  manager.unregisterCallback(m_mayaExiting);
   StageCache::removeCallbacks();
 
   AL::maya::event::MayaEventManager::freeInstance();
@@ -71,6 +71,7 @@ private:
   static AL::event::CallbackId m_fileNew;  ///< callback used to flush the USD caches after a file new
   static AL::event::CallbackId m_preExport; ///< callback prior to exporting the scene (so we can store the session layer)
   static AL::event::CallbackId m_postExport; ///< callback after exporting
+  static AL::event::CallbackId m_mayaExiting; ///< callback used to release the stages held by the StageData on exit
 
 #if defined(WANT_UFE_BUILD)
   class UfeSelectionObserver;
@@ -0,0 +1,175 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/LockPrimIndex.h"
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LockPrimIndex::resolve(const SdfPath& path, const Entry& entry) const
+{
+  if(entry.m_state == kLockTransform)
+  {
+    return true;
+  }
+  auto parent = m_entries.find(path.GetParentPath());
+  return parent != m_entries.end() && parent->second.m_locked;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LockPrimIndex::propagate(EntryMap::iterator it)
+{
+  // re-resolve the tracked descendants of the path in order, so that a parent is always resolved before its children.
+  // If a descendant's lock does not change, then neither can the locks of its own descendants, so they are skipped.
+  const SdfPath root = it->first;
+  const auto end = m_entries.end();
+  ++it;
+  while(it != end && it->first.HasPrefix(root))
+  {
+    const bool locked = resolve(it->first, it->second);
+    if(locked == it->second.m_locked)
+    {
+      const SdfPath& unchanged = it->first;
+      for(++it; it != end && it->first.HasPrefix(unchanged); ++it)
+        ;
+      continue;
+    }
+    it->second.m_locked = locked;
+    m_changed.insert(it->first);
+    ++it;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LockPrimIndex::setState(const SdfPath& path, LockState state)
+{
+  if(m_rebuilding)
+  {
+    Entry& entry = m_entries[path];
+    entry.m_state = state;
+    entry.m_locked = false;
+    return true;
+  }
+
+  auto inserted = m_entries.emplace(path, Entry{state, false});
+  Entry& entry = inserted.first->second;
+  if(!inserted.second && entry.m_state == state)
+  {
+    return false;
+  }
+  entry.m_state = state;
+
+  const bool locked = resolve(path, entry);
+  if(locked != entry.m_locked)
+  {
+    entry.m_locked = locked;
+    m_changed.insert(path);
+    propagate(inserted.first);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LockPrimIndex::remove(const SdfPath& path)
+{
+  auto it = m_entries.find(path);
+  if(it == m_entries.end())
+  {
+    return false;
+  }
+  if(m_rebuilding)
+  {
+    m_entries.erase(it);
+    return true;
+  }
+
+  // an untracked prim behaves as an unlocked one, so mark it unlocked and pass that on before removing it
+  if(it->second.m_locked)
+  {
+    it->second.m_locked = false;
+    m_changed.insert(path);
+    propagate(it);
+  }
+  m_entries.erase(it);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LockPrimIndex::beginRebuild()
+{
+  m_previous.clear();
+  m_previous.swap(m_entries);
+  m_rebuilding = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LockPrimIndex::endRebuild()
+{
+  m_rebuilding = false;
+  for(auto& it : m_entries)
+  {
+    it.second.m_locked = resolve(it.first, it.second);
+  }
+
+  // both maps are sorted, so the paths whose lock changed can be found with a single merge
+  auto curr = m_entries.begin();
+  auto prev = m_previous.begin();
+  const auto currEnd = m_entries.end();
+  const auto prevEnd = m_previous.end();
+  while(curr != currEnd || prev != prevEnd)
+  {
+    if(prev == prevEnd || (curr != currEnd && curr->first < prev->first))
+    {
+      if(curr->second.m_locked)
+        m_changed.insert(curr->first);
+      ++curr;
+    }
+    else
+    if(curr == currEnd || prev->first < curr->first)
+    {
+      if(prev->second.m_locked)
+        m_changed.insert(prev->first);
+      ++prev;
+    }
+    else
+    {
+      if(curr->second.m_locked != prev->second.m_locked)
+        m_changed.insert(curr->first);
+      ++curr;
+      ++prev;
+    }
+  }
+  m_previous.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LockPrimIndex::isLocked(const SdfPath& path) const
+{
+  auto it = m_entries.find(path);
+  return it != m_entries.end() && it->second.m_locked;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LockPrimIndex::takeChangedPaths(SdfPathVector& paths)
+{
+  paths.assign(m_changed.begin(), m_changed.end());
+  m_changed.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
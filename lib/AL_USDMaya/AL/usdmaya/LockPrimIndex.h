@@ -0,0 +1,135 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "./Api.h"
+#include "./MemoryUsage.h"
+
+#include "pxr/pxr.h"
+#include "pxr/usd/sdf/path.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_set>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+
+///---------------------------------------------------------------------------------------------------------------------
+/// \brief  Stores the lock metadata of the prims in a stage, and resolves which of those prims are locked.
+///         A prim that has "lock_transform" set is locked. A prim that has "lock_inherited" set (or no lock metadata)
+///         is locked if its parent is tracked and locked. Prims that are not tracked (e.g. "unlocked") stop the
+///         inheritance. Changing the state of a prim only re-resolves the tracked prims underneath it, and the paths
+///         whose resolved lock changed are recorded so that the caller only needs to update those.
+///---------------------------------------------------------------------------------------------------------------------
+class LockPrimIndex
+{
+public:
+
+  /// the lock state authored on a prim
+  enum LockState : uint8_t
+  {
+    kLockTransform, ///< the prim is locked
+    kLockInherited  ///< the prim is locked if its parent is
+  };
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Sets the lock state of a path, and re-resolves the locks of the paths beneath it
+  /// \param  path the prim path
+  /// \param  state the authored lock state
+  /// \return true if the state of the path was modified
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  bool setState(const SdfPath& path, LockState state);
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Stops tracking a path (i.e. it is unlocked, and does not pass a lock on to its children)
+  /// \param  path the prim path
+  /// \return true if the path was being tracked
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  bool remove(const SdfPath& path);
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Starts a full rebuild of the index. Between this call and endRebuild, setState only records the states,
+  ///         and endRebuild resolves all of the locks in one pass. Paths that are not set again are removed.
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  void beginRebuild();
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Completes a rebuild started with beginRebuild, recording every path whose lock has changed.
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  void endRebuild();
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns true if the path is locked
+  /// \param  path the prim path to query
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  bool isLocked(const SdfPath& path) const;
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns the paths whose lock may have changed since the last call, and clears them
+  /// \param  paths the returned paths
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  void takeChangedPaths(SdfPathVector& paths);
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns the number of tracked paths
+  ///-------------------------------------------------------------------------------------------------------------------
+  inline size_t size() const
+    { return m_entries.size(); }
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns the number of paths whose lock has changed, and that have not been taken yet
+  ///-------------------------------------------------------------------------------------------------------------------
+  inline size_t numChangedPaths() const
+    { return m_changed.size(); }
+
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns the approximate number of bytes allocated by the index
+  ///-------------------------------------------------------------------------------------------------------------------
+  inline size_t approximateBytes() const
+    { return treeBytes(m_entries) + treeBytes(m_previous) + hashBytes(m_changed); }
+
+private:
+  struct Entry
+  {
+    LockState m_state;
+    bool m_locked;
+  };
+  // sorted by path, so that all of the descendants of a path immediately follow it.
+  typedef std::map<SdfPath, Entry> EntryMap;
+
+  bool resolve(const SdfPath& path, const Entry& entry) const;
+  void propagate(EntryMap::iterator it);
+
+private:
+  EntryMap m_entries;
+  EntryMap m_previous;
+  std::unordered_set<SdfPath, SdfPath::Hash> m_changed;
+  bool m_rebuilding = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,64 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The number of elements, and the approximate number of heap allocated bytes, of a named data structure.
+/// \ingroup usdmaya
+//----------------------------------------------------------------------------------------------------------------------
+struct MemoryUsageEntry
+{
+  std::string name; ///< the name of the data structure
+  size_t count; ///< the number of elements it holds
+  size_t bytes; ///< the approximate number of bytes allocated by the structure
+};
+
+/// an array of memory usage entries
+typedef std::vector<MemoryUsageEntry> MemoryUsage;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \name   Approximations of the heap storage of the standard containers. These only account for the memory owned by
+///         the container itself (elements and the per-node bookkeeping of the common implementations), not the memory
+///         referenced by the elements. SdfPath and TfToken data, for example, live in shared global tables.
+//----------------------------------------------------------------------------------------------------------------------
+
+/// \brief  the approximate heap size of a std::vector
+template<typename T>
+inline size_t vectorBytes(const T& container)
+  { return container.capacity() * sizeof(typename T::value_type); }
+
+/// \brief  the approximate heap size of a std::map or std::set (a red-black tree node per element)
+template<typename T>
+inline size_t treeBytes(const T& container)
+  { return container.size() * (sizeof(typename T::value_type) + 4 * sizeof(void*)); }
+
+/// \brief  the approximate heap size of a std::unordered_map or std::unordered_set (a list node per element, plus the
+///         bucket array)
+template<typename T>
+inline size_t hashBytes(const T& container)
+  { return container.size() * (sizeof(typename T::value_type) + 2 * sizeof(void*)) + container.bucket_count() * sizeof(void*); }
+
+//----------------------------------------------------------------------------------------------------------------------
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
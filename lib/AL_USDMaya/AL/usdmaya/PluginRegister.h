@@ -201,6 +201,8 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL_REGISTER_DATA(plugin, AL::usdmaya::StageData);
   AL_REGISTER_DATA(plugin, AL::usdmaya::DrivenTransformsData);
   AL_REGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
+  AL_REGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiDeferredEval);
+  AL::maya::utils::MenuBuilder::setDeferredEvalCommand(AL::maya::utils::CommandGuiDeferredEval::kName);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::CreateUsdPrim);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::LayerCreateLayer);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::LayerGetLayers);
@@ -221,6 +223,7 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapePostSelect);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::InternalProxyShapeSelect);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::UsdDebugCommand);
+  AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeMemoryUsage);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ListEvents);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ListCallbacks);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::Callback);
@@ -268,9 +271,8 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL::usdmaya::cmds::constructRendererCommandGuis();
   AL::usdmaya::cmds::constructPickModeCommandGuis();
 
-  MGlobal::executeCommand(g_geom_deformer_code);
-  AL::maya::utils::MenuBuilder::addEntry("USD/Animated Geometry/Connect selected meshes to USD (static)", "AL_usdmaya_meshStaticImport");
-  AL::maya::utils::MenuBuilder::addEntry("USD/Animated Geometry/Connect selected meshes to USD (animated)", "AL_usdmaya_meshAnimImport");
+  AL::maya::utils::MenuBuilder::addSourcedEntry("USD/Animated Geometry/Connect selected meshes to USD (static)", "AL_usdmaya_meshStaticImport", "AL_usdmaya_geomDeformer", g_geom_deformer_code);
+  AL::maya::utils::MenuBuilder::addSourcedEntry("USD/Animated Geometry/Connect selected meshes to USD (animated)", "AL_usdmaya_meshAnimImport", "AL_usdmaya_geomDeformer", g_geom_deformer_code);
   CHECK_MSTATUS(AL::maya::utils::MenuBuilder::generatePluginUI(plugin, "AL_usdmaya"));
   AL::usdmaya::Global::onPluginLoad();
   return status;
@@ -307,6 +309,9 @@ MStatus unregisterPlugin(AFnPlugin& plugin)
   }
 
   AL_UNREGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
+  AL_UNREGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiDeferredEval);
+  AL::maya::utils::MenuBuilder::setDeferredEvalCommand(MString());
+  AL::maya::utils::MenuBuilder::clearDeferredSources();
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::InternalProxyShapeSelect);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapePostSelect);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeSelect);
@@ -335,6 +340,7 @@ MStatus unregisterPlugin(AFnPlugin& plugin)
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::EventQuery);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::EventLookup);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::UsdDebugCommand);
+  AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeMemoryUsage);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::fileio::ImportCommand);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::fileio::ExportCommand);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::TranslatePrim);
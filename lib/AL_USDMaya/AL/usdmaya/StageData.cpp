@@ -19,6 +19,9 @@
 
 #include "maya/MTypeId.h"
 #include "maya/MString.h"
+
+#include <mutex>
+
 namespace AL {
 namespace usdmaya {
 
@@ -26,11 +29,29 @@ const MTypeId StageData::kTypeId(AL_USDMAYA_STAGEDATA);
 const MString StageData::kName("AL_usdmaya_StageData");
 
 
+namespace {
+// MPxData instances are created and destroyed from the DG evaluation threads, so the list is guarded by a mutex
+std::mutex g_instancesMutex;
+StageData* g_instances = nullptr;
+size_t g_numInstances = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void StageData::releaseAllStages()
+{
+  std::lock_guard<std::mutex> lock(g_instancesMutex);
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StageData::releaseAllStages() releasing %zu instances\n", g_numInstances);
+  for(StageData* gd = g_instances; gd; gd = gd->m_next)
+  {
+    gd->stage = UsdStageRefPtr();
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
-static void _cleanUp(void* gdPtr)
+size_t StageData::numInstances()
 {
-  StageData *gd = (StageData*)gdPtr;
-  gd->stage = UsdStageRefPtr();
+  std::lock_guard<std::mutex> lock(g_instancesMutex);
+  return g_numInstances;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -53,14 +74,38 @@ void StageData::copy(const MPxData& data)
 //----------------------------------------------------------------------------------------------------------------------
 StageData::StageData()
 {
-  m_exitCallbackId = AL::maya::event::MayaEventManager::instance().registerCallback(_cleanUp, "MayaExiting", "DestroyStageDataOnExit", 0x10000, this);
+  {
+    std::lock_guard<std::mutex> lock(g_instancesMutex);
+    m_next = g_instances;
+    if(g_instances)
+    {
+      g_instances->m_prev = this;
+    }
+    g_instances = this;
+    ++g_numInstances;
+  }
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StageData::StageData() created: %p\n", this);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 StageData::~StageData()
 {
-  AL::maya::event::MayaEventManager::instance().unregisterCallback(m_exitCallbackId);
+  {
+    std::lock_guard<std::mutex> lock(g_instancesMutex);
+    if(m_prev)
+    {
+      m_prev->m_next = m_next;
+    }
+    else
+    {
+      g_instances = m_next;
+    }
+    if(m_next)
+    {
+      m_next->m_prev = m_prev;
+    }
+    --g_numInstances;
+  }
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StageData::StageData() deleted: %p\n", this);
 }
 
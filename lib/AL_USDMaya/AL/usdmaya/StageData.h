@@ -39,11 +39,16 @@ class StageData
 public:
 
   /// \brief  ctor
+  AL_USDMAYA_PUBLIC
   StageData();
 
   /// \brief  dtor
+  AL_USDMAYA_PUBLIC
   ~StageData();
 
+  StageData(const StageData&) = delete;
+  StageData& operator = (const StageData&) = delete;
+
   /// \brief  creates an instance of this data object
   AL_USDMAYA_PUBLIC
   static void* creator();
@@ -66,10 +71,23 @@ public:
   /// the prim path root
   SdfPath primPath;
 
+  /// \brief  releases the stages held by all of the StageData instances that are still alive. Called once by the
+  ///         process-wide MayaExiting callback (see Global::onPluginLoad), rather than each instance registering a
+  ///         callback of its own.
+  AL_USDMAYA_PUBLIC
+  static void releaseAllStages();
+
+  /// \brief  returns the number of StageData instances that are currently alive
+  AL_USDMAYA_PUBLIC
+  static size_t numInstances();
+
 private:
   MTypeId typeId() const override;
   MString name() const override;
-  AL::event::CallbackId m_exitCallbackId;
+
+  // all live instances are kept in an intrusive list, so construction and destruction only relink two pointers
+  StageData* m_prev = nullptr;
+  StageData* m_next = nullptr;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -15,6 +15,8 @@
 //
 #include "AL/usdmaya/cmds/DebugCommands.h"
 #include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/nodes/LayerManager.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/maya/utils/MenuBuilder.h"
 
 #include "pxr/base/tf/debug.h"
@@ -23,6 +25,8 @@
 #include "maya/MGlobal.h"
 #include "maya/MArgDatabase.h"
 #include "maya/MStringArray.h"
+#include "maya/MIntArray.h"
+#include "maya/MDoubleArray.h"
 
 namespace AL {
 namespace usdmaya {
@@ -108,6 +112,90 @@ MStatus UsdDebugCommand::doIt(const MArgList& argList)
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+AL_MAYA_DEFINE_COMMAND(ProxyShapeMemoryUsage, AL_usdmaya);
+
+//----------------------------------------------------------------------------------------------------------------------
+MSyntax ProxyShapeMemoryUsage::createSyntax()
+{
+  MSyntax syn = setUpCommonSyntax();
+  syn.addFlag("-h", "-help", MSyntax::kNoArg);
+  syn.addFlag("-n", "-names", MSyntax::kNoArg);
+  syn.addFlag("-c", "-counts", MSyntax::kNoArg);
+  syn.addFlag("-b", "-bytes", MSyntax::kNoArg);
+  return syn;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShapeMemoryUsage::isUndoable() const
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus ProxyShapeMemoryUsage::doIt(const MArgList& argList)
+{
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("AL_usdmaya_ProxyShapeMemoryUsage::doIt\n");
+  try
+  {
+    MArgDatabase args = makeDatabase(argList);
+    AL_MAYA_COMMAND_HELP(args, g_helpText);
+
+    nodes::ProxyShape* proxy = getShapeNode(args);
+    MemoryUsage usage;
+    proxy->memoryUsage(usage);
+    if(nodes::LayerManager* layerManager = nodes::LayerManager::findManager())
+    {
+      layerManager->memoryUsage(usage);
+    }
+
+    if(args.isFlagSet("-n"))
+    {
+      MStringArray names;
+      for(const auto& entry : usage)
+      {
+        names.append(MString(entry.name.c_str(), entry.name.size()));
+      }
+      setResult(names);
+    }
+    else
+    if(args.isFlagSet("-c"))
+    {
+      MIntArray counts;
+      for(const auto& entry : usage)
+      {
+        counts.append(int(entry.count));
+      }
+      setResult(counts);
+    }
+    else
+    if(args.isFlagSet("-b"))
+    {
+      // returned as doubles, since the byte counts of large stages can overflow an int
+      MDoubleArray bytes;
+      for(const auto& entry : usage)
+      {
+        bytes.append(double(entry.bytes));
+      }
+      setResult(bytes);
+    }
+    else
+    {
+      double total = 0;
+      for(const auto& entry : usage)
+      {
+        total += double(entry.bytes);
+      }
+      setResult(total);
+    }
+  }
+  catch(const MStatus& status)
+  {
+    return status;
+  }
+  return MS::kSuccess;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // The MEL script user interface code for the debug GUI
 //----------------------------------------------------------------------------------------------------------------------
@@ -197,8 +285,7 @@ global proc AL_usdmaya_debug_gui()
 //----------------------------------------------------------------------------------------------------------------------
 void constructDebugCommandGuis()
 {
-  MGlobal::executeCommand(g_usdmaya_debug_gui);
-  AL::maya::utils::MenuBuilder::addEntry("USD/Debug/TfDebug Options", "AL_usdmaya_debug_gui");
+  AL::maya::utils::MenuBuilder::addSourcedEntry("USD/Debug/TfDebug Options", "AL_usdmaya_debug_gui", "AL_usdmaya_debug_gui", g_usdmaya_debug_gui);
 }
 
 const char* const UsdDebugCommand::g_helpText =  R"(
@@ -223,6 +310,27 @@ const char* const UsdDebugCommand::g_helpText =  R"(
 
 )";
 
+const char* const ProxyShapeMemoryUsage::g_helpText =  R"(
+    AL_usdmaya_ProxyShapeMemoryUsage Overview:
+
+      This command reports the number of elements, and the approximate number of bytes, held by the caches and tables
+      of a proxy shape (the bounding box cache, translator prim mappings, selectability DB, lock sets, required paths,
+      transform reference tables), along with those of the layer manager. The sizes only account for the memory owned
+      by the containers themselves, and the query only walks container sizes, so it is cheap enough to poll.
+
+      With no flags, the total number of bytes is returned:
+
+        AL_usdmaya_ProxyShapeMemoryUsage "AL_usdmaya_ProxyShape1";
+
+      The -n/-names, -c/-counts, and -b/-bytes flags return the per structure names, element counts, and byte sizes
+      (in matching order):
+
+        AL_usdmaya_ProxyShapeMemoryUsage -n "AL_usdmaya_ProxyShape1";
+        AL_usdmaya_ProxyShapeMemoryUsage -c "AL_usdmaya_ProxyShape1";
+        AL_usdmaya_ProxyShapeMemoryUsage -b "AL_usdmaya_ProxyShape1";
+
+)";
+
 //----------------------------------------------------------------------------------------------------------------------
 }
 }
@@ -20,6 +20,7 @@
 #include "maya/MPxCommand.h"
 
 #include "pxr/pxr.h"
+#include "AL/usdmaya/cmds/ProxyShapeCommands.h"
 #include "AL/usdmaya/utils/ForwardDeclares.h"
 #include "AL/maya/utils/Api.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
@@ -45,6 +46,21 @@ private:
   MStatus doIt(const MArgList& args) override;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A command that reports the element counts and approximate memory sizes of the caches held by a proxy shape
+///         (and by the layer manager).
+/// \ingroup commands
+//----------------------------------------------------------------------------------------------------------------------
+class ProxyShapeMemoryUsage
+  : public ProxyShapeCommandBase
+{
+public:
+  AL_MAYA_DECLARE_COMMAND();
+private:
+  bool isUndoable() const override;
+  MStatus doIt(const MArgList& args) override;
+};
+
 /// builds the GUI for the TfDebug notices
 AL_USDMAYA_PUBLIC
 void constructDebugCommandGuis();
@@ -36,6 +36,7 @@
 #include "pxr/usd/usd/stageCacheContext.h"
 #include "pxr/usd/usdUtils/stageCache.h"
 #include "pxr/usd/sdf/listOp.h"
+#include "pxr/base/work/loops.h"
 
 #include <sstream>
 #include "AL/usdmaya/utils/Utils.h"
@@ -613,7 +614,8 @@ MStatus LayerCurrentEditTarget::doIt(const MArgList& argList)
     else
     {
       // Setup the function pointers which will be used to find the wanted layer
-      if(args.isFlagSet("-fid"))
+      const bool findByIdentifier = args.isFlagSet("-fid");
+      if(findByIdentifier)
       {
         // Use the Identifier when looking for the correct layer. Used for anonymous layers
         getLayerId = [](SdfLayerHandle layer) {  return layer->GetIdentifier(); };
@@ -631,9 +633,23 @@ MStatus LayerCurrentEditTarget::doIt(const MArgList& argList)
 
       isQuery = false;
 
-      stage = getShapeNodeStage(args);
+      nodes::ProxyShape* proxy = getShapeNode(args);
+      stage = proxy->getUsdStage();
       if(stage)
       {
+        // the used layers of the stage, hashed by identifier and display name
+        const nodes::proxy::LayerGraph& layerGraph = proxy->layerGraph();
+        auto findUsedLayer = [&layerGraph, findByIdentifier](const std::string& name) -> SdfLayerHandle
+        {
+          if(findByIdentifier)
+          {
+            const nodes::proxy::LayerGraph::NodeIndex index = layerGraph.indexOf(name);
+            return index != nodes::proxy::LayerGraph::kInvalidIndex ? layerGraph.layer(index) : SdfLayerHandle();
+          }
+          SdfLayerHandleVector layers = layerGraph.findLayersByDisplayName(name);
+          return layers.empty() ? SdfLayerHandle() : layers.front();
+        };
+
         // if the layer has been manually specified
         MString layerName;
         SdfLayerHandle foundLayer = nullptr;
@@ -667,24 +683,17 @@ MStatus LayerCurrentEditTarget::doIt(const MArgList& argList)
         if(layerName.length() > 0)
         {
           layerName2 = AL::maya::utils::convert(layerName);
-          SdfLayerHandleVector layers = stage->GetUsedLayers();
-          for(auto it = layers.begin(); it != layers.end(); ++it)
+          SdfLayerHandle handle = findUsedLayer(layerName2);
+          if(handle)
           {
-
-            SdfLayerHandle handle = *it;
-
-            if(layerName2 == getLayerId(handle))
+            PcpNodeRef mappingNode = determineEditTargetMapping(stage, args, handle);
+            if(mappingNode)
             {
-              PcpNodeRef mappingNode = determineEditTargetMapping(stage, args, handle);
-              if(mappingNode)
-              {
-                next = UsdEditTarget(handle, mappingNode);
-              }
-              else
-              {
-                next = UsdEditTarget(handle);
-              }
-              break;
+              next = UsdEditTarget(handle, mappingNode);
+            }
+            else
+            {
+              next = UsdEditTarget(handle);
             }
           }
         }
@@ -698,15 +707,10 @@ MStatus LayerCurrentEditTarget::doIt(const MArgList& argList)
         {
           // if we failed to find the layer in the list of used layers, just check to see whether we are actually able to
           // edit said layer.
-          SdfLayerHandleVector layers = stage->GetUsedLayers();
-          for(auto it = layers.begin(); it != layers.end(); ++it)
+          if(findUsedLayer(layerName2))
           {
-            SdfLayerHandle handle = *it;
-            if(layerName2 == getLayerId(handle))
-            {
-              MGlobal::displayError("LayerCurrentEditTarget: Unable to set the edit target, the specified layer cannot be edited");
-              return MS::kFailure;
-            }
+            MGlobal::displayError("LayerCurrentEditTarget: Unable to set the edit target, the specified layer cannot be edited");
+            return MS::kFailure;
           }
           MGlobal::displayError(MString("LayerCurrentEditTarget: no layer found on proxy node that matches the name \"") + AL::maya::utils::convert(layerName2) + "\"");
           return MS::kFailure;
@@ -998,21 +1002,29 @@ MStatus LayerManager::doIt(const MArgList& argList)
 
     nodes::LayerManager* layerManager = nodes::LayerManager::findManager();
 
-    auto shouldRecord = [&](const MString& currId)
+    // resolve the session layer of the proxy once, rather than for each layer
+    const bool sessionOnly = args.isFlagSet("-dso");
+    const bool editTargetsOnly = !sessionOnly && args.isFlagSet("-dlo");
+    std::string shapesSessionId;
+    if(sessionOnly)
     {
-      if(args.isFlagSet("-dso"))
+      UsdStageRefPtr stage = getShapeNodeStage(args);
+      if(stage)
       {
-        UsdStageRefPtr stage = getShapeNodeStage(args);
-        std::string shapesSessionId = stage->GetSessionLayer()->GetIdentifier();
-        if(std::strcmp(currId.asChar(), shapesSessionId.c_str()) != 0)
-        {
-          // only return the dirty session layer for the selected stage
-          return false;
-        }
+        shapesSessionId = stage->GetSessionLayer()->GetIdentifier();
+      }
+    }
+
+    auto shouldRecord = [&](const std::string& currId)
+    {
+      if(sessionOnly)
+      {
+        // only return the dirty session layer for the selected stage
+        return currId == shapesSessionId;
       }
-      else if(args.isFlagSet("-dlo"))
+      else if(editTargetsOnly)
       {
-        std::string displayName = SdfLayer::GetDisplayNameFromIdentifier(currId.asChar());
+        std::string displayName = SdfLayer::GetDisplayNameFromIdentifier(currId);
         std::size_t found = displayName.find("session");
         if(found != std::string::npos)
         {
@@ -1025,28 +1037,36 @@ MStatus LayerManager::doIt(const MArgList& argList)
     MStringArray results;
     if(layerManager)
     {
-      MStringArray identifiers;
-      layerManager->getLayerIdentifiers(identifiers);
+      // the layer manager only returns the dirty layers
+      SdfLayerHandleVector dirtyLayers;
+      layerManager->getLayers(dirtyLayers);
 
-      for(uint32_t x = 0, n = identifiers.length(); x < n; ++x)
+      SdfLayerHandleVector layers;
+      layers.reserve(dirtyLayers.size());
+      for(const SdfLayerHandle& layer : dirtyLayers)
       {
-        MString currId = identifiers[x];
-
-        if(!shouldRecord(currId))
+        if(layer && shouldRecord(layer->GetIdentifier()))
         {
-          continue;
+          layers.push_back(layer);
         }
+      }
 
-        SdfLayerHandle l = layerManager->findLayer(currId.asChar());
-        if(l)
+      // serialise the layers concurrently, each into its own slot so that the original ordering is retained
+      std::vector<std::string> contents(layers.size());
+      WorkParallelForN(layers.size(), [&layers, &contents](size_t begin, size_t end)
+      {
+        for(size_t i = begin; i < end; ++i)
         {
-          std::string str;
-          l->ExportToString(&str);
-
-          // Write the results in adjacent pairs(id,contents, id,contents)
-          results.append(currId);
-          results.append(AL::maya::utils::convert(str));
+          layers[i]->ExportToString(&contents[i]);
         }
+      });
+
+      // Write the results in adjacent pairs(id,contents, id,contents)
+      results.setSizeIncrement(2 * layers.size());
+      for(size_t i = 0, n = layers.size(); i < n; ++i)
+      {
+        results.append(AL::maya::utils::convert(layers[i]->GetIdentifier()));
+        results.append(AL::maya::utils::convert(contents[i]));
       }
     }
     setResult(results);
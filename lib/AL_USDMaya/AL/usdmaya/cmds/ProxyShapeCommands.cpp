@@ -34,6 +34,7 @@
 
 #include <sstream>
 #include <algorithm>
+#include <cctype>
 #include "AL/usdmaya/utils/Utils.h"
 
 namespace {
@@ -601,6 +602,207 @@ MStatus ProxyShapeFindLoadable::doIt(const MArgList& args)
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+TransformRangeUndoHelper::TransformRangeUndoHelper(
+    const MObject& proxy,
+    const SdfPathVector& roots,
+    nodes::ProxyShape::TransformReason reason,
+    bool pushToPrim,
+    bool create)
+  : m_proxy(proxy), m_roots(roots), m_reason(reason), m_pushToPrim(pushToPrim), m_create(create)
+{
+  m_roots.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+nodes::ProxyShape* TransformRangeUndoHelper::proxy() const
+{
+  if(!m_proxy.isValid())
+  {
+    return 0;
+  }
+  MFnDependencyNode fn(m_proxy.object());
+  return dynamic_cast<nodes::ProxyShape*>(fn.userNode());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus TransformRangeUndoHelper::makeTransforms(nodes::ProxyShape* shapeNode)
+{
+  UsdStageRefPtr stage = shapeNode->usdStage();
+  if(!stage)
+  {
+    return MS::kFailure;
+  }
+
+  // the modifiers only live for the duration of the walk, so no per node operations are retained for undo
+  MDagModifier modifier;
+  MDagModifier modifier2;
+  for(const SdfPath& path : m_roots)
+  {
+    UsdPrim prim = stage->GetPrimAtPath(path);
+    if(prim)
+    {
+      shapeNode->makeUsdTransforms(prim, modifier, m_reason, m_pushToPrim ? &modifier2 : 0);
+    }
+  }
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("TransformRangeUndoHelper::makeTransforms %lu roots\n", m_roots.size());
+  MStatus status = modifier.doIt();
+  if(status)
+  {
+    status = modifier2.doIt();
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus TransformRangeUndoHelper::removeTransforms(nodes::ProxyShape* shapeNode)
+{
+  UsdStageRefPtr stage = shapeNode->usdStage();
+  if(!stage)
+  {
+    return MS::kFailure;
+  }
+
+  m_modifier.reset(new MDagModifier);
+  for(const SdfPath& path : m_roots)
+  {
+    UsdPrim prim = stage->GetPrimAtPath(path);
+    if(prim)
+    {
+      shapeNode->removeUsdTransforms(prim, *m_modifier, m_reason);
+    }
+  }
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("TransformRangeUndoHelper::removeTransforms %lu roots\n", m_roots.size());
+  return m_modifier->doIt();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformRangeUndoHelper::recordChanges(
+    const nodes::ProxyShape::TransformRefStates& before,
+    const nodes::ProxyShape::TransformRefStates& after)
+{
+  // both are sorted by path, so the changes can be found with a single merge
+  auto b = before.begin(), bend = before.end();
+  auto a = after.begin(), aend = after.end();
+  while(b != bend || a != aend)
+  {
+    if(a == aend || (b != bend && b->m_path < a->m_path))
+    {
+      m_before.push_back(*b);
+      m_removed.push_back(b->m_path);
+      ++b;
+    }
+    else
+    if(b == bend || a->m_path < b->m_path)
+    {
+      m_after.push_back(*a);
+      m_added.push_back(a->m_path);
+      ++a;
+    }
+    else
+    {
+      if(*a != *b)
+      {
+        m_before.push_back(*b);
+        m_after.push_back(*a);
+      }
+      ++a;
+      ++b;
+    }
+  }
+  m_before.shrink_to_fit();
+  m_after.shrink_to_fit();
+  m_added.shrink_to_fit();
+  m_removed.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus TransformRangeUndoHelper::doIt()
+{
+  nodes::ProxyShape* shapeNode = proxy();
+  if(!shapeNode)
+  {
+    return MS::kFailure;
+  }
+
+  MStatus status;
+  if(!m_recorded)
+  {
+    nodes::ProxyShape::TransformRefStates before, after;
+    shapeNode->captureTransformRefs(m_roots, before);
+    status = m_create ? makeTransforms(shapeNode) : removeTransforms(shapeNode);
+    shapeNode->captureTransformRefs(m_roots, after);
+    recordChanges(before, after);
+    m_recorded = true;
+    TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("TransformRangeUndoHelper::doIt %lu added, %lu removed, %lu changed\n",
+                                     m_added.size(), m_removed.size(), m_before.size() - m_removed.size());
+    return status;
+  }
+
+  // redo
+  if(m_modifier)
+  {
+    if(m_create)
+    {
+      // bring back the transforms deleted by undoIt
+      status = m_modifier->undoIt();
+      m_modifier.reset();
+    }
+    else
+    {
+      status = m_modifier->doIt();
+    }
+  }
+  shapeNode->eraseTransformRefs(m_removed);
+  shapeNode->restoreTransformRefs(m_after);
+  shapeNode->constructLockPrims();
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus TransformRangeUndoHelper::undoIt()
+{
+  nodes::ProxyShape* shapeNode = proxy();
+  if(!shapeNode || !m_recorded)
+  {
+    return MS::kFailure;
+  }
+
+  MStatus status;
+  if(m_create)
+  {
+    // delete the transforms that were created by the command (and only those), children before their parents
+    m_modifier.reset(new MDagModifier);
+    for(auto it = m_after.rbegin(), end = m_after.rend(); it != end; ++it)
+    {
+      if(std::binary_search(m_added.begin(), m_added.end(), it->m_path) && it->m_node.isValid())
+      {
+        MObject node = it->m_node.object();
+        m_modifier->reparentNode(node);
+        m_modifier->deleteNode(node);
+      }
+    }
+    status = m_modifier->doIt();
+  }
+  else
+  if(m_modifier)
+  {
+    status = m_modifier->undoIt();
+  }
+  shapeNode->eraseTransformRefs(m_added);
+  shapeNode->restoreTransformRefs(m_before);
+  shapeNode->constructLockPrims();
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t TransformRangeUndoHelper::memoryUsage() const
+{
+  return sizeof(*this) +
+         sizeof(SdfPath) * (m_roots.capacity() + m_added.capacity() + m_removed.capacity()) +
+         sizeof(nodes::ProxyShape::TransformRefState) * (m_before.capacity() + m_after.capacity());
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------------------------
 AL_MAYA_DEFINE_COMMAND(ProxyShapeImportAllTransforms, AL_usdmaya);
@@ -624,21 +826,13 @@ bool ProxyShapeImportAllTransforms::isUndoable() const
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShapeImportAllTransforms::undoIt()
 {
-  if(m_modifier2.doIt())
-  {
-    return m_modifier.doIt();
-  }
-  return MS::kFailure;
+  return m_helper ? m_helper->undoIt() : MS::kFailure;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShapeImportAllTransforms::redoIt()
 {
-  if(m_modifier.doIt())
-  {
-    return m_modifier2.doIt();
-  }
-  return MS::kFailure;
+  return m_helper ? m_helper->doIt() : MS::kFailure;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -667,11 +861,6 @@ MStatus ProxyShapeImportAllTransforms::doIt(const MArgList& args)
       reason = nodes::ProxyShape::kSelection;
     }
 
-    MDagPath shapePath = getShapePath(db);
-    MObject shapeObject = shapePath.node();
-    MDagPath transformPath = shapePath;
-    transformPath.pop();
-
     nodes::ProxyShape* shapeNode = getShapeNode(db);
     if(!shapeNode)
     {
@@ -684,12 +873,7 @@ MStatus ProxyShapeImportAllTransforms::doIt(const MArgList& args)
       throw MS::kFailure;
     }
 
-    MDGModifier* modifier = 0;
-    if(pushToPrim)
-    {
-      modifier = &m_modifier2;
-    }
-
+    SdfPathVector roots;
     if(primPath.length())
     {
       SdfPath usdPath(AL::maya::utils::convert(primPath));
@@ -699,21 +883,17 @@ MStatus ProxyShapeImportAllTransforms::doIt(const MArgList& args)
         MGlobal::displayError(MString("The prim path specified could not be found in the USD stage: ") + primPath);
         throw MS::kFailure;
       }
-      else
-      {
-        shapeNode->makeUsdTransforms(prim, m_modifier, reason, modifier);
-      }
+      roots.push_back(usdPath);
     }
     else
     {
-      UsdPrim root = stage->GetPseudoRoot();
-      for(auto it = root.GetChildren().begin(), end = root.GetChildren().end(); it != end; ++it)
+      for(const UsdPrim& prim : stage->GetPseudoRoot().GetChildren())
       {
-        SdfPath usdPath = it->GetPath();
-        UsdPrim prim = stage->GetPrimAtPath(usdPath);
-        shapeNode->makeUsdTransforms(prim, m_modifier, reason, modifier);
+        roots.push_back(prim.GetPath());
       }
     }
+
+    m_helper.reset(new TransformRangeUndoHelper(shapeNode->thisMObject(), roots, reason, pushToPrim, true));
   }
   catch(const MStatus&)
   {
@@ -748,13 +928,13 @@ bool ProxyShapeRemoveAllTransforms::isUndoable() const
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShapeRemoveAllTransforms::undoIt()
 {
-  return m_modifier.undoIt();
+  return m_helper ? m_helper->undoIt() : MS::kFailure;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShapeRemoveAllTransforms::redoIt()
 {
-  return m_modifier.doIt();
+  return m_helper ? m_helper->doIt() : MS::kFailure;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -765,10 +945,10 @@ MStatus ProxyShapeRemoveAllTransforms::doIt(const MArgList& args)
     MArgDatabase db = makeDatabase(args);
     AL_MAYA_COMMAND_HELP(db, g_helpText);
     nodes::ProxyShape* shapeNode = getShapeNode(db);
-    MDagPath shapePath = getShapePath(db);
-    MObject shapeObject = shapePath.node();
-    MDagPath transformPath = shapePath;
-    transformPath.pop();
+    if(!shapeNode)
+    {
+      throw MS::kFailure;
+    }
 
     // This command should pretty much always just
     nodes::ProxyShape::TransformReason reason = nodes::ProxyShape::kRequested;
@@ -789,6 +969,7 @@ MStatus ProxyShapeRemoveAllTransforms::doIt(const MArgList& args)
       throw MS::kFailure;
     }
 
+    SdfPathVector roots;
     if(primPath.length())
     {
       SdfPath usdPath(AL::maya::utils::convert(primPath));
@@ -798,19 +979,17 @@ MStatus ProxyShapeRemoveAllTransforms::doIt(const MArgList& args)
         MGlobal::displayError(MString("The prim path specified could not be found in the USD stage: ") + primPath);
         throw MS::kFailure;
       }
-      else
-      {
-        shapeNode->removeUsdTransforms(prim, m_modifier, reason);
-      }
+      roots.push_back(usdPath);
     }
     else
     {
-      UsdPrim root = stage->GetPseudoRoot();
-      for(auto it = root.GetChildren().begin(), end = root.GetChildren().end(); it != end; ++it)
+      for(const UsdPrim& prim : stage->GetPseudoRoot().GetChildren())
       {
-        shapeNode->removeUsdTransforms(*it, m_modifier, reason);
+        roots.push_back(prim.GetPath());
       }
     }
+
+    m_helper.reset(new TransformRangeUndoHelper(shapeNode->thisMObject(), roots, reason, false, false));
   }
   catch(const MStatus&)
   {
@@ -1010,6 +1189,7 @@ MSyntax ProxyShapeSelect::createSyntax()
   syntax.addFlag("-r", "-replace", MSyntax::kNoArg);
   syntax.addFlag("-d", "-deselect", MSyntax::kNoArg);
   syntax.addFlag("-i", "-internal", MSyntax::kNoArg);
+  syntax.addFlag("-ppl", "-primPathList", MSyntax::kString);
   syntax.makeFlagMultiUse("-pp");
   return syntax;
 }
@@ -1043,20 +1223,45 @@ MStatus ProxyShapeSelect::doIt(const MArgList& args)
     }
     else
     {
+      auto addPath = [&](const SdfPath& path)
+      {
+        if(!proxy->selectabilityDB().isPathUnselectable(path) && path.IsAbsolutePath())
+        {
+          auto insertResult = unorderedPaths.insert(path);
+          if (insertResult.second) {
+            orderedPaths.push_back(path);
+          }
+        }
+      };
+
       for(uint32_t i = 0, n = db.numberOfFlagUses("-pp"); i < n; ++i)
       {
         MArgList args;
         db.getFlagArgumentList("-pp", i, args);
         MString pathString = args.asString(0);
+        addPath(SdfPath(AL::maya::utils::convert(pathString)));
+      }
 
-        SdfPath path(AL::maya::utils::convert(pathString));
-
-        if(!proxy->selectabilityDB().isPathUnselectable(path) && path.IsAbsolutePath())
+      // a newline separated list of paths, which avoids the cost of parsing one -pp flag per path for large selections
+      if(db.isFlagSet("-ppl"))
+      {
+        MString pathList;
+        db.getFlagArgument("-ppl", 0, pathList);
+        const char* start = pathList.asChar();
+        const char* const end = start + pathList.length();
+        while(start < end)
         {
-          auto insertResult = unorderedPaths.insert(path);
-          if (insertResult.second) {
-            orderedPaths.push_back(path);
+          const char* lineEnd = std::find(start, end, '\n');
+          const char* pathEnd = lineEnd;
+          while(pathEnd > start && std::isspace(static_cast<unsigned char>(pathEnd[-1])))
+          {
+            --pathEnd;
           }
+          if(pathEnd > start)
+          {
+            addPath(SdfPath(std::string(start, pathEnd)));
+          }
+          start = lineEnd + 1;
         }
       }
 
@@ -1648,6 +1853,12 @@ AL_usdmaya_ProxyShapeSelect Overview:
       AL_usdmaya_ProxyShapeSelect -r -pp "/root/hips/thigh_left" -pp "/root/hips/thigh_right" "AL_usdmaya_ProxyShape1";
 
   The -pp flag specifies a prim path to select, and it can be re-used as many times as needed.
+  For large selections, the -ppl/-primPathList flag accepts a single newline separated list of paths, which
+  avoids the overhead of one flag per path, e.g. from python:
+
+      cmds.AL_usdmaya_ProxyShapeSelect("AL_usdmaya_ProxyShape1", r=True, ppl="\n".join(paths))
+
+  Both flags may be combined, in which case the -pp paths come first.
   When selecting prims on a proxy shape, you can specify a series of modifiers that change the behaviour
   of the AL_usdmaya_ProxyShapeSelect command. These modifiers roughly map to the flags in the standard
   maya 'select' command:
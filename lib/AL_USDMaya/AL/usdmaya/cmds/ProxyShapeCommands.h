@@ -21,11 +21,13 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 
 #include <map>
+#include <memory>
 
 #include "maya/MPxCommand.h"
 #include "maya/MDagModifier.h"
 #include "maya/MObject.h"
 #include "maya/MObjectArray.h"
+#include "maya/MObjectHandle.h"
 #include "maya/MSelectionList.h"
 
 #include "pxr/pxr.h"
@@ -108,6 +110,86 @@ private:
   MStatus doIt(const MArgList& args) override;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A compact undo record for the bulk import / removal of AL_usdmaya_Transform nodes beneath a set of prims.
+///         The first call to doIt records the transform references that the command changes (a path, a node handle
+///         and the reference counts for each). Undo and redo then restore exactly those references, rather than
+///         re-walking the stage.
+///         Some per node state can't be avoided: the roots alone don't say which transforms existed before the
+///         command, or which reference counts it changed, and re-walking the stage on undo would delete (or
+///         recreate) transforms that the command never touched. The record is kept to one entry per changed
+///         reference, rather than the several modifier operations needed to create or delete each node.
+///         When importing, no modifier is kept once the transforms have been created. Undo deletes the created
+///         transforms with a modifier, which redo reverts so that the same nodes come back.
+///         When removing, the modifier that deleted the transforms is kept, since reverting it is the only way to
+///         restore the user's nodes (with their edits and connections).
+/// \ingroup commands
+//----------------------------------------------------------------------------------------------------------------------
+class TransformRangeUndoHelper
+{
+public:
+
+  /// \brief  ctor
+  /// \param  proxy the proxy shape node whose transforms are being created or removed
+  /// \param  roots the prims beneath which (inclusive) the transforms will be created or removed
+  /// \param  reason the reason the transforms are requested
+  /// \param  pushToPrim if true, the pushToPrim attribute will be enabled on created transforms
+  /// \param  create if true doIt() creates the transforms and undoIt() removes them, if false, the reverse.
+  AL_USDMAYA_PUBLIC
+  TransformRangeUndoHelper(
+      const MObject& proxy,
+      const SdfPathVector& roots,
+      nodes::ProxyShape::TransformReason reason,
+      bool pushToPrim,
+      bool create);
+
+  /// \brief  performs the creation (or removal) of the transforms
+  /// \return MS::kSuccess on success
+  AL_USDMAYA_PUBLIC
+  MStatus doIt();
+
+  /// \brief  reverts the creation (or removal) of the transforms
+  /// \return MS::kSuccess on success
+  AL_USDMAYA_PUBLIC
+  MStatus undoIt();
+
+  /// \brief  returns the number of transform references that were added by the command
+  size_t numAdded() const
+    { return m_added.size(); }
+
+  /// \brief  returns the number of transform references that were removed by the command
+  size_t numRemoved() const
+    { return m_removed.size(); }
+
+  /// \brief  returns true if a modifier (holding per node operations) is currently kept by this undo record
+  bool holdsModifier() const
+    { return bool(m_modifier); }
+
+  /// \brief  returns the approximate number of bytes held by this undo record (excluding any modifier)
+  /// \return the size in bytes
+  AL_USDMAYA_PUBLIC
+  size_t memoryUsage() const;
+
+private:
+  nodes::ProxyShape* proxy() const;
+  MStatus makeTransforms(nodes::ProxyShape* shapeNode);
+  MStatus removeTransforms(nodes::ProxyShape* shapeNode);
+  void recordChanges(const nodes::ProxyShape::TransformRefStates& before,
+                     const nodes::ProxyShape::TransformRefStates& after);
+
+  MObjectHandle m_proxy;
+  SdfPathVector m_roots;
+  nodes::ProxyShape::TransformRefStates m_before; ///< the references changed by the command, before it ran
+  nodes::ProxyShape::TransformRefStates m_after; ///< the references changed by the command, after it ran
+  SdfPathVector m_added; ///< the paths of the references added by the command (sorted)
+  SdfPathVector m_removed; ///< the paths of the references removed by the command (sorted)
+  std::unique_ptr<MDagModifier> m_modifier;
+  nodes::ProxyShape::TransformReason m_reason;
+  bool m_pushToPrim;
+  bool m_create;
+  bool m_recorded = false;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  ProxyShapeImportAllTransforms
 ///         From a proxy shape, this will import all usdPrims in the stage as AL_usdmaya_Transform nodes.
@@ -116,8 +198,7 @@ private:
 class ProxyShapeImportAllTransforms
   : public ProxyShapeCommandBase
 {
-  MDagModifier m_modifier;
-  MDagModifier m_modifier2;
+  std::unique_ptr<TransformRangeUndoHelper> m_helper;
 public:
   AL_MAYA_DECLARE_COMMAND();
 private:
@@ -135,7 +216,7 @@ private:
 class ProxyShapeRemoveAllTransforms
   : public ProxyShapeCommandBase
 {
-  MDagModifier m_modifier;
+  std::unique_ptr<TransformRangeUndoHelper> m_helper;
 public:
   AL_MAYA_DECLARE_COMMAND();
 private:
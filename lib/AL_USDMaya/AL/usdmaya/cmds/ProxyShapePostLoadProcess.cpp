@@ -44,11 +44,13 @@
 #include "maya/MObjectHandle.h"
 
 #include <pxr/base/tf/type.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/base/vt/dictionary.h>
 #include <pxr/usd/kind/registry.h>
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/variantSets.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include "AL/usdmaya/utils/Utils.h"
@@ -56,101 +58,44 @@
 namespace AL {
 namespace usdmaya {
 namespace cmds {
-namespace {
-
-struct CompareLayerHandle
-{
-  bool operator () (const SdfLayerHandle& a, const SdfLayerHandle& b) const
-  {
-    return a->GetDisplayName() < b->GetDisplayName();
-  }
-};
-
-typedef std::set<SdfLayerHandle, CompareLayerHandle> LayerSet;
-typedef std::map<SdfLayerHandle, LayerSet, CompareLayerHandle > LayerMap;
-typedef std::map<SdfLayerHandle, MObject, CompareLayerHandle > LayerToObjectMap;
-
-//----------------------------------------------------------------------------------------------------------------------
-SdfLayerHandle findLayer(const SdfLayerHandleVector& layers, const std::string& name)
-{
-  for(auto it = layers.begin(); it != layers.end(); ++it)
-  {
-    if(name == (*it)->GetDisplayName() ||
-       name == (*it)->GetIdentifier())
-    {
-      return *it;
-    }
-  }
-  return SdfLayerHandle();
-}
 
 //----------------------------------------------------------------------------------------------------------------------
-void buildTree(const SdfLayerHandle& layer, LayerMap& layerMap, const SdfLayerHandleVector& layers)
+static bool parentNodeIsUnmerged(const UsdPrim & prim)
 {
-  auto iter = layerMap.find(layer);
-  if(iter == layerMap.end())
+  bool parentUnmerged = false;
+  TfToken val;
+  if(prim.GetParent().IsValid() && prim.GetParent().GetMetadata(AL::usdmaya::Metadata::mergedTransform, &val))
   {
-    LayerSet kids;
-    std::set<std::string> refs = layer->GetExternalReferences();
-
-
-    for(auto it = refs.begin(); it != refs.end(); ++it)
-    {
-      SdfLayerHandle childHandle = findLayer(layers, *it);
-
-      if(childHandle)
-      {
-        kids.insert(childHandle);
-        buildTree(childHandle, layerMap, layers);
-      }
-    }
-    layerMap.insert(std::make_pair(layer, kids));
+    parentUnmerged = (val == AL::usdmaya::Metadata::unmerged);
   }
+  return parentUnmerged;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-struct ImportCallback
-{
-  enum ScriptType : uint32_t
-  {
-    kMel,
-    kPython
-  };
-
-  void setCallbackType(TfToken scriptType)
-  {
-    if(scriptType == "mel")
-    {
-      type = kMel;
-    }
-    else
-    if(scriptType == "py")
-    {
-      type = kPython;
-    }
-  }
-  std::string name;
-  VtDictionary params;
-  ScriptType type;
-};
+fileio::ImporterParams ProxyShapePostLoadProcess::m_params;
 
 //----------------------------------------------------------------------------------------------------------------------
-void huntForNativeNodes(
+void ProxyShapePostLoadProcess::huntForNativeNodes(
+    nodes::ProxyShape* proxy,
     const MDagPath& proxyTransformPath,
     std::vector<UsdPrim>& schemaPrims,
-    std::vector<ImportCallback>& postCallBacks,
-    nodes::ProxyShape& proxy)
+    std::vector<ImportCallback>& postCallBacks)
 {
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("ProxyShapePostLoadProcess::huntForNativeNodes\n");
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  if(!stage)
+  {
+    return;
+  }
 
-  UsdStageRefPtr stage = proxy.getUsdStage();
-  fileio::translators::TranslatorManufacture& manufacture = proxy.translatorManufacture();
+  // the translator lookups are cached per prim type within the utils, so only the first prim of each type pays for
+  // the schema type lookup.
+  fileio::SchemaPrimsUtils utils(proxy->translatorManufacture());
+  static const TfToken callbacksToken("callbacks");
 
-  fileio::SchemaPrimsUtils utils(manufacture);
-  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("huntForNativeNodes::huntForNativeNodes\n");
-  fileio::TransformIterator it(stage, proxyTransformPath);
-  for(; !it.done(); it.next())
+  for(fileio::TransformIterator it(stage, proxyTransformPath); !it.done(); it.next())
   {
-    UsdPrim prim = it.prim();
+    const UsdPrim& prim = it.prim();
     TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("huntForNativeNodes: PrimName %s\n", prim.GetName().GetText());
 
     // If the prim isn't importable by default then don't add it to the list
@@ -161,12 +106,13 @@ void huntForNativeNodes(
       schemaPrims.push_back(prim);
     }
 
-    VtDictionary customData = prim.GetCustomData();
-    VtDictionary::const_iterator postCallBacksEntry = customData.find("callbacks");
-    if(postCallBacksEntry != customData.end())
+    // Only probe the callbacks key, rather than composing (and copying) the entire customData dictionary. The
+    // vast majority of prims will not have this key, in which case an empty value is returned.
+    VtValue postCallBacksEntry = prim.GetCustomDataByKey(callbacksToken);
+    if(postCallBacksEntry.IsHolding<VtDictionary>())
     {
       //Get the list of post callbacks
-      VtDictionary melCallbacks = postCallBacksEntry->second.Get<VtDictionary>();
+      const VtDictionary& melCallbacks = postCallBacksEntry.UncheckedGet<VtDictionary>();
 
       for(VtDictionary::const_iterator melCommand = melCallbacks.begin(), end = melCallbacks.end();
           melCommand != end;
@@ -184,23 +130,6 @@ void huntForNativeNodes(
   }
 }
 
-} // anon
-
-//----------------------------------------------------------------------------------------------------------------------
-static bool parentNodeIsUnmerged(const UsdPrim & prim)
-{
-  bool parentUnmerged = false;
-  TfToken val;
-  if(prim.GetParent().IsValid() && prim.GetParent().GetMetadata(AL::usdmaya::Metadata::mergedTransform, &val))
-  {
-    parentUnmerged = (val == AL::usdmaya::Metadata::unmerged);
-  }
-  return parentUnmerged;
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-fileio::ImporterParams ProxyShapePostLoadProcess::m_params;
-
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShapePostLoadProcess::createTranformChainsForSchemaPrims(
     nodes::ProxyShape* ptrNode,
@@ -260,6 +189,54 @@ void ProxyShapePostLoadProcess::createTranformChainsForSchemaPrims(
   AL_END_PROFILE_SECTION();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+typedef fileio::translators::TranslatorAbstract::PrimDataPtr PrimDataPtr;
+
+//----------------------------------------------------------------------------------------------------------------------
+// the number of prims whose data is read before their Maya nodes are created. This bounds the amount of prim data
+// held at once, while still giving the worker threads enough prims to share out.
+static const size_t g_primDataChunkSize = 256;
+
+//----------------------------------------------------------------------------------------------------------------------
+// reads the prim data of each prim in [first, last) that has a translator which supports parallel reads, into
+// primData[i - first]. Only the USD data is read here (from many threads), the Maya nodes are created or updated
+// afterwards in serial.
+static void readSchemaPrimData(
+    const std::vector<UsdPrim>& prims,
+    const fileio::translators::TranslatorRefPtrVector& translators,
+    const std::vector<bool>& shouldRead,
+    const size_t first,
+    const size_t last,
+    std::vector<PrimDataPtr>& primData)
+{
+  primData.clear();
+  primData.resize(last - first);
+
+  std::vector<size_t> toRead;
+  for(size_t i = first; i < last; ++i)
+  {
+    if(shouldRead[i] && translators[i] && translators[i]->supportsParallelRead())
+    {
+      toRead.push_back(i);
+    }
+  }
+  if(toRead.empty())
+  {
+    return;
+  }
+
+  AL_BEGIN_PROFILE_SECTION(ReadPrimData);
+  WorkParallelForN(toRead.size(), [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      const size_t index = toRead[i];
+      primData[index - first] = translators[index]->readPrimData(prims[index]);
+    }
+  });
+  AL_END_PROFILE_SECTION();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShapePostLoadProcess::createSchemaPrims(
     nodes::ProxyShape* proxy,
@@ -278,40 +255,59 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
                                           " will read default values\n");
     }
 
-    auto it = objsToCreate.begin();
-    const auto end = objsToCreate.end();
-    for(; it != end; ++it)
+    // resolve the translators, and determine which of the prims will actually be imported
+    const size_t numPrims = objsToCreate.size();
+    fileio::translators::TranslatorRefPtrVector translators(numPrims);
+    std::vector<bool> importable(numPrims);
+    for(size_t i = 0; i < numPrims; ++i)
     {
-      UsdPrim prim = *it;
-      bool parentUnmerged = parentNodeIsUnmerged(prim);
-      MObject object;
-      if (parentUnmerged)
-      {
-        object = proxy->findRequiredPath(prim.GetParent().GetPath());
-      }
-      else
-      {
-        object = proxy->findRequiredPath(prim.GetPath());
-      }
-
-      fileio::translators::TranslatorRefPtr translator = translatorManufacture.get(prim.GetTypeName());
+      translators[i] = translatorManufacture.get(objsToCreate[i].GetTypeName());
+      importable[i] = translators[i] && (param.forceTranslatorImport() || translators[i]->importableByDefault());
+    }
 
-      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s\n", prim.GetPath().GetText());
+    // read and create the prims in chunks, so that the data of only one chunk is held at a time
+    std::vector<PrimDataPtr> primData;
+    for(size_t first = 0; first < numPrims; first += g_primDataChunkSize)
+    {
+      const size_t last = std::min(numPrims, first + g_primDataChunkSize);
+      readSchemaPrimData(objsToCreate, translators, importable, first, last, primData);
 
-      //if(!context->hasEntry(prim.GetPath(), prim.GetTypeName()))
+      for(size_t i = first; i < last; ++i)
       {
-        AL_BEGIN_PROFILE_SECTION(SchemaPrims);
-        MObject created;
-        if(!fileio::importSchemaPrim(prim, object, created, context, translator, param))
+        const UsdPrim& prim = objsToCreate[i];
+        bool parentUnmerged = parentNodeIsUnmerged(prim);
+        MObject object;
+        if (parentUnmerged)
         {
-          std::cerr << "Error: unable to load schema prim node: '" << prim.GetName().GetString() << "' that has type: '" << prim.GetTypeName() << "'" << std::endl;
+          object = proxy->findRequiredPath(prim.GetParent().GetPath());
+        }
+        else
+        {
+          object = proxy->findRequiredPath(prim.GetPath());
         }
-        AL_END_PROFILE_SECTION();
 
-        auto dataPlugins = translatorManufacture.getExtraDataPlugins(created);
-        for(auto dataPlugin : dataPlugins)
+        const fileio::translators::TranslatorRefPtr& translator = translators[i];
+
+        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s\n", prim.GetPath().GetText());
+
+        //if(!context->hasEntry(prim.GetPath(), prim.GetTypeName()))
         {
-          dataPlugin->import(prim, created);
+          AL_BEGIN_PROFILE_SECTION(SchemaPrims);
+          MObject created;
+          if(!fileio::importSchemaPrim(prim, object, created, context, translator, param, primData[i - first].get()))
+          {
+            std::cerr << "Error: unable to load schema prim node: '" << prim.GetName().GetString() << "' that has type: '" << prim.GetTypeName() << "'" << std::endl;
+          }
+          AL_END_PROFILE_SECTION();
+
+          // release the prim data as soon as the prim has been created
+          primData[i - first].reset();
+
+          auto dataPlugins = translatorManufacture.getExtraDataPlugins(created);
+          for(auto dataPlugin : dataPlugins)
+          {
+            dataPlugin->import(prim, created);
+          }
         }
       }
     }
@@ -330,49 +326,69 @@ void ProxyShapePostLoadProcess::updateSchemaPrims(
     fileio::translators::TranslatorContextPtr context = proxy->context();
     fileio::translators::TranslatorManufacture& translatorManufacture = proxy->translatorManufacture();
 
-    auto it = objsToCreate.begin();
-    const auto end = objsToCreate.end();
-    for(; it != end; ++it)
+    // resolve the translators, and determine which prims will be imported, and which will be updated
+    const size_t numPrims = objsToCreate.size();
+    fileio::translators::TranslatorRefPtrVector translators(numPrims);
+    std::vector<bool> hasEntry(numPrims);
+    std::vector<bool> shouldRead(numPrims);
+    for(size_t i = 0; i < numPrims; ++i)
     {
-      UsdPrim prim = *it;
-
-      MObject object = proxy->findRequiredPath(prim.GetPath());
+      const UsdPrim& prim = objsToCreate[i];
+      translators[i] = translatorManufacture.get(prim.GetTypeName());
+      hasEntry[i] = context->hasEntry(prim.GetPath(), prim.GetTypeName());
+      shouldRead[i] = translators[i] && (hasEntry[i] ? translators[i]->supportsUpdate() : translators[i]->importableByDefault());
+    }
 
-      fileio::translators::TranslatorRefPtr translator = translatorManufacture.get(prim.GetTypeName());
-      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::updateSchemaPrims: hasEntry(%s, %s)=%d\n", prim.GetPath().GetText(), prim.GetTypeName().GetText(), context->hasEntry(prim.GetPath(), prim.GetTypeName()));
+    // read and update the prims in chunks, so that the data of only one chunk is held at a time
+    std::vector<PrimDataPtr> primData;
+    for(size_t first = 0; first < numPrims; first += g_primDataChunkSize)
+    {
+      const size_t last = std::min(numPrims, first + g_primDataChunkSize);
+      readSchemaPrimData(objsToCreate, translators, shouldRead, first, last, primData);
 
-      if(!context->hasEntry(prim.GetPath(), prim.GetTypeName()))
+      for(size_t i = first; i < last; ++i)
       {
-        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s hasEntry=false\n", prim.GetPath().GetText());
-        AL_BEGIN_PROFILE_SECTION(SchemaPrims);
-        MObject created;
-        fileio::importSchemaPrim(prim, object, created, context, translator);
-        AL_END_PROFILE_SECTION();
-      }
-      else
-      {
-        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims [update] prim=%s\n", prim.GetPath().GetText());
-        if(translator)
+        const UsdPrim& prim = objsToCreate[i];
+
+        MObject object = proxy->findRequiredPath(prim.GetPath());
+
+        const fileio::translators::TranslatorRefPtr& translator = translators[i];
+        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::updateSchemaPrims: hasEntry(%s, %s)=%d\n", prim.GetPath().GetText(), prim.GetTypeName().GetText(), bool(hasEntry[i]));
+
+        if(!hasEntry[i])
         {
-          if(translator->update(prim).statusCode() == MStatus::kNotImplemented)
-          {
-            MGlobal::displayError(
-              MString("Prim type has claimed that it supports variant switching via update, but it does not! ") +
-              prim.GetPath().GetText());
-          }
-          else
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s hasEntry=false\n", prim.GetPath().GetText());
+          AL_BEGIN_PROFILE_SECTION(SchemaPrims);
+          MObject created;
+          fileio::importSchemaPrim(prim, object, created, context, translator, fileio::translators::TranslatorParameters(), primData[i - first].get());
+          AL_END_PROFILE_SECTION();
+        }
+        else
+        {
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims [update] prim=%s\n", prim.GetPath().GetText());
+          if(translator)
           {
-            std::vector<MObjectHandle> returned;
-            if(context->getMObjects(prim, returned) && !returned.empty())
+            if(translator->updatePrimData(prim, primData[i - first].get()).statusCode() == MStatus::kNotImplemented)
+            {
+              MGlobal::displayError(
+                MString("Prim type has claimed that it supports variant switching via update, but it does not! ") +
+                prim.GetPath().GetText());
+            }
+            else
             {
-              auto dataPlugins = translatorManufacture.getExtraDataPlugins(returned[0].object());
-              for(auto dataPlugin : dataPlugins)
+              std::vector<MObjectHandle> returned;
+              if(context->getMObjects(prim, returned) && !returned.empty())
               {
-                dataPlugin->update(prim);
+                auto dataPlugins = translatorManufacture.getExtraDataPlugins(returned[0].object());
+                for(auto dataPlugin : dataPlugins)
+                {
+                  dataPlugin->update(prim);
+                }
               }
             }
           }
         }
+        primData[i - first].reset();
       }
     }
   }
@@ -470,7 +486,7 @@ MStatus ProxyShapePostLoadProcess::initialise(nodes::ProxyShape* ptrNode)
   UsdStageRefPtr stage = ptrNode->usdStage();
   if(stage)
   {
-    huntForNativeNodes(proxyTransformPath, schemaPrims, callBacks, *ptrNode/* stage, ptrNode->translatorManufacture()*/);
+    huntForNativeNodes(ptrNode, proxyTransformPath, schemaPrims, callBacks);
   }
   else
   {
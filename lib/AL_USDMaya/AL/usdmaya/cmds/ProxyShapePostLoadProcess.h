@@ -21,6 +21,7 @@
 
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/common.h"
+#include "pxr/base/vt/dictionary.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -52,12 +53,50 @@ public:
   /// a mapping from an MObject to a UsdPrim
   typedef std::vector<std::pair<MObject, UsdPrim> > MObjectToPrim;
 
+  /// \brief  describes a post-import script callback found in the "callbacks" customData of a prim
+  struct ImportCallback
+  {
+    enum ScriptType : uint32_t
+    {
+      kMel,
+      kPython
+    };
+
+    void setCallbackType(TfToken scriptType)
+    {
+      if(scriptType == "mel")
+      {
+        type = kMel;
+      }
+      else
+      if(scriptType == "py")
+      {
+        type = kPython;
+      }
+    }
+    std::string name;
+    VtDictionary params;
+    ScriptType type;
+  };
+
   /// \brief  called after a proxy shape has been created. Traverses the prim hierarchy and looks to see whether
   ///         any custom plugin translators need to be called, and performs additional book-keeping.
   /// \param  shape the proxy shape node that has just been created
   /// \return MS::kSuccess if ok
   static MStatus initialise(nodes::ProxyShape* shape);
 
+  /// \brief  traverses the stage of the proxy shape in a single pass, gathering both the prims that have an importable
+  ///         translator plugin, and any post-import callbacks authored in the "callbacks" customData of the prims.
+  /// \param  shape the proxy shape whose stage should be traversed
+  /// \param  proxyTransformPath a path to the transform node that resides above the proxy shape
+  /// \param  schemaPrims the returned prims that have importable translator plugins
+  /// \param  postCallBacks the returned callbacks found on the prims
+  static void huntForNativeNodes(
+      nodes::ProxyShape* shape,
+      const MDagPath& proxyTransformPath,
+      std::vector<UsdPrim>& schemaPrims,
+      std::vector<ImportCallback>& postCallBacks);
+
   /// \brief  given a specific proxy shape, and a collection of UsdPrims that represent custom DagNode types, this
   ///         will generate a transform hierarchy that will allow you to map the UsdPrims to equivalent maya transforms
   /// \param  shape the proxy shape these transforms are being pulled in from
@@ -72,7 +111,8 @@ public:
 
   /// \brief  After transforms exist to parent the custom plugin-prim types (i.e. after a call to
   ///         createTranformChainsForSchemaPrims), this method should be called to call the plugin translators for all
-  ///         those nodes that should be imported into the Maya Scene.
+  ///         those nodes that should be imported into the Maya Scene. The USD data of the prims whose translators
+  ///         support parallel reads is read concurrently, prior to the Maya nodes being created in serial.
   /// \param  proxy the proxy shape to create the schema prims on
   /// \param  objsToCreate the mapping returned from createTranformChainsForSchemaPrims
   /// \param  param the translator plugin options
@@ -89,7 +129,8 @@ public:
       nodes::ProxyShape* proxy,
       const std::vector<UsdPrim>& objsToCreate);
 
-  /// \brief  updates the list of UsdPrims after a variant switch (but when the nodes have not changed)
+  /// \brief  updates the list of UsdPrims after a variant switch (but when the nodes have not changed). As with
+  ///         createSchemaPrims, the USD data is read in parallel for translators that support it.
   /// \param  proxy the proxy shape to update
   /// \param  objsToUpdate the list of prims to be updated
   static void updateSchemaPrims(
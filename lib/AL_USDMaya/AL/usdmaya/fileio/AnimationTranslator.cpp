@@ -256,7 +256,7 @@ bool AnimationTranslator::isAnimatedTransform(const MObject& transformNode)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void AnimationTranslator::exportAnimation(const ExporterParams& params)
+void AnimationTranslator::exportAnimation(const ExporterParams& params, double minFrame, double maxFrame)
 {
   auto const startAttrib =  m_animatedPlugs.begin();
   auto const endAttrib =  m_animatedPlugs.end();
@@ -273,7 +273,7 @@ void AnimationTranslator::exportAnimation(const ExporterParams& params)
      (!m_animatedNodes.empty()))
   {
     double increment = 1.0 / std::max(1U, params.m_subSamples);
-    for(double t = params.m_minFrame, e = params.m_maxFrame + 1e-3f; t < e; t += increment)
+    for(double t = minFrame, e = maxFrame + 1e-3f; t < e; t += increment)
     {
       MAnimControl::setCurrentTime(t);
       UsdTimeCode timeCode(t);
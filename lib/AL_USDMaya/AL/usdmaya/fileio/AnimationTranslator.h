@@ -205,7 +205,16 @@ public:
   /// \brief  After the scene has been exported, call this method to export the animation data on various attributes
   /// \param  params the export options
   AL_USDMAYA_PUBLIC
-  void exportAnimation(const ExporterParams& params);
+  void exportAnimation(const ExporterParams& params)
+    { exportAnimation(params, params.m_minFrame, params.m_maxFrame); }
+
+  /// \brief  exports the animation data on various attributes for a sub range of the frames in the export options.
+  ///         This is used to export the animation in chunks (e.g. when writing value clips).
+  /// \param  params the export options (the sub sample setting is used, but not the frame range)
+  /// \param  minFrame the first frame to export
+  /// \param  maxFrame the last frame to export (inclusive)
+  AL_USDMAYA_PUBLIC
+  void exportAnimation(const ExporterParams& params, double minFrame, double maxFrame);
 
   /// \brief  insert a prim into the anim translator for custom anim export. 
   /// \param  translator the plugin translator to handle the export of anim data for the node
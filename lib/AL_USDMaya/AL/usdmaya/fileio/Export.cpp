@@ -23,7 +23,10 @@
 #include "maya/MAnimControl.h"
 #include "maya/MAnimUtil.h"
 #include "maya/MArgDatabase.h"
+#include "maya/MColorArray.h"
 #include "maya/MDagPath.h"
+#include "maya/MDoubleArray.h"
+#include "maya/MFloatArray.h"
 #include "maya/MFnCamera.h"
 #include "maya/MFnDagNode.h"
 #include "maya/MFnMesh.h"
@@ -36,8 +39,20 @@
 #include "maya/MPlug.h"
 #include "maya/MPlugArray.h"
 #include "maya/MSelectionList.h"
+#include "maya/MStringArray.h"
+#include "maya/MUintArray.h"
 #include "maya/MUuid.h"
 
+#include "pxr/base/arch/hash.h"
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/work/dispatcher.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/schema.h"
+#include "pxr/usd/usd/clipsAPI.h"
 #include "pxr/usd/usd/modelAPI.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usd/variantSets.h"
@@ -49,10 +64,13 @@
 #include "pxr/base/gf/transform.h"
 #include "pxr/usd/usdGeom/camera.h"
 
+#include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <cmath>
 #include "AL/usdmaya/utils/Utils.h"
 #include "AL/usdmaya/utils/MeshUtils.h"
+#include "AL/usd/utils/DiffCore.h"
 #include "AL/usd/utils/SIMD.h"
 #include "AL/maya/utils/MObjectMap.h"
 #include <functional>
@@ -64,62 +82,61 @@ namespace fileio {
 AL_MAYA_DEFINE_COMMAND(ExportCommand, AL_usdmaya);
 
 //----------------------------------------------------------------------------------------------------------------------
-static unsigned int mayaDagPathToSdfPath(char* dagPathBuffer, unsigned int dagPathSize)
+/// \brief  Generates the SdfPaths of the nodes visited by a depth first walk of a DAG hierarchy. Rather than converting
+///         the full path name of each node into an SdfPath (which costs time proportional to the depth of the node),
+///         the path of each node is appended to the path of its parent. The namespace stripped node names are cached.
+//----------------------------------------------------------------------------------------------------------------------
+class UsdPathBuilder
 {
-  char* writer = dagPathBuffer;
-  char* backTrack = writer;
-
-  for (const char *reader = dagPathBuffer, *end = reader + dagPathSize; reader != end; ++reader)
+public:
+
+  /// \brief  ctor
+  /// \param  rootDepth the length of the dag path that the generated paths will be relative to
+  explicit UsdPathBuilder(const uint32_t rootDepth)
+    : m_rootDepth(rootDepth) {}
+
+  /// \brief  returns the path of a transform visited by the walk. The parent of the transform must have been visited
+  ///         beforehand (unless it is the first node in the walk).
+  /// \param  path the dag path of the transform
+  /// \param  fn a function set attached to the transform
+  /// \return the USD path of the transform
+  const SdfPath& transformPath(const MDagPath& path, const MFnDagNode& fn)
   {
-    const char c = *reader;
-    switch (c)
-    {
-      case ':':
-        writer = backTrack;
-        break;
-
-      case '|':
-        *writer = '/';
-        ++writer;
-        backTrack = writer;
-        break;
-
-      default:
-        if (reader != writer)
-          *writer = c;
-
-        ++writer;
-        break;
-    }
+    const uint32_t depth = path.length() - m_rootDepth;
+    m_paths.resize(depth);
+    const SdfPath& parentPath = depth > 1 ? m_paths[depth - 2] : SdfPath::AbsoluteRootPath();
+    m_paths[depth - 1] = parentPath.AppendChild(nodeName(fn));
+    return m_paths[depth - 1];
   }
 
-  return writer - dagPathBuffer;
-}
+  /// \brief  returns the path of a shape parented under a transform
+  /// \param  transformPath the USD path of the parent transform
+  /// \param  fn a function set attached to the shape
+  /// \return the USD path of the shape
+  SdfPath shapePath(const SdfPath& transformPath, const MFnDagNode& fn)
+    { return transformPath.AppendChild(nodeName(fn)); }
 
-//----------------------------------------------------------------------------------------------------------------------
-static inline SdfPath makeUsdPath(const MDagPath& rootPath, const MDagPath& path)
-{
-  // if the rootPath is empty, we can just use the entire path
-  const uint32_t rootPathLength = rootPath.length();
-  if(!rootPathLength)
+private:
+
+  const TfToken& nodeName(const MFnDagNode& fn)
   {
-    std::string fpn = AL::maya::utils::convert(path.fullPathName());
-    fpn.resize(mayaDagPathToSdfPath(&fpn[0], fpn.size()));
-    return SdfPath(fpn);
+    const MString name = fn.name();
+    std::string key(name.asChar(), name.length());
+    auto it = m_names.find(key);
+    if(it == m_names.end())
+    {
+      // strip off the namespaces
+      const size_t colon = key.find_last_of(':');
+      const TfToken token(colon == std::string::npos ? key : key.substr(colon + 1));
+      it = m_names.emplace(std::move(key), token).first;
+    }
+    return it->second;
   }
 
-  // otherwise we need to do a little fiddling.
-  MString rootPathString, pathString, newPathString;
-  rootPathString = rootPath.fullPathName();
-  pathString = path.fullPathName();
-
-  // trim off the root path from the object we are exporting
-  newPathString = pathString.substring(rootPathString.length(), pathString.length());
-
-  std::string fpn = AL::maya::utils::convert(newPathString);
-  fpn.resize(mayaDagPathToSdfPath(&fpn[0], fpn.size()));
-  return SdfPath(fpn);
-}
+  std::unordered_map<std::string, TfToken> m_names;
+  SdfPathVector m_paths;
+  const uint32_t m_rootDepth;
+};
 
 //----------------------------------------------------------------------------------------------------------------------
 static inline MDagPath getParentPath(const MDagPath& dagPath)
@@ -142,6 +159,253 @@ static inline SdfPath makeMasterPath(UsdPrim instancesPrim, const MDagPath& dagP
   return SdfPath(usdPath);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+/// appends the length and the elements of a maya array to the content buffer
+template<typename ArrayType>
+static void appendMeshContent(std::string& content, const ArrayType& array)
+{
+  const uint32_t count = array.length();
+  content.append((const char*)&count, sizeof(count));
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    const auto value = array[i];
+    content.append((const char*)&value, sizeof(value));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// appends the length and the data of an array of floats to the content buffer
+static void appendMeshContent(std::string& content, const float* data, uint32_t count)
+{
+  content.append((const char*)&count, sizeof(count));
+  if(data)
+  {
+    content.append((const char*)data, sizeof(float) * count);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// appends the name and the value (as the setAttr commands that would restore it) of a plug to the content buffer
+static void appendPlugContent(std::string& content, const MPlug& plug)
+{
+  const MString name = plug.partialName(false, false, false, false, false, true);
+  content.append(name.asChar(), name.length() + 1);
+  MStringArray commands;
+  plug.getSetAttrCmds(commands, MPlug::kAll, true);
+  for(uint32_t i = 0, n = commands.length(); i < n; ++i)
+  {
+    content.append(commands[i].asChar(), commands[i].length() + 1);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the mesh attributes that MeshExportContext::copyGlimpseTesselationAttributes writes to the prim
+static const char* const g_glimpseTesselationAttributes[] = {
+  "gSubdiv",
+  "gSubdivKeepUvBoundary",
+  "gSubdivLevel",
+  "gSubdivPrimSizeMult",
+  "gSubdivEdgeLengthMultiplier"
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// gathers the data that determines whether two meshes export identically (everything MeshTranslator::exportObject
+/// writes: the orientation, topology, points, normals, UVs, colour sets, holes, creases, glimpse tesselation
+/// attributes and optionally the dynamic attributes) into a single buffer, so that meshes can be hashed and compared
+static void gatherMeshContent(const MObject& mesh, bool dynamicAttributes, std::string& content)
+{
+  content.clear();
+  MFnMesh fnMesh(mesh);
+  const bool leftHanded = fnMesh.findPlug("opposite", true).asBool();
+  content.append((const char*)&leftHanded, sizeof(leftHanded));
+
+  MIntArray counts, indices;
+  fnMesh.getVertices(counts, indices);
+  appendMeshContent(content, counts);
+  appendMeshContent(content, indices);
+  appendMeshContent(content, fnMesh.getRawPoints(0), fnMesh.numVertices() * 3);
+  appendMeshContent(content, fnMesh.getRawNormals(0), fnMesh.numNormals() * 3);
+  fnMesh.getNormalIds(counts, indices);
+  appendMeshContent(content, indices);
+
+  MStringArray setNames;
+  fnMesh.getUVSetNames(setNames);
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    content.append(setNames[i].asChar(), setNames[i].length() + 1);
+    MFloatArray u, v;
+    fnMesh.getUVs(u, v, &setNames[i]);
+    appendMeshContent(content, u);
+    appendMeshContent(content, v);
+    fnMesh.getAssignedUVs(counts, indices, &setNames[i]);
+    appendMeshContent(content, counts);
+    appendMeshContent(content, indices);
+  }
+
+  fnMesh.getColorSetNames(setNames);
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    content.append(setNames[i].asChar(), setNames[i].length() + 1);
+    MColorArray colours;
+    fnMesh.getFaceVertexColors(colours, &setNames[i]);
+    appendMeshContent(content, colours);
+  }
+
+  fnMesh.getHoles(counts, indices);
+  appendMeshContent(content, counts);
+  appendMeshContent(content, indices);
+
+  MUintArray creaseIds;
+  MDoubleArray creaseData;
+  fnMesh.getCreaseEdges(creaseIds, creaseData);
+  appendMeshContent(content, creaseIds);
+  appendMeshContent(content, creaseData);
+  fnMesh.getCreaseVertices(creaseIds, creaseData);
+  appendMeshContent(content, creaseIds);
+  appendMeshContent(content, creaseData);
+
+  for(const char* const attributeName : g_glimpseTesselationAttributes)
+  {
+    MStatus status;
+    MPlug plug = fnMesh.findPlug(attributeName, true, &status);
+    if(status)
+    {
+      appendPlugContent(content, plug);
+    }
+  }
+
+  if(dynamicAttributes)
+  {
+    for(uint32_t i = 0, n = fnMesh.attributeCount(); i < n; ++i)
+    {
+      MPlug plug(mesh, fnMesh.attribute(i));
+      if(plug.isDynamic() && !plug.isChild())
+      {
+        appendPlugContent(content, plug);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// usd::utils::compareArray tests (|a - b| > tolerance), which is false for NaN, so a NaN on either side would otherwise
+/// compare equal. Returns true if any element is NaN in one array but not in the other.
+template<typename Scalar>
+static bool nanMismatch(const Scalar* const a, const Scalar* const b, const size_t count)
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    if(std::isnan(a[i]) != std::isnan(b[i]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// compares a pair of samples of type T (which contains a number of Scalar values) within the tolerance. Returns false
+/// if the samples are not of type T.
+template<typename T, typename Scalar>
+static bool compareSample(const VtValue& a, const VtValue& b, double tolerance, bool& equal)
+{
+  if(!a.IsHolding<T>())
+  {
+    return false;
+  }
+  const size_t count = sizeof(T) / sizeof(Scalar);
+  const Scalar* const dataA = (const Scalar*)&a.UncheckedGet<T>();
+  const Scalar* const dataB = (const Scalar*)&b.UncheckedGet<T>();
+  equal = usd::utils::compareArray(dataA, dataB, count, count, Scalar(tolerance)) &&
+          !nanMismatch(dataA, dataB, count);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// compares a pair of array samples of element type T (which contains a number of Scalar values) within the tolerance.
+/// Returns false if the samples are not arrays of type T.
+template<typename T, typename Scalar>
+static bool compareArraySample(const VtValue& a, const VtValue& b, double tolerance, bool& equal)
+{
+  if(!a.IsHolding<VtArray<T> >())
+  {
+    return false;
+  }
+  const VtArray<T>& arrayA = a.UncheckedGet<VtArray<T> >();
+  const VtArray<T>& arrayB = b.UncheckedGet<VtArray<T> >();
+  if(arrayA.IsIdentical(arrayB))
+  {
+    equal = true;
+    return true;
+  }
+  const size_t count = sizeof(T) / sizeof(Scalar);
+  const Scalar* const dataA = (const Scalar*)arrayA.cdata();
+  const Scalar* const dataB = (const Scalar*)arrayB.cdata();
+  equal = usd::utils::compareArray(dataA, dataB, arrayA.size() * count, arrayB.size() * count, Scalar(tolerance)) &&
+          !nanMismatch(dataA, dataB, arrayA.size() * count);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool samplesAreEqual(const VtValue& a, const VtValue& b, double tolerance)
+{
+  if(a.GetType() != b.GetType())
+  {
+    return false;
+  }
+  bool equal = false;
+  if(compareSample<float, float>(a, b, tolerance, equal) ||
+     compareSample<double, double>(a, b, tolerance, equal) ||
+     compareSample<GfVec2f, float>(a, b, tolerance, equal) ||
+     compareSample<GfVec3f, float>(a, b, tolerance, equal) ||
+     compareSample<GfVec4f, float>(a, b, tolerance, equal) ||
+     compareSample<GfVec2d, double>(a, b, tolerance, equal) ||
+     compareSample<GfVec3d, double>(a, b, tolerance, equal) ||
+     compareSample<GfVec4d, double>(a, b, tolerance, equal) ||
+     compareSample<GfMatrix4d, double>(a, b, tolerance, equal) ||
+     compareArraySample<float, float>(a, b, tolerance, equal) ||
+     compareArraySample<double, double>(a, b, tolerance, equal) ||
+     compareArraySample<GfVec2f, float>(a, b, tolerance, equal) ||
+     compareArraySample<GfVec3f, float>(a, b, tolerance, equal) ||
+     compareArraySample<GfVec4f, float>(a, b, tolerance, equal) ||
+     compareArraySample<GfVec3d, double>(a, b, tolerance, equal) ||
+     compareArraySample<GfMatrix4d, double>(a, b, tolerance, equal))
+  {
+    return equal;
+  }
+  return a == b;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool filterTimeSamples(const SdfTimeSampleMap& samples, SdfTimeSampleMap& filtered, double tolerance)
+{
+  filtered.clear();
+  if(samples.size() < 2)
+  {
+    return false;
+  }
+
+  // each sample is compared to the first sample of the current run, so small differences can't accumulate
+  auto runStart = samples.begin();
+  auto runEnd = runStart;
+  filtered.emplace_hint(filtered.end(), *runStart);
+  for(auto it = std::next(runStart), end = samples.end(); it != end; ++it)
+  {
+    if(samplesAreEqual(runStart->second, it->second, tolerance))
+    {
+      runEnd = it;
+      continue;
+    }
+    if(runEnd != runStart)
+    {
+      filtered.emplace_hint(filtered.end(), *runEnd);
+    }
+    filtered.emplace_hint(filtered.end(), *it);
+    runStart = runEnd = it;
+  }
+  return filtered.size() != samples.size();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 /// Internal USD exporter implementation
 //----------------------------------------------------------------------------------------------------------------------
@@ -210,6 +474,32 @@ struct Export::Impl
   }
 
 
+  /// \brief  finds a previously visited mesh that has the same content as the given mesh
+  /// \param  mesh the mesh shape node to look up
+  /// \param  dynamicAttributes true if the dynamic attributes of the meshes are exported
+  /// \return the shape node of the identical mesh, or a null object if this is the first mesh with this content (in
+  ///         which case it is recorded, so that later identical meshes will find it)
+  MObject findIdenticalMesh(const MObject& mesh, bool dynamicAttributes)
+  {
+    std::string content;
+    gatherMeshContent(mesh, dynamicAttributes, content);
+    std::vector<MObject>& candidates = m_meshesByContentHash[ArchHash64(content.data(), content.size())];
+
+    // only the hash of each master is kept, so guard against hash collisions by gathering the content of the
+    // candidates again, and comparing it in full
+    std::string candidateContent;
+    for(const MObject& candidate : candidates)
+    {
+      gatherMeshContent(candidate, dynamicAttributes, candidateContent);
+      if(candidateContent == content)
+      {
+        return candidate;
+      }
+    }
+    candidates.push_back(mesh);
+    return MObject::kNullObj;
+  }
+
   inline bool setStage(UsdStageRefPtr ptr)
   {
     m_stage = ptr;
@@ -249,56 +539,194 @@ struct Export::Impl
     }
   }
 
-  void filterSample()
+  /// \brief  removes the redundant time samples of every animated attribute in the root layer. The samples of each
+  ///         attribute are filtered in parallel, and the results written back to the layer within a single change
+  ///         block.
+  /// \param  tolerance the tolerance used when comparing floating point samples
+  void filterSample(double tolerance)
   {
-    std::vector<double> timeSamples;
-    std::vector<double> dupSamples;
-    for (auto prim : m_stage->Traverse())
+    SdfLayerHandle rootLayer = m_stage->GetRootLayer();
+    SdfPathVector animated;
+    rootLayer->Traverse(SdfPath::AbsoluteRootPath(), [&rootLayer, &animated] (const SdfPath& path)
     {
-      std::vector<UsdAttribute> attributes = prim.GetAuthoredAttributes();
-      for (auto attr : attributes)
+      if(path.IsPropertyPath() && rootLayer->GetNumTimeSamplesForPath(path) > 1)
       {
-        timeSamples.clear();
-        dupSamples.clear();
-        attr.GetTimeSamples(&timeSamples);
-        VtValue prevSampleBlob;
-        for (auto sample : timeSamples)
+        animated.push_back(path);
+      }
+    });
+
+    std::vector<SdfTimeSampleMap> filtered(animated.size());
+    std::vector<char> changed(animated.size(), 0);
+    WorkParallelForN(animated.size(), [&](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const VtValue samples = rootLayer->GetField(animated[i], SdfFieldKeys->TimeSamples);
+        if(samples.IsHolding<SdfTimeSampleMap>())
         {
-          VtValue currSampleBlob;
-          attr.Get(&currSampleBlob, sample);
-          if (prevSampleBlob == currSampleBlob)
-          {
-            dupSamples.emplace_back(sample);
-          }
-          else
-          {
-            prevSampleBlob = currSampleBlob;
-            // only clear samples between constant segment
-            if (dupSamples.size() > 1)
-            {
-              dupSamples.pop_back();
-              for (auto dup : dupSamples)
-              {
-                attr.ClearAtTime(dup);
-              }
-            }
-            dupSamples.clear();
-          }
+          changed[i] = filterTimeSamples(samples.UncheckedGet<SdfTimeSampleMap>(), filtered[i], tolerance);
         }
-        for (auto dup : dupSamples)
+      }
+    });
+
+    SdfChangeBlock changeBlock;
+    for(size_t i = 0, n = animated.size(); i < n; ++i)
+    {
+      if(changed[i])
+      {
+        rootLayer->SetField(animated[i], SdfFieldKeys->TimeSamples, VtValue(filtered[i]));
+      }
+    }
+  }
+
+  /// \brief  returns the file name of a layer written alongside the exported file, e.g. "shot.usda" with the suffix
+  ///         "clip0001" becomes "shot.clip0001.usda"
+  static std::string sidecarFileName(const std::string& fileName, const std::string& suffix)
+  {
+    const std::string::size_type dot = fileName.rfind('.');
+    const std::string::size_type slash = fileName.find_last_of("/\\");
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+      return fileName + "." + suffix + ".usda";
+    }
+    return fileName.substr(0, dot) + "." + suffix + fileName.substr(dot);
+  }
+
+  /// \brief  creates (if needed) the spec for the attribute at the given path in the layer, matching the source spec
+  static void declareAttribute(const SdfLayerHandle& layer, const SdfPath& path, const SdfAttributeSpecHandle& source)
+  {
+    if(layer->GetAttributeAtPath(path))
+    {
+      return;
+    }
+    SdfPrimSpecHandle prim = SdfCreatePrimInLayer(layer, path.GetPrimPath());
+    if(prim)
+    {
+      SdfAttributeSpec::New(prim, path.GetNameToken(), source->GetTypeName(), source->GetVariability(), source->IsCustom());
+    }
+  }
+
+  /// \brief  moves all of the time samples currently authored in the root layer into the clip layer, and declares
+  ///         the attributes in the clip manifest. Time samples that were written as static data (prior to the
+  ///         animation export) are left in the root layer.
+  void moveTimeSamplesToClip(const SdfLayerRefPtr& clip)
+  {
+    SdfLayerHandle rootLayer = m_stage->GetRootLayer();
+    SdfPathVector animated;
+    rootLayer->Traverse(SdfPath::AbsoluteRootPath(), [&rootLayer, &animated] (const SdfPath& path)
+    {
+      if(path.IsPropertyPath() && rootLayer->GetNumTimeSamplesForPath(path))
+      {
+        animated.push_back(path);
+      }
+    });
+
+    SdfChangeBlock changeBlock;
+    for(const SdfPath& path : animated)
+    {
+      VtValue samples = rootLayer->GetField(path, SdfFieldKeys->TimeSamples);
+      auto staticSamples = m_staticSamples.find(path);
+      if(staticSamples != m_staticSamples.end())
+      {
+        if(staticSamples->second == samples)
         {
-          attr.ClearAtTime(dup);
+          continue;
         }
+        m_staticSamples.erase(staticSamples);
+      }
+
+      SdfAttributeSpecHandle spec = rootLayer->GetAttributeAtPath(path);
+      if(!spec)
+      {
+        continue;
+      }
+      declareAttribute(clip, path, spec);
+      declareAttribute(m_clipManifest, path, spec);
+      clip->SetField(path, SdfFieldKeys->TimeSamples, samples);
+      rootLayer->EraseField(path, SdfFieldKeys->TimeSamples);
+    }
+  }
+
+  /// \brief  exports the animation in chunks of params.m_clipFrames frames. Each chunk is moved out of the root layer
+  ///         into its own clip layer, which is written to disk in the background while the next chunk is sampled.
+  ///         The animated attributes are declared in a manifest layer, and the clip metadata is authored on each
+  ///         root prim of the stage.
+  void exportAnimationClips(const ExporterParams& params)
+  {
+    const std::string fileName = params.m_fileName.asChar();
+    SdfLayerHandle rootLayer = m_stage->GetRootLayer();
+
+    // remember any time samples that have been written as static data
+    m_staticSamples.clear();
+    rootLayer->Traverse(SdfPath::AbsoluteRootPath(), [this, &rootLayer] (const SdfPath& path)
+    {
+      if(path.IsPropertyPath() && rootLayer->GetNumTimeSamplesForPath(path))
+      {
+        m_staticSamples.emplace(path, rootLayer->GetField(path, SdfFieldKeys->TimeSamples));
+      }
+    });
+    m_clipManifest = SdfLayer::CreateAnonymous();
+
+    VtArray<SdfAssetPath> assetPaths;
+    VtVec2dArray active;
+    VtVec2dArray times;
+    WorkDispatcher dispatcher;
+    uint32_t index = 0;
+    for(double start = params.m_minFrame; ; start += params.m_clipFrames, ++index)
+    {
+      // adjacent clips share their boundary frame, so that values interpolate correctly across the clips
+      const double end = std::min(start + params.m_clipFrames, params.m_maxFrame);
+      params.m_animTranslator->exportAnimation(params, start, end);
+      if(params.m_filterSample)
+      {
+        filterSample(params.m_filterTolerance);
+      }
+
+      SdfLayerRefPtr clip = SdfLayer::CreateAnonymous();
+      moveTimeSamplesToClip(clip);
+
+      const std::string clipFileName = sidecarFileName(fileName, TfStringPrintf("clip%04u", index));
+      assetPaths.push_back(SdfAssetPath("./" + TfGetBaseName(clipFileName)));
+      active.push_back(GfVec2d(start, index));
+      times.push_back(GfVec2d(start, start));
+
+      // only one clip is written in the background at any time, which bounds the memory used to two chunks
+      dispatcher.Wait();
+      dispatcher.Run([clip, clipFileName] () { clip->Export(clipFileName); });
+
+      if(end >= params.m_maxFrame)
+      {
+        times.push_back(GfVec2d(end, end));
+        break;
       }
     }
+
+    const std::string manifestFileName = sidecarFileName(fileName, "manifest");
+    SdfLayerRefPtr manifest = m_clipManifest;
+    dispatcher.Run([manifest, manifestFileName] () { manifest->Export(manifestFileName); });
+
+    const SdfAssetPath manifestAssetPath("./" + TfGetBaseName(manifestFileName));
+    for(const UsdPrim& prim : m_stage->GetPseudoRoot().GetChildren())
+    {
+      UsdClipsAPI clipsAPI(prim);
+      clipsAPI.SetClipAssetPaths(assetPaths);
+      clipsAPI.SetClipPrimPath(prim.GetPath().GetString());
+      clipsAPI.SetClipActive(active);
+      clipsAPI.SetClipTimes(times);
+      clipsAPI.SetClipManifestAssetPath(manifestAssetPath);
+    }
+
+    dispatcher.Wait();
+    m_clipManifest = SdfLayerRefPtr();
+    m_staticSamples.clear();
   }
 
-  void doExport(const char* const filename, bool toFilter = false, SdfPath defaultPrim = SdfPath())
+  void doExport(const char* const filename, bool toFilter = false, SdfPath defaultPrim = SdfPath(), double filterTolerance = 0)
   {
     setDefaultPrimIfOnlyOneRoot(defaultPrim);
     if (toFilter)
     {
-      filterSample();
+      filterSample(filterTolerance);
     }
     m_stage->GetRootLayer()->Save();
     m_nodeMap.clear();
@@ -336,8 +764,11 @@ private:
   std::map<AL::maya::utils::guid, MObject, AL::maya::utils::guid_compare> m_nodeMap;
   std::map<AL::maya::utils::guid, SdfPath, AL::maya::utils::guid_compare> m_instanceMap;
   #endif
+  std::unordered_map<uint64_t, std::vector<MObject> > m_meshesByContentHash; ///< the master meshes, by content hash
   UsdStageRefPtr m_stage;
   UsdPrim m_instancesPrim;
+  SdfLayerRefPtr m_clipManifest;
+  TfHashMap<SdfPath, VtValue, SdfPath::Hash> m_staticSamples;
 };
 
 static MObject g_transform_rotateAttr = MObject::kNullObj;
@@ -796,6 +1227,7 @@ void Export::exportSceneHierarchy(MDagPath rootPath, SdfPath& defaultPrim)
     };
   }
 
+  UsdPathBuilder pathBuilder(parentPath.length());
   MFnTransform fnTransform;
   // loop through transforms only
   while(!it.isDone())
@@ -805,6 +1237,7 @@ void Export::exportSceneHierarchy(MDagPath rootPath, SdfPath& defaultPrim)
     it.getPath(transformPath);
 
     fnTransform.setObject(transformPath);
+    const SdfPath transformUsdPath = pathBuilder.transformPath(transformPath, fnTransform);
 
     // Make sure we haven't seen this transform before.
     bool transformHasBeenExported = m_impl->contains(fnTransform);
@@ -825,7 +1258,7 @@ void Export::exportSceneHierarchy(MDagPath rootPath, SdfPath& defaultPrim)
       MPlug originalNamePlug = fnTransform.findPlug("alusd_originalPath", &status);
       if(!status)
       {
-        usdPath = makeUsdPath(parentPath, transformPath);
+        usdPath = transformUsdPath;
       }
 
       // for UV only exporting, record first prim as default
@@ -874,12 +1307,28 @@ void Export::exportSceneHierarchy(MDagPath rootPath, SdfPath& defaultPrim)
           if(!m_params.m_mergeTransforms)
           {
             fnTransform.setObject(shapePath);
-            shapeUsdPath = makeUsdPath(parentPath, shapePath);
+            shapeUsdPath = pathBuilder.shapePath(transformUsdPath, shapeDag);
           }
 
           bool shapeNotYetExported = !m_impl->contains(shapePath.node());
           bool shapeInstanced = shapePath.isInstanced();
-          if(shapeNotYetExported || m_params.m_duplicateInstances)
+
+          // a static mesh that is the only shape of its transform can be replaced by a reference to an earlier mesh
+          // with identical content. The first mesh with that content is exported as the master. This is limited to
+          // merged transforms: an unmerged copy would reference the master's transform, and so its shape prim would
+          // be named after the master's shape rather than its own.
+          MObject identicalShape;
+          if(m_params.m_deduplicateMeshes && m_params.m_mergeTransforms && numShapes == 1 && shapeNotYetExported &&
+             !shapeInstanced && shapePath.node().hasFn(MFn::kMesh) && !shapeDag.isIntermediateObject() &&
+             !(m_params.m_animTranslator && AnimationTranslator::isAnimatedMesh(shapePath)))
+          {
+            identicalShape = m_impl->findIdenticalMesh(shapePath.node(), m_params.m_dynamicAttributes);
+            refType = kShapeReference;
+          }
+
+          // when an identical mesh was found, its geometry has already been written by the master, so only the
+          // reference is needed
+          if(identicalShape.isNull() && (shapeNotYetExported || m_params.m_duplicateInstances))
           {
             // if the path has a child shape, process the shape now
             if (!m_params.m_duplicateInstances && shapeInstanced)
@@ -893,14 +1342,15 @@ void Export::exportSceneHierarchy(MDagPath rootPath, SdfPath& defaultPrim)
             refType = m_params.m_mergeTransforms ? kShapeReference : kTransformReference;
           }
 
+          MFnDagNode masterDag(identicalShape.isNull() ? shapePath.node() : identicalShape);
           if (refType == kShapeReference)
           {
-            SdfPath instancePath = m_impl->getMasterPath(shapeDag);
+            SdfPath instancePath = m_impl->getMasterPath(masterDag);
             addReferences(shapePath, fnTransform, shapeUsdPath, instancePath, refType);
           }
           else if (refType == kTransformReference)
           {
-            SdfPath instancePath = m_impl->getMasterPath(MFnDagNode(shapeDag.parent(0)));
+            SdfPath instancePath = m_impl->getMasterPath(MFnDagNode(masterDag.parent(0)));
             addReferences(shapePath, fnTransform, usdPath, instancePath, refType);
           }
         }
@@ -936,7 +1386,7 @@ void Export::doExport()
     MAnimControl::setCurrentTime(m_params.m_minFrame);
   }
 
-  if(!m_params.m_duplicateInstances)
+  if(!m_params.m_duplicateInstances || m_params.m_deduplicateMeshes)
   {
     m_impl->createInstancesPrim();
   }
@@ -971,7 +1421,14 @@ void Export::doExport()
 
   if(m_params.m_animTranslator)
   {
-    m_params.m_animTranslator->exportAnimation(m_params);
+    if(m_params.m_clipFrames)
+    {
+      m_impl->exportAnimationClips(m_params);
+    }
+    else
+    {
+      m_params.m_animTranslator->exportAnimation(m_params);
+    }
     m_impl->setAnimationFrame(m_params.m_minFrame, m_params.m_maxFrame);
 
     // return user to their original frame
@@ -979,7 +1436,9 @@ void Export::doExport()
   }
 
   m_impl->processInstances();
-  m_impl->doExport(m_params.m_fileName.asChar(), m_params.m_filterSample, defaultPrim);
+  // when writing clips, the samples have already been filtered a chunk at a time
+  m_impl->doExport(m_params.m_fileName.asChar(), m_params.m_filterSample && !m_params.m_clipFrames, defaultPrim,
+                   m_params.m_filterTolerance);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1020,6 +1479,10 @@ MStatus ExportCommand::doIt(const MArgList& args)
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("di", 0, m_params.m_duplicateInstances), "ALUSDExport: Unable to fetch \"duplicateInstances\" argument");
   }
+  if(argData.isFlagSet("dm", &status))
+  {
+    AL_MAYA_CHECK_ERROR(argData.getFlagArgument("dm", 0, m_params.m_deduplicateMeshes), "ALUSDExport: Unable to fetch \"deduplicateMeshes\" argument");
+  }
   if(argData.isFlagSet("m", &status))
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("m", 0, m_params.m_meshes), "ALUSDExport: Unable to fetch \"meshes\" argument");
@@ -1074,6 +1537,14 @@ MStatus ExportCommand::doIt(const MArgList& args)
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("fs", 0, m_params.m_filterSample), "ALUSDExport: Unable to fetch \"filter sample\" argument");
   }
+  if (argData.isFlagSet("fst", &status))
+  {
+    AL_MAYA_CHECK_ERROR(argData.getFlagArgument("fst", 0, m_params.m_filterTolerance), "ALUSDExport: Unable to fetch \"filter sample tolerance\" argument");
+  }
+  if(argData.isFlagSet("cf", &status))
+  {
+    AL_MAYA_CHECK_ERROR(argData.getFlagArgument("cf", 0, m_params.m_clipFrames), "ALUSDExport: Unable to fetch \"clip frames\" argument");
+  }
   if(argData.isFlagSet("eac", &status))
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("eac", 0, m_params.m_extensiveAnimationCheck), "ALUSDExport: Unable to fetch \"extensive animation check\" argument");
@@ -1161,6 +1632,8 @@ MSyntax ExportCommand::createSyntax()
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-di" , "-duplicateInstances", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
+  status = syntax.addFlag("-dm" , "-deduplicateMeshes", MSyntax::kBoolean);
+  AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-mt", "-mergeTransforms", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-ani", "-animation", MSyntax::kNoArg);
@@ -1169,6 +1642,10 @@ MSyntax ExportCommand::createSyntax()
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-fs", "-filterSample", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
+  status = syntax.addFlag("-fst", "-filterSampleTolerance", MSyntax::kDouble);
+  AL_MAYA_CHECK_ERROR2(status, errorString);
+  status = syntax.addFlag("-cf", "-clipFrames", MSyntax::kUnsigned);
+  AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-eac", "-extensiveAnimationCheck", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-ss", "-subSamples", MSyntax::kUnsigned);
@@ -1202,8 +1679,19 @@ ExportCommand Overview:
   Nurbs curves can be exported by passing the corresponding parameters:
     1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -nc
 
-  The exporter can remove samples that contain the same data for adjacent samples
+  Static meshes that are duplicated (rather than instanced) in maya can be exported once, and referenced from each
+  of their transforms. Meshes are matched by their topology, points, normals, UVs, colour sets, holes and creases:
+    1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -dm 1
+
+  The exporter can remove samples that contain the same data for adjacent samples. Floating point samples can
+  optionally be treated as the same if they differ by no more than a tolerance:
     1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -fs
+    2. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -fs -fst 0.0001
+
+  Long frame ranges can be split into value clips of N frames, which bounds the memory used by the export. Each clip
+  is written to "<file>.clipNNNN.usd" (with the animated attributes declared in "<file>.manifest.usd"), and the clip
+  metadata is authored on the root prims of the exported file:
+    1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -frameRange 1 1000 -clipFrames 100
 )";
 
 //----------------------------------------------------------------------------------------------------------------------
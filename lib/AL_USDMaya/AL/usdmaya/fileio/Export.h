@@ -20,6 +20,7 @@
 #include "maya/MPxCommand.h"
 
 #include "pxr/pxr.h"
+#include "pxr/usd/sdf/types.h"
 #include "AL/usdmaya/utils/ForwardDeclares.h"
 #include "AL/maya/utils/Api.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
@@ -31,6 +32,20 @@ namespace AL {
 namespace usdmaya {
 namespace fileio {
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Removes the redundant samples from the time samples of an attribute. Within each run of identical adjacent
+///         samples only the first and last samples are kept (so the values interpolate as before), and a run at the
+///         end of the samples only keeps its first sample. Arrays, vectors, and matrices of floating point values are
+///         compared element-wise within the tolerance, all other types of sample must be equal.
+/// \param  samples the time samples to filter
+/// \param  filtered the returned filtered time samples (only valid if the function returns true)
+/// \param  tolerance the maximum difference between two floating point values that are considered equal
+/// \return true if any samples were removed, false if none of the samples are redundant
+/// \ingroup   fileio
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+bool filterTimeSamples(const SdfTimeSampleMap& samples, SdfTimeSampleMap& filtered, double tolerance = 0);
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class that wraps up the entire export process
 ///
@@ -54,10 +54,13 @@ struct ExporterParams
   bool m_nurbsCurves = true; ///< if true export nurbs curves
   bool m_dynamicAttributes = true; ///< if true export any dynamic attributes found on the nodes we are exporting
   bool m_duplicateInstances = true; ///< if true, instances will be exported as duplicates. As of 23/01/17, nothing will be exported if set to false.
+  bool m_deduplicateMeshes = false; ///< if true (and transforms are merged), static meshes with identical content will be exported once, and referenced from each of their transforms
   bool m_mergeTransforms = true; ///< if true, shapes will be merged into their parent transforms in the exported data. If false, the transform and shape will be exported seperately
   bool m_animation = false; ///< if true, animation will be exported.
   bool m_useTimelineRange = false; ///< if true, then the export uses Maya's timeline range.
   bool m_filterSample = false; ///< if true, duplicate sample of attribute will be filtered out
+  double m_filterTolerance = 0.0; ///< when filtering samples, floating point values that differ by no more than this are considered duplicates
+  uint32_t m_clipFrames = 0; ///< if non-zero, animation is written into value clip layers of (at most) this many frames each, rather than into the root layer
   bool m_exportInWorldSpace = false; ///< if true, transform hierarchies will be flattened to a single WS transform PRIM (and no parents will be written out)
   int m_compactionLevel = 3; ///< by default apply the strongest level of data compaction
   AnimationTranslator* m_animTranslator = 0; ///< the animation translator to help exporting the animation data
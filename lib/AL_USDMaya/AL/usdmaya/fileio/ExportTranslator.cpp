@@ -23,6 +23,7 @@
 #include "maya/MItDag.h"
 #include "maya/MSelectionList.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 namespace AL {
@@ -62,6 +63,7 @@ MStatus ExportTranslator::writer(const MFileObject& file, const AL::maya::utils:
   ExporterParams params;
   params.m_dynamicAttributes = options.getBool(kDynamicAttributes);
   params.m_duplicateInstances = options.getBool(kDuplicateInstances);
+  params.m_deduplicateMeshes = options.getBool(kDeduplicateMeshes);
   params.m_meshes = options.getBool(kMeshes);
   params.m_meshConnects = options.getBool(kMeshConnects);
   params.m_meshPoints = options.getBool(kMeshPoints);
@@ -98,6 +100,8 @@ MStatus ExportTranslator::writer(const MFileObject& file, const AL::maya::utils:
     params.m_animTranslator = new AnimationTranslator;
   }
   params.m_filterSample = options.getBool(kFilterSample);
+  params.m_filterTolerance = options.getFloat(kFilterTolerance);
+  params.m_clipFrames = std::max(0, options.getInt(kClipFrames));
   if(params.m_selected)
   {
     MGlobal::getActiveSelectionList(params.m_nodes);
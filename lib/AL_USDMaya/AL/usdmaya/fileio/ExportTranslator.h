@@ -56,6 +56,7 @@ AL_MAYA_TRANSLATOR_BEGIN(ExportTranslator, "AL usdmaya export", false, true, "us
   static constexpr const char* const kCompactionLevel = "Compaction Level"; ///< export mesh face holes
   static constexpr const char* const kNurbsCurves = "Nurbs Curves"; ///< export nurbs curves option name
   static constexpr const char* const kDuplicateInstances = "Duplicate Instances"; ///< export instances option name
+  static constexpr const char* const kDeduplicateMeshes = "Deduplicate Meshes"; ///< export identical meshes once option name
   static constexpr const char* const kMergeTransforms = "Merge Transforms"; ///< export by merging transforms and shapes option name
   static constexpr const char* const kAnimation = "Animation"; ///< export animation data option name
   static constexpr const char* const kUseTimelineRange = "Use Timeline Range"; ///< export using the timeline range option name
@@ -63,6 +64,8 @@ AL_MAYA_TRANSLATOR_BEGIN(ExportTranslator, "AL usdmaya export", false, true, "us
   static constexpr const char* const kFrameMax = "Frame Max"; ///< specify max time frame option name
   static constexpr const char* const kSubSamples = "Sub Samples"; ///< specify the number of sub samples to export
   static constexpr const char* const kFilterSample = "Filter Sample"; ///< export filter sample option name
+  static constexpr const char* const kFilterTolerance = "Filter Sample Tolerance"; ///< tolerance used when filtering samples
+  static constexpr const char* const kClipFrames = "Clip Frames"; ///< if non-zero, the number of frames per value clip
   static constexpr const char* const kExportAtWhichTime = "Export At Which Time";
   static constexpr const char* const kExportInWorldSpace = "Export In World Space";
 
@@ -94,6 +97,7 @@ AL_MAYA_TRANSLATOR_BEGIN(ExportTranslator, "AL usdmaya export", false, true, "us
     if(!options.addEnum(kCompactionLevel, compactionLevels, defaultValues.m_compactionLevel)) return MS::kFailure;
     if(!options.addBool(kNurbsCurves, defaultValues.m_nurbsCurves)) return MS::kFailure;
     if(!options.addBool(kDuplicateInstances, defaultValues.m_duplicateInstances)) return MS::kFailure;
+    if(!options.addBool(kDeduplicateMeshes, defaultValues.m_deduplicateMeshes)) return MS::kFailure;
     if(!options.addBool(kMergeTransforms, defaultValues.m_mergeTransforms)) return MS::kFailure;
     if(!options.addBool(kAnimation, defaultValues.m_animation)) return MS::kFailure;
     if(!options.addBool(kUseTimelineRange, defaultValues.m_useTimelineRange)) return MS::kFailure;
@@ -101,6 +105,8 @@ AL_MAYA_TRANSLATOR_BEGIN(ExportTranslator, "AL usdmaya export", false, true, "us
     if(!options.addFloat(kFrameMax, defaultValues.m_maxFrame)) return MS::kFailure;
     if(!options.addInt(kSubSamples, defaultValues.m_subSamples)) return MS::kFailure;
     if(!options.addBool(kFilterSample, defaultValues.m_filterSample)) return MS::kFailure;
+    if(!options.addFloat(kFilterTolerance, defaultValues.m_filterTolerance)) return MS::kFailure;
+    if(!options.addInt(kClipFrames, defaultValues.m_clipFrames)) return MS::kFailure;
     if(!options.addEnum(kExportAtWhichTime, timelineLevel, defaultValues.m_exportAtWhichTime)) return MS::kFailure;
     if(!options.addBool(kExportInWorldSpace, defaultValues.m_exportAtWhichTime)) return MS::kFailure;
     
@@ -74,14 +74,13 @@ bool isSchemaOfType(const UsdPrim& prim, const TfToken& typeToken)
     return true;
   }
 
-  // Check to see if the prim has been tagged with an ALType.
-  if(prim.HasCustomDataKey(ALSchemaType))
+  // Check to see if the prim has been tagged with an ALType. Only the key itself is queried here, which avoids
+  // composing the full customData dictionary.
+  VtValue typeValue = prim.GetCustomDataByKey(ALSchemaType);
+  if(typeValue.IsHolding<std::string>())
   {
-    VtValue typeValue = prim.GetCustomDataByKey(ALSchemaType);
-
     // Check to see if the custom dataType matches the typeName passed in
-    std::string foundFutureSchemaType = typeValue.Get<std::string>();
-    if(foundFutureSchemaType == typeToken)
+    if(typeValue.UncheckedGet<std::string>() == typeToken.GetString())
     {
       return true;
     }
@@ -97,14 +96,15 @@ bool importSchemaPrim(
     MObject& created,
     translators::TranslatorContextPtr context,
     const translators::TranslatorRefPtr torBase,
-    const fileio::translators::TranslatorParameters& param)
+    const fileio::translators::TranslatorParameters& param,
+    const translators::TranslatorAbstract::PrimData* data)
 {
   if(torBase)
   {
     if(param.forceTranslatorImport() || torBase->importableByDefault())
     {
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("SchemaPrims::importSchemaPrim import %s\n", prim.GetPath().GetText());
-      if(torBase->import(prim, parent, created) != MS::kSuccess)
+      if(torBase->importPrimData(prim, parent, created, data) != MS::kSuccess)
       {
         std::cerr << "Failed to import schema prim \"" << prim.GetPath().GetText() << "\"\n";
         return false;
@@ -144,9 +144,17 @@ bool SchemaPrimsUtils::needsTransformParent(const UsdPrim& prim)
 //----------------------------------------------------------------------------------------------------------------------
 fileio::translators::TranslatorRefPtr SchemaPrimsUtils::isSchemaPrim(const UsdPrim& prim)
 {
+  const TfToken& typeName = prim.GetTypeName();
+  auto cached = m_translatorCache.find(typeName);
+  if(cached != m_translatorCache.end())
+  {
+    return cached->second;
+  }
+
   // the plugin system will return a null pointer if it doesn't know how to
   // translate this prim type
-  fileio::translators::TranslatorRefPtr torBase = m_manufacture.get(prim.GetTypeName());
+  fileio::translators::TranslatorRefPtr torBase = m_manufacture.get(typeName);
+  m_translatorCache.insert(std::make_pair(typeName, torBase));
   return torBase;
 }
 
@@ -19,6 +19,7 @@
 
 #include "pxr/pxr.h"
 #include <pxr/base/tf/token.h>
+#include <pxr/base/tf/hashmap.h>
 
 #include <unordered_set>
 #include <string>
@@ -43,6 +44,7 @@ extern const TfToken ALExcludedPrimSchema;
 /// \param  context a custom context to use when importing the prim
 /// \param  translator the custom translator to use to import the prim
 /// \param  param params controlling the import of the plugin translator nodes
+/// \param  data the data previously read from the prim by the translator's readPrimData method (may be null)
 /// \return true if the import succeeded, false otherwise
 /// \ingroup   fileio
 //----------------------------------------------------------------------------------------------------------------------
@@ -52,7 +54,8 @@ bool importSchemaPrim(
     MObject& created,
     translators::TranslatorContextPtr context = TfNullPtr,
     const translators::TranslatorRefPtr translator = TfNullPtr,
-    const fileio::translators::TranslatorParameters& param = fileio::translators::TranslatorParameters());
+    const fileio::translators::TranslatorParameters& param = fileio::translators::TranslatorParameters(),
+    const translators::TranslatorAbstract::PrimData* data = nullptr);
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  utility function to determine whether the prim specified is of the given type
@@ -75,7 +78,8 @@ public:
   /// \param  manufacture the translator registry
   SchemaPrimsUtils(fileio::translators::TranslatorManufacture& manufacture);
 
-  /// \brief  utility function to determine if a prim is one of our custom schema prims
+  /// \brief  utility function to determine if a prim is one of our custom schema prims. The translator found for each
+  ///         prim type name is cached, so repeated queries for the same type avoid the schema type lookup.
   /// \param  prim the USD prim to test
   /// \return the corresponding translator of the schema prim
   fileio::translators::TranslatorRefPtr isSchemaPrim(const UsdPrim& prim);
@@ -87,6 +91,7 @@ public:
   
 private:
   fileio::translators::TranslatorManufacture& m_manufacture;
+  TfHashMap<TfToken, fileio::translators::TranslatorRefPtr, TfToken::HashFunctor> m_translatorCache;
 };
 
 
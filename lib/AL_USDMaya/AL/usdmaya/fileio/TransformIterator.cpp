@@ -26,10 +26,11 @@ namespace fileio {
 
 
 //----------------------------------------------------------------------------------------------------------------------
-TransformIterator::TransformIterator(UsdStageRefPtr stage, const MDagPath& parentPath)
+TransformIterator::TransformIterator(UsdStageRefPtr stage, const MDagPath& parentPath, InstanceMode instanceMode)
   : m_primStack(),
     m_stage(stage),
-    m_currentItem(0)
+    m_currentItem(0),
+    m_instanceMode(instanceMode)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TransformIterator::TransformIterator parent path: %s\n", parentPath.fullPathName().asChar());
 
@@ -49,7 +50,11 @@ TransformIterator::TransformIterator(UsdStageRefPtr stage, const MDagPath& paren
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-TransformIterator::TransformIterator(const UsdPrim& usdStartPrim, const MDagPath& mayaStartPath)
+TransformIterator::TransformIterator(const UsdPrim& usdStartPrim, const MDagPath& mayaStartPath, InstanceMode instanceMode)
+  : m_primStack(),
+    m_stage(),
+    m_currentItem(0),
+    m_instanceMode(instanceMode)
 {
   m_primStack.reserve(128);
   m_primStack.push_back(StackRef(usdStartPrim));
@@ -62,14 +67,15 @@ MDagPath TransformIterator::currentPath() const
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TransformIterator::currentPath\n");
   MDagPath p = m_parentPath;
-  for(auto it = m_primStack.begin(); it != m_primStack.end(); ++it)
+
+  // only the deepest valid node in the stack determines the path, so there is no need to build a path for each level
+  for(auto it = m_primStack.rbegin(); it != m_primStack.rend(); ++it)
   {
     if(it->m_object != MObject::kNullObj)
     {
-      {
-        MFnDagNode fn(it->m_object);
-        fn.getPath(p);
-      }
+      MFnDagNode fn(it->m_object);
+      fn.getPath(p);
+      break;
     }
   }
   return p;
@@ -88,8 +94,19 @@ bool TransformIterator::next()
     if(r.m_prim.IsInstance())
     {
       UsdPrim master = r.m_prim.GetMaster();
+      const bool firstVisit = m_visitedMasterPrimPaths.insert(master.GetPath()).second;
+      if(m_instanceMode == kVisitMasterOnce)
+      {
+        m_masterInstances[master.GetPath()].push_back(r.m_prim.GetPath());
+        if(!firstVisit)
+        {
+          // the master has already been walked, so treat this instance as a leaf. Since an instance is never
+          // the master frame itself, there is no need to pop its parent here.
+          m_primStack.pop_back();
+          continue;
+        }
+      }
       m_primStack.push_back(StackRef(master));
-      m_visitedMasterPrimPaths.insert(master.GetPath());
       StackRef& p = *(m_primStack.end() - 2);
       StackRef& c = *(m_primStack.end() - 1);
       c.m_object = p.m_object;
@@ -129,20 +146,13 @@ TransformIterator::StackRef::StackRef(const UsdPrim& prim)
   : m_prim(prim),
     m_object(MObject::kNullObj),
     m_begin(),
-    m_end(),
-    m_currentChild(-1),
-    m_numChildren(0)
+    m_end()
 {
   if(prim)
   {
-    auto begin = prim.GetChildren().begin();
-    m_begin = begin;
-    m_end = prim.GetChildren().end();
-    while(begin != m_end)
-    {
-      m_numChildren++;
-      ++begin;
-    }
+    UsdPrim::SiblingRange children = prim.GetChildren();
+    m_begin = children.begin();
+    m_end = children.end();
   }
   else
   {
@@ -155,9 +165,7 @@ TransformIterator::StackRef::StackRef(const StackRef& prim)
 : m_prim(prim.m_prim),
   m_object(prim.m_object),
   m_begin(prim.m_begin),
-  m_end(prim.m_end),
-  m_currentChild(prim.m_currentChild),
-  m_numChildren(prim.m_numChildren)
+  m_end(prim.m_end)
 {
 }
 
@@ -166,9 +174,7 @@ TransformIterator::StackRef::StackRef()
   : m_prim(),
     m_object(MObject::kNullObj),
     m_begin(),
-    m_end(),
-    m_currentChild(-1),
-    m_numChildren(0)
+    m_end()
 {
 }
 
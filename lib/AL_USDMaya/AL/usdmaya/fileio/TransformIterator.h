@@ -21,6 +21,9 @@
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/prim.h"
 
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/base/tf/hashset.h"
+
 #include <vector>
 #include "AL/usd/utils/ForwardDeclares.h"
 
@@ -38,15 +41,25 @@ class TransformIterator
 {
 public:
 
+  /// \brief  controls how the iterator handles instanced prims
+  enum InstanceMode
+  {
+    kVisitMasterPerInstance, ///< the master subtree is walked again beneath every instance (the default)
+    kVisitMasterOnce ///< the master subtree is walked beneath the first instance found only. Subsequent instances of
+                     ///  the same master are visited as leaves, and recorded in masterInstances()
+  };
+
   /// \brief  ctor. Initialises the iterator to the root of the stage
   /// \param  stage the stage to iterate over
   /// \param  parentPath the DAG path of the proxy shape
-  TransformIterator(UsdStageRefPtr stage, const MDagPath& parentPath = MDagPath());
+  /// \param  instanceMode determines whether instance masters are visited once, or once per instance
+  TransformIterator(UsdStageRefPtr stage, const MDagPath& parentPath = MDagPath(), InstanceMode instanceMode = kVisitMasterPerInstance);
 
   /// \brief  ctor. Initialises the iterator to the root of the stage
   /// \param  startPrim a prim in a stage where the iteration should start
   /// \param  startMayaPath the DAG path of the proxy shape
-  TransformIterator(const UsdPrim& startPrim, const MDagPath& startMayaPath);
+  /// \param  instanceMode determines whether instance masters are visited once, or once per instance
+  TransformIterator(const UsdPrim& startPrim, const MDagPath& startMayaPath, InstanceMode instanceMode = kVisitMasterPerInstance);
 
   /// \brief  return true if the iteration is complete
   /// \return true when the iteration is complete
@@ -106,6 +119,23 @@ public:
   /// \return the maya dag path
   MDagPath currentPath() const;
 
+  /// \brief  returns the instance mode the iterator was constructed with
+  /// \return the instance mode
+  inline InstanceMode instanceMode() const
+    { return m_instanceMode; }
+
+  /// \brief  returns the paths of the instance masters that have been walked so far
+  /// \return the set of master prim paths
+  inline const TfHashSet<SdfPath, SdfPath::Hash>& visitedMasterPrimPaths() const
+    { return m_visitedMasterPrimPaths; }
+
+  /// \brief  when iterating in kVisitMasterOnce mode, this maps each master path to all of the instance prims that
+  ///         have been found referencing it (including the instance the master was first walked under). Once iteration
+  ///         has completed, callers can use this to fan out any results gathered for the master to each instance.
+  /// \return the instance prim paths for each visited master
+  inline const TfHashMap<SdfPath, SdfPathVector, SdfPath::Hash>& masterInstances() const
+    { return m_masterInstances; }
+
 private:
   struct StackRef
   {
@@ -116,16 +146,16 @@ private:
     MObject m_object;
     UsdPrim::SiblingIterator m_begin;
     UsdPrim::SiblingIterator m_end;
-    int32_t m_currentChild;
-    int32_t m_numChildren;
   };
 
   std::vector<StackRef> m_primStack;
   UsdStageRefPtr m_stage;
   size_t m_currentItem;
   MDagPath m_parentPath;
+  InstanceMode m_instanceMode;
 
   TfHashSet<SdfPath, SdfPath::Hash> m_visitedMasterPrimPaths;
+  TfHashMap<SdfPath, SdfPathVector, SdfPath::Hash> m_masterInstances;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -112,6 +112,20 @@ TranslatorManufacture::RefPtr TranslatorManufacture::get(const MObject& mayaObje
 std::vector<TranslatorManufacture::ExtraDataPluginPtr> TranslatorManufacture::getExtraDataPlugins(const MObject& mayaObject)
 {
   std::vector<TranslatorManufacture::ExtraDataPluginPtr> ptrs;
+  if(m_extraDataPlugins.empty())
+  {
+    return ptrs;
+  }
+
+  // the plugins that apply only depend on the node type, so they are only searched for once per type
+  MFnDependencyNode fn(mayaObject);
+  const std::string nodeTypeName = fn.typeName().asChar();
+  auto cached = m_extraDataPluginsByType.find(nodeTypeName);
+  if(cached != m_extraDataPluginsByType.end())
+  {
+    return cached->second;
+  }
+
   for(auto plugin : m_extraDataPlugins)
   {
     MFn::Type type = plugin->getFnType();
@@ -140,8 +154,7 @@ std::vector<TranslatorManufacture::ExtraDataPluginPtr> TranslatorManufacture::ge
       case MFn::kPluginBlendShape:
         {
           const MString typeName = plugin->getPluginTypeName();
-          MFnDependencyNode fn(mayaObject);
-          if(fn.typeName() != typeName)
+          if(nodeTypeName != typeName.asChar())
           {
             continue;
           }
@@ -153,6 +166,7 @@ std::vector<TranslatorManufacture::ExtraDataPluginPtr> TranslatorManufacture::ge
       ptrs.push_back(plugin);
     }
   }
+  m_extraDataPluginsByType.emplace(nodeTypeName, ptrs);
   return ptrs;
 }
 
@@ -27,6 +27,7 @@
 #include "pxr/usd/usd/prim.h"
 
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <functional>
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
@@ -74,6 +75,13 @@ enum class ExportFlag
 ///               values), then you can override this method to simply copy the attributes values from the prim onto the
 ///               existing maya nodes. This is often faster than destroying and recreating the nodes. If you implement
 ///               this method, you must override \b supportsUpdate to return true.
+///           \li \b readPrimData : When many prims are imported (or updated) at once, the data for each chunk of
+///               prims is first read from USD in parallel, and the Maya nodes are then created in serial. If your translator spends
+///               a significant amount of time reading data from USD (e.g. geometry), then you can override this method
+///               to read that data into a PrimData object, which is then handed to \b importPrimData and
+///               \b updatePrimData in place of the prim reads. This method is called from worker threads, so it must
+///               not access Maya, nor modify the stage or translator state. If you implement this method, you must
+///               override \b supportsParallelRead to return true.
 ///
 ///         Do not inherit from this class directly - use the TranslatorBase instead.
 /// \ingroup   translators
@@ -86,6 +94,15 @@ public:
   typedef TfRefPtr<This> RefPtr; ///< the type of a reference this type
   typedef TfWeakPtr<This> Ptr; ///< weak pointer to this type
 
+  /// \brief  The base class of the data a translator reads from a prim in the parallel read phase of an import. Derive
+  ///         from this to hold your own data.
+  struct PrimData
+  {
+    /// \brief  dtor
+    virtual ~PrimData() {}
+  };
+  typedef std::unique_ptr<PrimData> PrimDataPtr; ///< the type of an owned prim data
+
   /// \brief  dtor
   virtual ~TranslatorAbstract() {}
 
@@ -167,6 +184,34 @@ public:
   virtual ExportFlag canExport(const MObject& obj)
     { return ExportFlag::kNotSupported; }
 
+  /// \brief  override this method and return true if the translator implements readPrimData
+  /// \return true if the prim data can be read from USD in parallel, false otherwise.
+  virtual bool supportsParallelRead() const
+    { return false; }
+
+  /// \brief  Override this method to read the data required to import (or update) the prim from USD. This is called
+  ///         concurrently for many prims, so it must not access Maya.
+  /// \param  prim the prim to read
+  /// \return the data read from the prim, or null if there is nothing to read
+  virtual PrimDataPtr readPrimData(const UsdPrim& prim)
+    { return PrimDataPtr(); }
+
+  /// \brief  Imports a prim from the data previously returned by readPrimData. By default this calls import.
+  /// \param  prim the usd prim to be imported into maya
+  /// \param  parent a handle to an MObject that represents an AL_usd_Transform node.
+  /// \param  createdObj a handle to an MObject created in the importing process
+  /// \param  data the data read from the prim by readPrimData (may be null)
+  /// \return MS::kSuccess if all ok
+  virtual MStatus importPrimData(const UsdPrim& prim, MObject& parent, MObject& createdObj, const PrimData* data)
+    { return import(prim, parent, createdObj); }
+
+  /// \brief  Updates a prim from the data previously returned by readPrimData. By default this calls update.
+  /// \param  prim the prim
+  /// \param  data the data read from the prim by readPrimData (may be null)
+  /// \return MS::kSuccess if all ok
+  virtual MStatus updatePrimData(const UsdPrim& prim, const PrimData* data)
+    { return update(prim); }
+
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -277,6 +322,7 @@ public:
 private:
   std::unordered_map<std::string, TranslatorRefPtr> m_translatorsMap;
   std::vector<ExtraDataPluginPtr> m_extraDataPlugins;
+  std::unordered_map<std::string, std::vector<ExtraDataPluginPtr>> m_extraDataPluginsByType; ///< per maya node type
 };
 
 //----------------------------------------------------------------------------------------------------------------------
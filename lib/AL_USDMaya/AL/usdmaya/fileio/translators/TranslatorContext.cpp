@@ -488,6 +488,21 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
   AL_MAYA_CHECK_ERROR2(status, "failed to remove translator prims.");
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::memoryUsage(MemoryUsage& usage) const
+{
+  size_t createdNodes = 0;
+  size_t createdNodesBytes = 0;
+  for(const PrimLookup& lookup : m_primMapping)
+  {
+    createdNodes += lookup.createdNodes().size();
+    createdNodesBytes += vectorBytes(lookup.createdNodes());
+  }
+  usage.push_back(MemoryUsageEntry{"primMappings", m_primMapping.size(), vectorBytes(m_primMapping)});
+  usage.push_back(MemoryUsageEntry{"primMappingCreatedNodes", createdNodes, createdNodesBytes});
+  usage.push_back(MemoryUsageEntry{"excludedGeometry", m_excludedGeometry.size(), treeBytes(m_excludedGeometry)});
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TranslatorContext::preUnloadPrim(UsdPrim& prim, const MObject& primObj)
 {
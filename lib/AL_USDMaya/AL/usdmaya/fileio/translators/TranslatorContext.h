@@ -29,6 +29,7 @@
 #include "pxr/usd/usd/prim.h"
 #include "pxr/base/tf/debug.h"
 #include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/MemoryUsage.h"
 
 #include <vector>
 #include <string>
@@ -267,6 +268,11 @@ public:
   AL_USDMAYA_PUBLIC
   void removeEntries(const SdfPathVector& itemsToRemove);
 
+  /// \brief  appends the element counts and approximate sizes of the prim mappings (and excluded geometry) to usage
+  /// \param  usage the returned memory usage entries
+  AL_USDMAYA_PUBLIC
+  void memoryUsage(MemoryUsage& usage) const;
+
   /// \brief  An internal structure used to store a mapping between an SdfPath, the type of prim found at that location,
   ///         the maya transform that may have been created (assuming the translator plugin specifies that it needs
   ///         a parent transform), and any nodes that the translator plugin may have created.
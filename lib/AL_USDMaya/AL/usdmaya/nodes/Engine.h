@@ -46,6 +46,17 @@ public:
     unsigned int pickResolution,
     PathTranslatorCallback pathTranslator,
     HitBatch *outHit);
+
+  /// \brief  the version of the ProxyShape::combinedSelection() last passed to SetSelected (zero if unknown)
+  uint64_t selectionVersion() const
+    { return m_selectionVersion; }
+
+  /// \brief  records the version of the ProxyShape::combinedSelection() that has been passed to SetSelected
+  void setSelectionVersion(uint64_t version)
+    { m_selectionVersion = version; }
+
+private:
+  uint64_t m_selectionVersion = 0;
 };
 
 }
@@ -118,35 +118,103 @@ LayerManager::~LayerManager()
 {
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the layer is indexed by its own identifier, and by the (optional) extra identifier
+static bool isIndexed(const LayerDatabase::IdToLayerMap& ids, const SdfLayerRefPtr& layer, const std::string& identifier)
+{
+  auto isIndexedBy = [&ids, &layer] (const std::string& id)
+  {
+    auto foundIdAndLayer = ids.find(id);
+    return foundIdAndLayer != ids.end() && foundIdAndLayer->second == layer;
+  };
+  return isIndexedBy(layer->GetIdentifier()) && (identifier.empty() || isIndexedBy(identifier));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerDatabase::ScopedBatch::ScopedBatch(LayerDatabase& database)
+  : m_database(database)
+{
+  std::lock_guard<std::mutex> lock(m_database.m_writeMutex);
+  if(m_database.m_batchDepth++ == 0)
+  {
+    m_database.m_batchIdToLayer = std::make_shared<IdToLayerMap>(*m_database.m_idToLayer);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerDatabase::ScopedBatch::~ScopedBatch()
+{
+  std::lock_guard<std::mutex> lock(m_database.m_writeMutex);
+  if(--m_database.m_batchDepth == 0)
+  {
+    std::atomic_store(&m_database.m_idToLayer, std::shared_ptr<const IdToLayerMap>(std::move(m_database.m_batchIdToLayer)));
+    m_database.m_batchIdToLayer.reset();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<LayerDatabase::IdToLayerMap> LayerDatabase::writableIdToLayer()
+{
+  // readers may still be using the published index, so outside of a batch, modify a copy of it
+  if(m_batchIdToLayer)
+  {
+    return m_batchIdToLayer;
+  }
+  return std::make_shared<IdToLayerMap>(*m_idToLayer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerDatabase::publishIdToLayer(std::shared_ptr<IdToLayerMap>& ids)
+{
+  if(ids != m_batchIdToLayer)
+  {
+    std::atomic_store(&m_idToLayer, std::shared_ptr<const IdToLayerMap>(std::move(ids)));
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool LayerDatabase::addLayer(SdfLayerRefPtr layer, const std::string& identifier)
 {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+
+  // re-adding a known layer is by far the most common case, and does not need a new identifier index. Only writers
+  // replace m_idToLayer, so it can be read directly while the write lock is held.
+  if(isIndexed(m_batchIdToLayer ? *m_batchIdToLayer : *m_idToLayer, layer, identifier))
+  {
+    return false;
+  }
+
   auto insertLayerResult = m_layerToIds.emplace(std::piecewise_construct,
       std::forward_as_tuple(layer),
       std::forward_as_tuple());
   auto& idsForLayer = insertLayerResult.first->second;
 
-  _addLayer(layer, layer->GetIdentifier(), idsForLayer);
-  if (identifier != layer->GetIdentifier() && !identifier.empty())
+  std::shared_ptr<IdToLayerMap> newIds = writableIdToLayer();
+  const std::string& layerIdentifier = layer->GetIdentifier();
+  _addLayer(*newIds, layer, layerIdentifier, idsForLayer);
+  if (identifier != layerIdentifier && !identifier.empty())
   {
-    _addLayer(layer, identifier, idsForLayer);
+    _addLayer(*newIds, layer, identifier, idsForLayer);
   }
+  publishIdToLayer(newIds);
   return insertLayerResult.second;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool LayerDatabase::removeLayer(SdfLayerRefPtr layer)
 {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
   auto foundLayerAndIds = m_layerToIds.find(layer);
   if (foundLayerAndIds == m_layerToIds.end()) return false;
 
+  std::shared_ptr<IdToLayerMap> newIds = writableIdToLayer();
   for (std::string& oldId : foundLayerAndIds->second)
   {
-    auto oldIdPosition = m_idToLayer.find(oldId);
+    auto oldIdPosition = newIds->find(oldId);
 #ifdef DEBUG
-    assert (oldIdPosition != m_idToLayer.end());
+    assert (oldIdPosition != newIds->end());
 #else
-    if (oldIdPosition == m_idToLayer.end())
+    if (oldIdPosition == newIds->end())
     {
       MGlobal::displayError(MString("Error - layer '") + AL::maya::utils::convert(layer->GetIdentifier())
           + "' could be found indexed by layer, but not by identifier '"
@@ -155,17 +223,21 @@ bool LayerDatabase::removeLayer(SdfLayerRefPtr layer)
     else
 #endif // DEBUG
     {
-      m_idToLayer.erase(oldIdPosition);
+      newIds->erase(oldIdPosition);
     }
   }
   m_layerToIds.erase(foundLayerAndIds);
+  publishIdToLayer(newIds);
   return true;
 }
 
-SdfLayerHandle LayerDatabase::findLayer(std::string identifier) const
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerHandle LayerDatabase::findLayer(const std::string& identifier) const
 {
-  auto foundIdAndLayer = m_idToLayer.find(identifier);
-  if(foundIdAndLayer != m_idToLayer.end())
+  // hold on to the snapshot, so that it can't be released by a writer while we are using it
+  const auto ids = idToLayer();
+  auto foundIdAndLayer = ids->find(identifier);
+  if(foundIdAndLayer != ids->end())
   {
     // Non-dirty layers may be placed in the database "temporarily" -
     // ie, current edit targets for proxyShape stages, that have not
@@ -179,13 +251,40 @@ SdfLayerHandle LayerDatabase::findLayer(std::string identifier) const
   return SdfLayerHandle();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool LayerDatabase::hasLayer(const SdfLayerRefPtr& layer, const std::string& identifier) const
+{
+  return isIndexed(*idToLayer(), layer, identifier);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerDatabase::approximateBytes(size_t& layerBytes, size_t& numIdentifiers, size_t& identifierBytes) const
+{
+  layerBytes = hashBytes(m_layerToIds);
+  for(const auto& layerAndIds : m_layerToIds)
+  {
+    layerBytes += vectorBytes(layerAndIds.second);
+    for(const std::string& id : layerAndIds.second)
+    {
+      layerBytes += id.capacity();
+    }
+  }
+
+  const auto ids = idToLayer();
+  numIdentifiers = ids->size();
+  identifierBytes = hashBytes(*ids);
+  for(const auto& idAndLayer : *ids)
+  {
+    identifierBytes += idAndLayer.first.capacity();
+  }
+}
 
 //----------------------------------------------------------------------------------------------------------------------
-void LayerDatabase::_addLayer(SdfLayerRefPtr layer, const std::string& identifier,
+void LayerDatabase::_addLayer(IdToLayerMap& ids, SdfLayerRefPtr layer, const std::string& identifier,
     std::vector<std::string>& idsForLayer)
 {
-  // Try to insert into m_idToLayer...
-  auto insertIdResult = m_idToLayer.emplace(identifier, layer);
+  // Try to insert into ids...
+  auto insertIdResult = ids.emplace(identifier, layer);
   if (!insertIdResult.second)
   {
     // We've seen this identifier before...
@@ -244,7 +343,7 @@ void LayerDatabase::_addLayer(SdfLayerRefPtr layer, const std::string& identifie
     insertIdResult.first->second = layer;
   }
 
-  // Ok, we've now added the layer to m_idToLayer, and cleaned up
+  // Ok, we've now added the layer to ids, and cleaned up
   // any potential old entries from m_layerToIds. Now we just need
   // to add the identifier to idsForLayer (which should be == m_layerToIds[layer])
   idsForLayer.push_back(identifier);
@@ -382,6 +481,11 @@ bool LayerManager::addLayer(SdfLayerHandle layer, const std::string& identifier)
     MGlobal::displayError("LayerManager::addLayer - given layer is no longer valid");
     return false;
   }
+  // avoid taking the write lock when the layer is already known
+  if(m_layerDatabase.hasLayer(layerRef, identifier))
+  {
+    return false;
+  }
   boost::unique_lock<boost::shared_mutex> lock(m_layersMutex);
   return m_layerDatabase.addLayer(layerRef, identifier);
 }
@@ -400,9 +504,8 @@ bool LayerManager::removeLayer(SdfLayerHandle layer)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-SdfLayerHandle LayerManager::findLayer(std::string identifier)
+SdfLayerHandle LayerManager::findLayer(const std::string& identifier) const
 {
-  boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
   return m_layerDatabase.findLayer(identifier);
 }
 
@@ -410,12 +513,63 @@ SdfLayerHandle LayerManager::findLayer(std::string identifier)
 void LayerManager::getLayerIdentifiers(MStringArray& outputNames)
 {
   outputNames.clear();
+  boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
   for(const auto& layerAndIds : m_layerDatabase)
   {
     outputNames.append(layerAndIds.first->GetIdentifier().c_str());
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::getLayers(SdfLayerHandleVector& outputLayers)
+{
+  outputLayers.clear();
+  boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
+  outputLayers.reserve(m_layerDatabase.max_size());
+  for(const auto& layerAndIds : m_layerDatabase)
+  {
+    outputLayers.push_back(layerAndIds.first);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::memoryUsage(MemoryUsage& usage)
+{
+  {
+    boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
+    size_t layerBytes = 0, numIdentifiers = 0, identifierBytes = 0;
+    m_layerDatabase.approximateBytes(layerBytes, numIdentifiers, identifierBytes);
+    usage.push_back(MemoryUsageEntry{"layerManagerLayers", m_layerDatabase.max_size(), layerBytes});
+    usage.push_back(MemoryUsageEntry{"layerManagerIdentifiers", numIdentifiers, identifierBytes});
+  }
+
+  // the serialised layers are only held in the layers attribute around a file save, so this is normally empty
+  size_t numSerialised = 0;
+  size_t serialisedBytes = 0;
+  // read the strings through the data block, which returns them by reference (an MPlug would copy each one)
+  MDataBlock dataBlock = forceCache();
+  MStatus status;
+  MArrayDataHandle layersArrayHandle = dataBlock.outputArrayValue(m_layers, &status);
+  if(status)
+  {
+    for(uint32_t i = 0, n = layersArrayHandle.elementCount(); i < n; ++i, layersArrayHandle.next())
+    {
+      MDataHandle layerHandle = layersArrayHandle.outputValue(&status);
+      if(!status)
+      {
+        break;
+      }
+      const uint32_t length = layerHandle.child(m_serialized).asString().length();
+      if(length)
+      {
+        ++numSerialised;
+        serialisedBytes += length + 1;
+      }
+    }
+  }
+  usage.push_back(MemoryUsageEntry{"layerManagerSerialised", numSerialised, serialisedBytes});
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus LayerManager::populateSerialisationAttributes()
 {
@@ -499,6 +653,9 @@ void LayerManager::loadAllLayers()
   // We DON'T want to use evaluate num elements, because we don't want to trigger
   // a compute - we want the value(s) as read from the file!
   const unsigned int numElements = allLayersPlug.numElements();
+
+  // publish the identifier index once all of the layers have been added, rather than copying it for each layer
+  LayerDatabase::ScopedBatch batch(m_layerDatabase);
   for(unsigned int i=0; i < numElements; ++i)
   {
     singleLayerPlug = allLayersPlug.elementByPhysicalIndex(i, &status);
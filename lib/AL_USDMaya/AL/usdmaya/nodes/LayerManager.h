@@ -18,6 +18,7 @@
 #include "../Api.h"
 
 #include "AL/maya/utils/NodeHelper.h"
+#include "AL/usdmaya/MemoryUsage.h"
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/stage.h"
 
@@ -27,7 +28,10 @@
 
 #include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <boost/thread.hpp>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -132,13 +136,45 @@ private:
 ///         We allow adding non-dirty items because if we want to guarantee we always have all the latest
 ///         items, we need to deal with the situation where the current edit target starts out not
 ///         dirty... and it's easiest to just add it then filter it if it's not dirty
+///
+///         The identifier index is an immutable snapshot that is replaced whenever it is modified, so findLayer and
+///         hasLayer may be called from any thread without taking a lock, even while another thread is adding or
+///         removing layers. Writers copy the index, modify the copy, and publish it under an internal write lock. To
+///         add or remove many layers, hold a ScopedBatch, so that the index is copied and published only once.
+///         Iterating over the layers while another thread modifies the database still needs a lock held by the caller.
 /// \ingroup nodes
 //----------------------------------------------------------------------------------------------------------------------
 class LayerDatabase
 {
+  struct LayerHash
+  {
+    size_t operator () (const SdfLayerRefPtr& layer) const
+      { return std::hash<const SdfLayer*>()(get_pointer(layer)); }
+  };
 public:
-  typedef std::map<SdfLayerRefPtr, std::vector<std::string>> LayerToIdsMap;
-  typedef std::map<std::string, SdfLayerRefPtr> IdToLayerMap;
+  typedef std::unordered_map<SdfLayerRefPtr, std::vector<std::string>, LayerHash> LayerToIdsMap;
+  typedef std::unordered_map<std::string, SdfLayerRefPtr> IdToLayerMap;
+
+  /// \brief  ctor
+  LayerDatabase()
+    : m_idToLayer(std::make_shared<IdToLayerMap>()) {}
+
+  /// \brief  While a ScopedBatch exists, changes to the identifier index are made to a single private copy of it,
+  ///         which is published when the batch is destroyed. Lookups made from other threads during the batch see
+  ///         the index as it was before the batch started.
+  class ScopedBatch
+  {
+  public:
+    /// \brief  ctor
+    /// \param  database the database to modify
+    explicit ScopedBatch(LayerDatabase& database);
+
+    /// \brief  dtor, publishes the modified identifier index
+    ~ScopedBatch();
+
+  private:
+    LayerDatabase& m_database;
+  };
 
   /// \brief  Add the given layer to the set of layers in this LayerDatabase, if not already present,
   ///         and optionally add an extra identifier as a key to it
@@ -163,7 +199,13 @@ public:
   /// \brief  Find the layer in the set of layers managed by this node, by identifier
   /// \param  identifier the identifier the full identifier of the layer to locate
   /// \return The found layer handle in the layer list managed by this node (invalid if not found or not dirty)
-  SdfLayerHandle findLayer(std::string identifier) const;
+  SdfLayerHandle findLayer(const std::string& identifier) const;
+
+  /// \brief  Returns true if the layer is indexed by its own identifier, and by the (optional) extra identifier.
+  ///         If this returns true, addLayer with the same arguments will not modify the database.
+  /// \param  layer the layer to test
+  /// \param  identifier an extra identifier to test (ignored if empty)
+  bool hasLayer(const SdfLayerRefPtr& layer, const std::string& identifier = std::string()) const;
 
   /// Because we may have an unknown number of non-dirty member layers which we're treating
   /// as not-existing, we can't get a size without iterating over all the layers; we can,
@@ -179,6 +221,12 @@ public:
   operator _UnspecifiedBoolType() const
     { return begin() == end() ? &LayerDatabase::m_layerToIds : nullptr; }
 
+  /// \brief  Returns the approximate number of bytes used by the database (not including the layers themselves)
+  /// \param  layerBytes the returned size of the layer to identifiers table
+  /// \param  numIdentifiers the returned number of identifiers the layers are indexed by
+  /// \param  identifierBytes the returned size of the identifier to layer index
+  void approximateBytes(size_t& layerBytes, size_t& numIdentifiers, size_t& identifierBytes) const;
+
   /// \brief  Upper bound for the number of non-dirty layers in this object
   ///         This is the count of all tracked layers, dirty-and-non-dirty;
   ///         If it is zero, it can be guaranteed that there are no dirty
@@ -217,11 +265,24 @@ public:
     { return const_iterator(m_layerToIds.cend(), m_layerToIds.cend()); }
 
 private:
-  void _addLayer(SdfLayerRefPtr layer, const std::string& identifier,
+  void _addLayer(IdToLayerMap& ids, SdfLayerRefPtr layer, const std::string& identifier,
       std::vector<std::string>& idsForLayer);
 
+  std::shared_ptr<const IdToLayerMap> idToLayer() const
+    { return std::atomic_load(&m_idToLayer); }
+
+  /// returns the index to modify, which is the batch copy if a batch is in progress, or a new copy otherwise.
+  /// The caller must hold m_writeMutex.
+  std::shared_ptr<IdToLayerMap> writableIdToLayer();
+
+  /// publishes the modified index, unless a batch is in progress. The caller must hold m_writeMutex.
+  void publishIdToLayer(std::shared_ptr<IdToLayerMap>& ids);
+
   LayerToIdsMap m_layerToIds;
-  IdToLayerMap m_idToLayer;
+  std::shared_ptr<const IdToLayerMap> m_idToLayer;
+  std::shared_ptr<IdToLayerMap> m_batchIdToLayer; ///< the index being modified by the current ScopedBatch (if any)
+  uint32_t m_batchDepth = 0;
+  std::mutex m_writeMutex; ///< serialises the copy and publish of the identifier index
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -294,10 +355,11 @@ public:
   AL_USDMAYA_PUBLIC
   bool removeLayer(SdfLayerHandle layer);
 
-  /// \brief  Find the layer in the list of layers managed by this node, by identifier
+  /// \brief  Find the layer in the list of layers managed by this node, by identifier. This does not lock the
+  ///         layer manager, so may be called freely from multiple threads.
   /// \return The found layer handle in the layer list managed by this node (invalid if not found)
   AL_USDMAYA_PUBLIC
-  SdfLayerHandle findLayer(std::string identifier);
+  SdfLayerHandle findLayer(const std::string& identifier) const;
 
   /// \brief  Store a list of the managed layers' identifiers in the given MStringArray
   /// \param  outputNames The array to hold the identifier names; will be cleared before being filled.
@@ -305,6 +367,18 @@ public:
   AL_USDMAYA_PUBLIC
   void getLayerIdentifiers(MStringArray& outputNames);
 
+  /// \brief  Store the managed (dirty) layers in the given vector
+  /// \param  outputLayers The array to hold the layers; will be cleared before being filled. The layers are returned
+  ///         in the same order as the identifiers returned from getLayerIdentifiers.
+  AL_USDMAYA_PUBLIC
+  void getLayers(SdfLayerHandleVector& outputLayers);
+
+  /// \brief  Appends the number of tracked layers and identifiers, and the size of any serialised layer strings
+  ///         currently held in the layers attribute, to usage.
+  /// \param  usage the returned memory usage entries
+  AL_USDMAYA_PUBLIC
+  void memoryUsage(MemoryUsage& usage);
+
   /// \brief  Ensures that the layers attribute will be filled out with serialized versions of all tracked layers.
   AL_USDMAYA_PUBLIC
   MStatus populateSerialisationAttributes();
@@ -356,6 +430,7 @@ private:
   // I don't know that layerManager will be used in a multihreaded manenr... but I also don't know it COULDN'T be.
   // (I haven't really looked into the way maya's new multi-threaded node evaluation works, for instance.) This is
   // essentially a globally shared resource, so I figured better be safe...
+  // findLayer does not need the mutex, as the layer database publishes its identifier index as a snapshot.
   boost::shared_mutex m_layersMutex;
 
   //--------------------------------------------------------------------------------------------------------------------
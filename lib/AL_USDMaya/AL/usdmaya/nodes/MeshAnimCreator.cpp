@@ -21,6 +21,8 @@
 #include "AL/usdmaya/utils/Utils.h"
 #include "AL/usdmaya/utils/MeshUtils.h"
 
+#include "maya/MFloatPointArray.h"
+#include "maya/MFnMesh.h"
 #include "maya/MFnMeshData.h"
 #include "pxr/usd/usdGeom/mesh.h"
 
@@ -82,21 +84,187 @@ MStatus MeshAnimCreator::compute(const MPlug& plug, MDataBlock& data)
   {
     UsdPrim prim = stage->GetPrimAtPath(m_cachePath);
     UsdGeomMesh mesh(prim);
-    
-    MFnMeshData fnData;
-    MObject obj = fnData.create();
-
-    utils::MeshImportContext context(mesh, obj, MString(), usdTime);
-    context.applyHoleFaces();
-    context.applyVertexNormals();
-    context.applyEdgeCreases();
-    context.applyVertexCreases();
-    context.applyPrimVars();
-    outputHandle.set(obj);
+
+    // the weak pointer expires with the stage, so a new stage allocated at the same address is still detected
+    if(!m_queriedStage || m_queriedStage != stage)
+    {
+      TfNotice::Revoke(m_objectsChangedNoticeKey);
+      m_queriedStage = stage;
+      m_objectsChangedNoticeKey = TfNotice::Register(TfCreateWeakPtr(this), &MeshAnimCreator::onObjectsChanged,
+                                                     m_queriedStage);
+      m_animationDirty = true;
+    }
+
+    if(m_animationDirty)
+    {
+      queryTimeVaryingAttributes(mesh);
+      m_meshData = MObject::kNullObj;
+      m_animationDirty = false;
+    }
+
+    MObject outData;
+    if(m_meshData.isNull() || m_rebuildEachFrame || !updateAnimatedArrays(mesh, usdTime, outData))
+    {
+      buildMesh(mesh, usdTime);
+      outData = m_meshData;
+    }
+    outputHandle.set(outData);
   }
   return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimCreator::queryTimeVaryingAttributes(const UsdGeomMesh& mesh)
+{
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimCreator::queryTimeVaryingAttributes %s\n", m_cachePath.GetText());
+
+  auto isVarying = [](const UsdAttribute& attr) { return attr.GetNumTimeSamples() > 1; };
+
+  // any change to the mesh topology (or to data that is stored against it) requires the mesh to be re-created
+  m_rebuildEachFrame = isVarying(mesh.GetFaceVertexCountsAttr()) ||
+                       isVarying(mesh.GetFaceVertexIndicesAttr()) ||
+                       isVarying(mesh.GetHoleIndicesAttr()) ||
+                       isVarying(mesh.GetCornerIndicesAttr()) ||
+                       isVarying(mesh.GetCornerSharpnessesAttr()) ||
+                       isVarying(mesh.GetCreaseIndicesAttr()) ||
+                       isVarying(mesh.GetCreaseLengthsAttr()) ||
+                       isVarying(mesh.GetCreaseSharpnessesAttr()) ||
+                       isVarying(mesh.GetOrientationAttr());
+
+  // uv and colour sets are not updated in place
+  if(!m_rebuildEachFrame)
+  {
+    for(const UsdGeomPrimvar& primvar : mesh.GetPrimvars())
+    {
+      if(primvar.ValueMightBeTimeVarying())
+      {
+        m_rebuildEachFrame = true;
+        break;
+      }
+    }
+  }
+
+  UsdAttribute normals = mesh.GetNormalsAttr();
+  m_pointsVarying = isVarying(mesh.GetPointsAttr());
+  m_normalsVarying = isVarying(normals);
+
+  if(normals.HasAuthoredValueOpinion())
+  {
+    // only per face-vertex normals can be written directly, everything else is expanded when the mesh is built
+    const TfToken interpolation = mesh.GetNormalsInterpolation();
+    if(m_normalsVarying && interpolation != UsdGeomTokens->faceVarying && interpolation != UsdGeomTokens->varying)
+    {
+      m_rebuildEachFrame = true;
+    }
+  }
+  else
+  if(m_pointsVarying)
+  {
+    // the normals of a left handed mesh are computed from its points
+    TfToken orientation;
+    if(mesh.GetOrientationAttr().Get(&orientation) && orientation == UsdGeomTokens->leftHanded)
+    {
+      m_rebuildEachFrame = true;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimCreator::buildMesh(const UsdGeomMesh& mesh, UsdTimeCode usdTime)
+{
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimCreator::buildMesh %s\n", m_cachePath.GetText());
+
+  MFnMeshData fnData;
+  m_meshData = fnData.create();
+
+  utils::MeshImportContext context(mesh, m_meshData, MString(), usdTime);
+  context.applyHoleFaces();
+  context.applyVertexNormals();
+  context.applyEdgeCreases();
+  context.applyVertexCreases();
+  context.applyPrimVars();
+
+  // cache the face-vertex layout needed to update the normals on subsequent frames
+  m_normalFaceIds.clear();
+  m_normalVertexIds.clear();
+  if(m_normalsVarying && !m_rebuildEachFrame)
+  {
+    MFnMesh& fnMesh = context.getFn();
+    MIntArray counts;
+    fnMesh.getVertices(counts, m_normalVertexIds);
+    m_normalFaceIds.setLength(m_normalVertexIds.length());
+    for(uint32_t i = 0, k = 0, n = counts.length(); i < n; ++i)
+    {
+      for(int32_t j = 0; j < counts[i]; ++j, ++k)
+      {
+        m_normalFaceIds[k] = i;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshAnimCreator::updateAnimatedArrays(const UsdGeomMesh& mesh, UsdTimeCode usdTime, MObject& outData)
+{
+  // The cached mesh has already been handed to the DG, so it must not be modified in place. Copying it is still much
+  // cheaper than rebuilding the topology, creases and primvars from USD.
+  MStatus status;
+  MFnMeshData fnData;
+  outData = fnData.create();
+  MFnMesh fnMesh;
+  fnMesh.copy(m_meshData, outData, &status);
+  if(!status)
+  {
+    return false;
+  }
+
+  if(m_pointsVarying)
+  {
+    VtArray<GfVec3f> pointData;
+    mesh.GetPointsAttr().Get(&pointData, usdTime);
+    if(pointData.size() != size_t(fnMesh.numVertices()))
+    {
+      return false;
+    }
+
+    // setPoints (unlike writing through getRawPoints) also updates the bounds of the mesh
+    MFloatPointArray points;
+    points.setLength(pointData.size());
+    for(uint32_t i = 0, n = pointData.size(); i < n; ++i)
+    {
+      points[i] = MFloatPoint(pointData[i][0], pointData[i][1], pointData[i][2]);
+    }
+    if(fnMesh.setPoints(points, MSpace::kObject) != MS::kSuccess)
+    {
+      return false;
+    }
+  }
+
+  if(m_normalsVarying)
+  {
+    VtArray<GfVec3f> normalData;
+    mesh.GetNormalsAttr().Get(&normalData, usdTime);
+    if(normalData.empty() || normalData.size() != m_normalVertexIds.length())
+    {
+      return false;
+    }
+
+    MVectorArray normals;
+    normals.setLength(normalData.size());
+    double* const optr = &normals[0].x;
+    const float* const iptr = (const float*)normalData.cdata();
+    for(size_t i = 0, n = normalData.size() * 3; i < n; ++i)
+    {
+      optr[i] = iptr[i];
+    }
+    if(fnMesh.setFaceVertexNormals(normals, m_normalFaceIds, m_normalVertexIds, MSpace::kObject) != MS::kSuccess)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimCreator::connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc)
 {
@@ -107,6 +275,7 @@ MStatus MeshAnimCreator::connectionMade(const MPlug& plug, const MPlug& otherPlu
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
       proxyShapeHandle = otherPlug.node();
+      m_animationDirty = true;
     }
   }
   return MPxNode::connectionMade(plug, otherPlug, asSrc);
@@ -122,6 +291,7 @@ MStatus MeshAnimCreator::connectionBroken(const MPlug& plug, const MPlug& otherP
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
       proxyShapeHandle = MObject();
+      m_animationDirty = true;
     }
   }
   return MPxNode::connectionBroken(plug, otherPlug, asSrc);
@@ -167,6 +337,34 @@ void MeshAnimCreator::onAttributeChanged(MNodeMessage::AttributeMessage msg, MPl
       {
         deformer->m_cachePath = SdfPath(AL::maya::utils::convert(primPathStr));
       }
+      deformer->m_animationDirty = true;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimCreator::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
+{
+  if(!sender || sender != m_queriedStage || m_animationDirty)
+    return;
+
+  // a resync of the prim (or one of its ancestors), or an edit to any of its attributes, may change the topology or
+  // which attributes are animated, so the cached mesh can no longer be reused
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    if(m_cachePath.HasPrefix(path.GetPrimPath()))
+    {
+      m_animationDirty = true;
+      return;
+    }
+  }
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    if(path.GetPrimPath() == m_cachePath)
+    {
+      TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimCreator::onObjectsChanged %s\n", path.GetText());
+      m_animationDirty = true;
+      return;
     }
   }
 }
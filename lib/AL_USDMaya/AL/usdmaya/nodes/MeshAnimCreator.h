@@ -19,10 +19,13 @@
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/usdmaya/utils/ForwardDeclares.h"
 #include "pxr/pxr.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
 #include "maya/MPxNode.h"
 #include "maya/MNodeMessage.h"
 #include "maya/MObjectHandle.h"
+#include "maya/MIntArray.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -32,12 +35,15 @@ namespace nodes {
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The MeshAnimCreator node acts as a polyCreator node within the DG that is driven by time. When the time
-///         changes, 
+///         changes, the output mesh is updated from the UsdGeomMesh at the new time. The attributes that are animated
+///         are determined once (when the prim path or stage changes), and if the topology of the mesh is static, the
+///         output mesh is re-used, and only the animated points and normals are updated each frame.
 /// \ingroup nodes
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimCreator
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
@@ -47,7 +53,10 @@ public:
      {}
 
   inline ~MeshAnimCreator()
-    { MNodeMessage::removeCallback(m_attributeChanged); }
+    {
+      MNodeMessage::removeCallback(m_attributeChanged);
+      TfNotice::Revoke(m_objectsChangedNoticeKey);
+    }
 
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
@@ -68,12 +77,28 @@ private:
   MStatus connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   MStatus connectionBroken(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   static void onAttributeChanged(MNodeMessage::AttributeMessage, MPlug&, MPlug&, void*);
+  void onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender);
   MStatus compute(const MPlug& plug, MDataBlock& data) override;
   UsdStageRefPtr getStage();
+  void queryTimeVaryingAttributes(const UsdGeomMesh& mesh);
+  void buildMesh(const UsdGeomMesh& mesh, UsdTimeCode usdTime);
+  bool updateAnimatedArrays(const UsdGeomMesh& mesh, UsdTimeCode usdTime, MObject& outData);
 private:
   SdfPath m_cachePath;
   MObjectHandle proxyShapeHandle;
   MCallbackId m_attributeChanged = 0;
+
+  // the mesh data last built from USD (never modified once output, each updated frame is written to a copy of it), and
+  // the face ids / vertex ids used to update its normals
+  MObject m_meshData;
+  MIntArray m_normalFaceIds;
+  MIntArray m_normalVertexIds;
+  UsdStageWeakPtr m_queriedStage;
+  TfNotice::Key m_objectsChangedNoticeKey;
+  bool m_animationDirty = true;
+  bool m_rebuildEachFrame = false;
+  bool m_pointsVarying = false;
+  bool m_normalsVarying = false;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
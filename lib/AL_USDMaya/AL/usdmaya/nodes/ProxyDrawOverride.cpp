@@ -387,14 +387,14 @@ void ProxyDrawOverride::draw(const MHWRender::MDrawContext& context, const MUser
     ptr->m_engine->SetRootTransform(GfMatrix4d(ptr->m_objPath.inclusiveMatrix().matrix));
 
     auto view = M3dView::active3dView();
-    const auto& paths1 = ptr->m_shape->selectedPaths();
-    const auto& paths2 = ptr->m_shape->selectionList().paths();
-    SdfPathVector combined;
-    combined.reserve(paths1.size() + paths2.size());
-    combined.insert(combined.end(), paths1.begin(), paths1.end());
-    combined.insert(combined.end(), paths2.begin(), paths2.end());
-
-    ptr->m_engine->SetSelected(combined);
+    // only resubmit the selection to the engine when it has actually changed
+    const auto& selection = ptr->m_shape->combinedSelection();
+    const auto& combined = selection.paths();
+    if(ptr->m_engine->selectionVersion() != selection.version())
+    {
+      ptr->m_engine->SetSelected(combined);
+      ptr->m_engine->setSelectionVersion(selection.version());
+    }
     ptr->m_engine->SetSelectionColor(GfVec4f(1.0f, 2.0f/3.0f, 0.0f, 1.0f));
 
     ptr->m_params.frame = ptr->m_shape->outTimePlug().asMTime().as(MTime::uiUnit());
@@ -416,6 +416,13 @@ SdfPathVector ProxyShape::getPrimPathsFromCommaJoinedString(const MString &paths
   return result;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShape::switchRendererPlugin(const TfToken& plugin)
+{
+  TF_DEBUG(ALUSDMAYA_RENDERER).Msg("ProxyShape::switchRendererPlugin %s\n", plugin.GetText());
+  return m_engine && m_engine->SetRendererPlugin(plugin);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::constructGLImagingEngine()
 {
@@ -448,11 +455,13 @@ void ProxyShape::constructGLImagingEngine()
                                    translatedGeo.end());
 
       m_engine = new Engine(m_path, excludedGeometryPaths);
+      renderEngineCreated();
+
       // set renderer plugin based on RendererManager setting
       RendererManager* manager = RendererManager::findManager();
       if(manager && m_engine)
       {
-        manager->changeRendererPlugin(this, true);
+        manager->changeRendererPlugin(this);
       }
 
       triggerEvent("ConstructGLEngine");
@@ -675,8 +684,7 @@ ProxyShape::ProxyShape()
   };
 
   m_findLockedPrims.preIteration = [this]() {
-    this->m_lockTransformPrims.clear();
-    this->m_lockInheritedPrims.clear();
+    this->m_lockPrimIndex.beginRebuild();
   };
   m_findLockedPrims.iteration = [this] ( const fileio::TransformIterator& transformIterator,
                                          const UsdPrim& prim)
@@ -686,20 +694,21 @@ ProxyShape::ProxyShape()
     {
       if (lockPropertyToken == Metadata::lockTransform)
       {
-        this->m_lockTransformPrims.insert(prim.GetPath());
+        this->m_lockPrimIndex.setState(prim.GetPath(), LockPrimIndex::kLockTransform);
       }
       else if (lockPropertyToken == Metadata::lockInherited)
       {
-        this->m_lockInheritedPrims.insert(prim.GetPath());
+        this->m_lockPrimIndex.setState(prim.GetPath(), LockPrimIndex::kLockInherited);
       }
     }
     else
     {
-      this->m_lockInheritedPrims.insert(prim.GetPath());
+      this->m_lockPrimIndex.setState(prim.GetPath(), LockPrimIndex::kLockInherited);
     }
 
   };
   m_findLockedPrims.postIteration = [this]() {
+    this->m_lockPrimIndex.endRebuild();
     constructLockPrims();
   };
 
@@ -1025,12 +1034,19 @@ void ProxyShape::serializeAll()
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
 {
-  if(MFileIO::isReadingFile())
-    return;
-
   if (!sender || sender != m_stage)
       return;
 
+  // any resync may have added or removed sublayers and references. This must be recorded even while a file is being
+  // read, otherwise the layer graph cached before the read would still be used afterwards.
+  if(!notice.GetResyncedPaths().empty())
+  {
+    m_layerGraphDirty = true;
+  }
+
+  if(MFileIO::isReadingFile())
+    return;
+
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onObjectsChanged called m_compositionHasChanged=%i\n", m_compositionHasChanged);
 
   // These paths are subtree-roots representing entire subtrees that may have
@@ -1265,6 +1281,18 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+const proxy::LayerGraph& ProxyShape::layerGraph()
+{
+  if(m_layerGraphDirty)
+  {
+    TF_DEBUG(ALUSDMAYA_LAYERS).Msg("ProxyShape::layerGraph rebuilding\n");
+    m_layerGraph.build(m_stage);
+    m_layerGraphDirty = false;
+  }
+  return m_layerGraph;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::loadStage()
 {
@@ -1280,6 +1308,7 @@ void ProxyShape::loadStage()
     trackEditTargetLayer();
   }
   m_stage = UsdStageRefPtr();
+  m_layerGraphDirty = true;
 
   // Get input attr values
   const MString file = inputStringValue(dataBlock, m_filePath);
@@ -1463,24 +1492,15 @@ bool ProxyShape::updateLockPrims(const SdfPathSet& lockTransformPrims, const Sdf
   bool lockChanged = false;
   for (auto lock : lockTransformPrims)
   {
-    auto inserted = m_lockTransformPrims.insert(lock);
-    lockChanged = lockChanged || inserted.second;
-    auto erased = m_lockInheritedPrims.erase(lock);
-    lockChanged = lockChanged || erased;
+    lockChanged = m_lockPrimIndex.setState(lock, LockPrimIndex::kLockTransform) || lockChanged;
   }
   for (auto inherited : lockInheritedPrims)
   {
-    auto erased = m_lockTransformPrims.erase(inherited);
-    lockChanged = lockChanged || erased;
-    auto inserted = m_lockInheritedPrims.insert(inherited);
-    lockChanged = lockChanged || inserted.second;
+    lockChanged = m_lockPrimIndex.setState(inherited, LockPrimIndex::kLockInherited) || lockChanged;
   }
   for (auto unlocked : unlockedPrims)
   {
-    auto erased = m_lockTransformPrims.erase(unlocked);
-    lockChanged = lockChanged || erased;
-    erased = m_lockInheritedPrims.erase(unlocked);
-    lockChanged = lockChanged || erased;
+    lockChanged = m_lockPrimIndex.remove(unlocked) || lockChanged;
   }
   return lockChanged;
 }
@@ -1497,107 +1517,126 @@ void ProxyShape::constructExcludedPrims()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool ProxyShape::lockTransformAttribute(const SdfPath& path, const bool lock)
+MObject ProxyShape::findLockableTransform(const SdfPath& path) const
 {
-  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::lockTransformAttribute\n");
-
-  UsdPrim prim = m_stage->GetPrimAtPath(path);
-  if(!prim.IsValid())
+  // The transform references hold the nodes created for the prim chains, so try those first
+  auto required = m_requiredPaths.find(path);
+  if(required != m_requiredPaths.end())
   {
-    TF_DEBUG_MSG(ALUSDMAYA_EVALUATION,"ProxyShape::lockTransformAttribute prim path not valid '%s'\n", prim.GetPath().GetString().c_str());
-    return false;
+    MObject node = required->second.node();
+    MObjectHandle handle(node);
+    if(handle.isAlive() && handle.isValid() && node.hasFn(MFn::kTransform))
+    {
+      return node;
+    }
   }
 
-  MObject lockObject;
-  MString pathStr = getMayaPathFromUsdPrim(prim);
-  if (pathStr.length())
+  // then the nodes recorded when the maya paths were generated
+  auto recorded = m_primPathToNode.find(path);
+  if(recorded != m_primPathToNode.end())
   {
-    MSelectionList sl;
-    MObject selObj;
-    if (sl.add(pathStr) == MStatus::kSuccess)
-    {
-      sl.getDependNode(0, selObj);
-    }
-    if (selObj.hasFn(MFn::kTransform))
+    if(recorded->second.isAlive() && recorded->second.isValid() && recorded->second.object().hasFn(MFn::kTransform))
     {
-      lockObject = selObj;
+      return recorded->second.object();
     }
   }
-  else
+
+  // and finally the nodes created by the translators
+  std::vector<MObjectHandle> objHdls;
+  m_context->getMObjects(path, objHdls);
+  for (auto objHdl : objHdls)
   {
-    std::vector<MObjectHandle> objHdls;
-    context()->getMObjects(path, objHdls);
-    for (auto objHdl : objHdls)
+    if (objHdl.isValid() && objHdl.object().hasFn(MFn::kTransform))
     {
-      if (objHdl.isValid() && objHdl.object().hasFn(MFn::kTransform))
-      {
-        lockObject = objHdl.object();
-        break;
-      }
+      return objHdl.object();
     }
   }
+  return MObject::kNullObj;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::lockTransformAttributes(const SdfPathVector& paths, const bool lock, SdfPathVector& applied)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::lockTransformAttributes %s %zu prims\n", lock ? "locking" : "unlocking", paths.size());
 
-  if (lockObject.isNull())
-    return false;
+  applied.clear();
+  applied.reserve(paths.size());
 
+  // the pushToPrim changes for all of the transforms are applied together once all of the plugs are locked
+  MDGModifier pushToPrimModifier;
+  bool hasPushToPrimChanges = false;
+  for (const SdfPath& path : paths)
+  {
+    MObject lockObject = findLockableTransform(path);
+    if (lockObject.isNull())
+      continue;
 
-  MPlug t(lockObject, m_transformTranslate);
-  MPlug r(lockObject, m_transformRotate);
-  MPlug s(lockObject, m_transformScale);
+    MPlug(lockObject, m_transformTranslate).setLocked(lock);
+    MPlug(lockObject, m_transformRotate).setLocked(lock);
+    MPlug(lockObject, m_transformScale).setLocked(lock);
 
-  t.setLocked(lock);
-  r.setLocked(lock);
-  s.setLocked(lock);
+    if (lock && MFnDependencyNode(lockObject).typeId() == AL_USDMAYA_TRANSFORM)
+    {
+      pushToPrimModifier.newPlugValueBool(MPlug(lockObject, Transform::pushToPrim()), false);
+      hasPushToPrimChanges = true;
+    }
+    TF_DEBUG_MSG(ALUSDMAYA_EVALUATION, "ProxyShape::lockTransformAttributes Setting lock for '%s'\n", path.GetText());
+    applied.push_back(path);
+  }
 
-  if (lock && MFnDependencyNode(lockObject).typeId() == AL_USDMAYA_TRANSFORM)
+  if (hasPushToPrimChanges)
   {
-    MPlug(lockObject, Transform::pushToPrim()).setBool(false);
+    pushToPrimModifier.doIt();
   }
-  TF_DEBUG_MSG(ALUSDMAYA_EVALUATION,"ProxyShape::lockTransformAttribute Setting lock for '%s'\n", prim.GetPath().GetString().c_str());
-  return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::constructLockPrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims\n");
-  SdfPathSet primsNeedLock = m_lockTransformPrims;
 
-  // add inherited lock prims if their parents are already in.
-  for (auto inherited : m_lockInheritedPrims)
+  // only the prims whose resolved lock has changed need to be visited
+  SdfPathVector changedPaths;
+  m_lockPrimIndex.takeChangedPaths(changedPaths);
+  SdfPathVector primsToUnlock;
+  for (const SdfPath& path : changedPaths)
   {
-    const SdfPath parentPath = inherited.GetParentPath();
-    if (parentPath.IsEmpty())
-      continue;
-    auto parentIter = primsNeedLock.find(parentPath);
-    if (parentIter != primsNeedLock.end())
+    if (m_lockPrimIndex.isLocked(path))
+    {
+      if (m_currentLockedPrims.find(path) == m_currentLockedPrims.end())
+      {
+        m_pendingLockPrims.insert(path);
+      }
+    }
+    else
     {
-      auto lowerIter = std::lower_bound(parentIter, primsNeedLock.end(), inherited);
-      primsNeedLock.insert(lowerIter, inherited);
+      m_pendingLockPrims.erase(path);
+      if (m_currentLockedPrims.find(path) != m_currentLockedPrims.end())
+      {
+        primsToUnlock.push_back(path);
+      }
     }
   }
 
-  SdfPathVector primsToLock;
-  primsToLock.reserve(primsNeedLock.size());
-  SdfPathVector primsToUnlock;
-  primsToUnlock.reserve(m_currentLockedPrims.size());
-  std::set_difference(primsNeedLock.begin(), primsNeedLock.end(), m_currentLockedPrims.begin(),
-                      m_currentLockedPrims.end(), std::back_inserter(primsToLock));
-  std::set_difference(m_currentLockedPrims.begin(), m_currentLockedPrims.end(), primsNeedLock.begin(),
-                      primsNeedLock.end(), std::back_inserter(primsToUnlock));
-
-  for (auto lock : primsToLock)
+  SdfPathVector applied;
+  if (!primsToUnlock.empty())
   {
-    if (lockTransformAttribute(lock, true))
+    lockTransformAttributes(primsToUnlock, false, applied);
+    for (const SdfPath& path : applied)
     {
-      m_currentLockedPrims.insert(lock);
+      m_currentLockedPrims.erase(path);
     }
   }
-  for (auto unlock : primsToUnlock)
+
+  // prims that need a lock, but have not had one applied, are retried as a maya transform may have since been created
+  if (!m_pendingLockPrims.empty())
   {
-    if (lockTransformAttribute(unlock, false))
+    SdfPathVector primsToLock(m_pendingLockPrims.begin(), m_pendingLockPrims.end());
+    lockTransformAttributes(primsToLock, true, applied);
+    for (const SdfPath& path : applied)
     {
-      m_currentLockedPrims.erase(unlock);
+      m_currentLockedPrims.insert(path);
+      m_pendingLockPrims.erase(path);
     }
   }
 }
@@ -1723,6 +1762,7 @@ MString ProxyShape::recordUsdPrimToMayaPath(const UsdPrim &usdPrim,
   SdfPath primPath(usdPrim.GetPath());
   resultingPath = AL::usdmaya::utils::mapUsdPrimToMayaNode(usdPrim, mayaObject, &mayaPath);
   m_primPathToDagPath.emplace(primPath, resultingPath);
+  m_primPathToNode[primPath] = MObjectHandle(mayaObject);
 
   return resultingPath;
 }
@@ -1756,7 +1796,7 @@ void ProxyShape::findTaggedPrims(const HierarchyIterationLogics& iterationLogics
   }
 
   MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+  for(fileio::TransformIterator it(m_stage, m_parentPath, fileio::TransformIterator::kVisitMasterOnce); !it.done(); it.next())
   {
     const UsdPrim& prim = it.prim();
     if(!prim.IsValid())
@@ -1784,7 +1824,7 @@ void ProxyShape::findExcludedGeometry()
   m_findExcludedPrims.preIteration();
   MDagPath m_parentPath;
 
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+  for(fileio::TransformIterator it(m_stage, m_parentPath, fileio::TransformIterator::kVisitMasterOnce); !it.done(); it.next())
   {
     const UsdPrim& prim = it.prim();
     if(!prim.IsValid())
@@ -1805,7 +1845,7 @@ void ProxyShape::findSelectablePrims()
   m_findUnselectablePrims.preIteration();
 
   MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+  for(fileio::TransformIterator it(m_stage, m_parentPath, fileio::TransformIterator::kVisitMasterOnce); !it.done(); it.next())
   {
     const UsdPrim& prim = it.prim();
     if(!prim.IsValid())
@@ -1915,6 +1955,36 @@ bool ProxyShape::isBounded() const
   return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::memoryUsage(MemoryUsage& usage) const
+{
+  usage.push_back(MemoryUsageEntry{"boundingBoxCache", m_boundingBoxCache.size(), treeBytes(m_boundingBoxCache)});
+  if(m_context)
+  {
+    m_context->memoryUsage(usage);
+  }
+
+  const SdfPathVector& unselectable = m_selectabilityDB.getUnselectablePaths();
+  usage.push_back(MemoryUsageEntry{"selectabilityDB", unselectable.size(), vectorBytes(unselectable)});
+
+  usage.push_back(MemoryUsageEntry{"lockPrimIndex", m_lockPrimIndex.size(), m_lockPrimIndex.approximateBytes()});
+  usage.push_back(MemoryUsageEntry{"lockedPrims", m_currentLockedPrims.size(), treeBytes(m_currentLockedPrims)});
+  usage.push_back(MemoryUsageEntry{"pendingLockPrims", m_pendingLockPrims.size(), hashBytes(m_pendingLockPrims)});
+
+  usage.push_back(MemoryUsageEntry{"requiredPaths", m_requiredPaths.size(), treeBytes(m_requiredPaths)});
+
+  size_t dagPathBytes = hashBytes(m_primPathToDagPath);
+  for(const auto& it : m_primPathToDagPath)
+  {
+    dagPathBytes += it.second.length() + 1;
+  }
+  usage.push_back(MemoryUsageEntry{"primPathToDagPath", m_primPathToDagPath.size(), dagPathBytes});
+  usage.push_back(MemoryUsageEntry{"primPathToNode", m_primPathToNode.size(), hashBytes(m_primPathToNode)});
+
+  usage.push_back(MemoryUsageEntry{"selectedPaths", m_selectedPaths.size(), hashBytes(m_selectedPaths)});
+  usage.push_back(MemoryUsageEntry{"selectionList", m_selectionList.size(), hashBytes(m_selectionList.paths())});
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MBoundingBox ProxyShape::boundingBox() const
 {
@@ -2164,6 +2234,7 @@ void ProxyShape::cleanupTransformRefs()
   {
     if(!it->second.selected() && !it->second.required() && !it->second.refCount())
     {
+      m_primPathToNode.erase(it->first);
       m_requiredPaths.erase(it++);
     }
     else
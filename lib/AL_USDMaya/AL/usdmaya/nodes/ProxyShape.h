@@ -24,10 +24,13 @@
 #include "AL/event/EventHandler.h"
 #include "AL/maya/event/MayaEventManager.h"
 #include <AL/usdmaya/SelectabilityDB.h>
+#include "AL/usdmaya/LockPrimIndex.h"
 #include "AL/usdmaya/DrivenTransformsData.h"
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/fileio/translators/TransformTranslator.h"
+#include "AL/usdmaya/nodes/proxy/LayerGraph.h"
+#include "AL/usdmaya/nodes/RendererManager.h"
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "maya/MPxSurfaceShape.h"
 #include "maya/MEventMessage.h"
@@ -82,11 +85,12 @@ class Engine;
 /// \brief  A helper class to store the state that is modified during a change to the current selection within a
 ///         proxy shape. The state it maintains includes:
 ///
-///         \li The USD paths to be selected / deselected
+///         \li The USD paths to be selected / deselected (released once ProxyShape::doSelect has completed)
 ///         \li The Dag modifiers needed to create/destroy the associated maya nodes
 ///         \li The maya selection list prior to the selection
 ///         \li The maya selection list after the selection change
-///         \li The internal transformation references before and after the selection change
+///         \li The internal transformation references inserted and removed by the selection change. These also
+///             serve as the delta applied to (or reverted from) the selected paths of the proxy shape.
 ///
 ///         This class is intended to exist as a member variable on a MEL selection command. Once constructed, the class
 ///         should be passed to the ProxyShape::doSelect method to construct the internal state changes. At that point,
@@ -110,11 +114,16 @@ struct SelectionUndoHelper
   /// \brief  will undo the selection changes
   void undoIt();
 
+  /// \brief  returns the number of paths that doIt() adds to, and removes from, the proxy shape selected paths. Only
+  ///         this delta (rather than the full previous and new selections) is retained for undo.
+  /// \return the number of added plus removed paths
+  size_t deltaSize() const
+    { return m_insertedRefs.size() + m_removedRefs.size(); }
+
 private:
   friend class ProxyShape;
   nodes::ProxyShape* m_proxy;
   SdfPathHashSet m_paths;
-  SdfPathHashSet m_previousPaths;
   MGlobal::ListAdjustment m_mode;
   MDagModifier m_modifier1;
   MDagModifier m_modifier2;
@@ -147,13 +156,19 @@ public:
 
   /// \brief  clear the selection list
   inline void clear()
-    { m_selected.clear(); }
+    {
+      m_selected.clear();
+      m_version = nextVersion();
+    }
 
   /// \brief  adds a path to the selection
   /// \param  path to add
   inline void add(SdfPath path)
     {
-      m_selected.insert(path);
+      if(m_selected.insert(path).second)
+      {
+        m_version = nextVersion();
+      }
     }
 
   /// \brief  removes the path from the selection
@@ -164,6 +179,7 @@ public:
       if(it != m_selected.end())
       {
         m_selected.erase(it);
+        m_version = nextVersion();
       }
     }
 
@@ -176,6 +192,7 @@ public:
       {
         m_selected.erase(insertResult.first);
       }
+      m_version = nextVersion();
     }
 
   /// \brief  toggles the path in the selection
@@ -193,8 +210,58 @@ public:
   inline size_t size() const
     { return m_selected.size(); }
 
+  /// \brief  returns a stamp identifying the current contents of the selection list. Every modification assigns a
+  ///         new stamp, and copies share the stamp of their source, so restoring a copy (e.g. on undo) is detected
+  ///         as a change by anything that cached the previous stamp.
+  /// \return the version stamp (zero for a default constructed list)
+  inline uint64_t version() const
+    { return m_version; }
+
+  /// \brief  returns a new version stamp from a process wide, monotonically increasing counter. Never returns zero.
+  /// \return the next version stamp
+  AL_USDMAYA_PUBLIC
+  static uint64_t nextVersion();
+
 private:
   SdfPathHashSet m_selected;
+  uint64_t m_version = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Caches the union of the selected paths of a proxy shape (the paths selected through the Maya selection,
+///         and those in the internal SelectionList), so that the draw code does not have to rebuild it each frame.
+///         The cache is only rebuilt when the version stamp of either input changes.
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+class CombinedSelection
+{
+public:
+  /// a hash set of SdfPaths
+  typedef TfHashSet<SdfPath, SdfPath::Hash> SdfPathHashSet;
+
+  /// \brief  rebuilds the combined paths if either input has changed since the last update
+  /// \param  selectedPaths the paths selected via the Maya selection
+  /// \param  selectedPathsVersion the version stamp of selectedPaths
+  /// \param  selectionList the internal selection list
+  /// \return true if the combined paths were rebuilt, false if the cached paths were still valid
+  AL_USDMAYA_PUBLIC
+  bool update(const SdfPathHashSet& selectedPaths, uint64_t selectedPathsVersion, const SelectionList& selectionList);
+
+  /// \brief  the combined selected paths, as of the last call to update
+  /// \return the combined selected paths
+  inline const SdfPathVector& paths() const
+    { return m_paths; }
+
+  /// \brief  returns a stamp that changes each time the combined paths are rebuilt (zero prior to the first update)
+  /// \return the version stamp
+  inline uint64_t version() const
+    { return m_version; }
+
+private:
+  SdfPathVector m_paths;
+  uint64_t m_selectedPathsVersion = 0;
+  uint64_t m_selectionListVersion = 0;
+  uint64_t m_version = 0;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -240,6 +307,7 @@ struct FindLockedPrimsLogic
 
 typedef const HierarchyIterationLogic*  HierarchyIterationLogics[3];
 typedef std::unordered_map<SdfPath, MString, SdfPath::Hash > PrimPathToDagPath;
+typedef std::unordered_map<SdfPath, MObjectHandle, SdfPath::Hash > PrimPathToNode;
 
 extern AL::event::EventId kPreClearStageCache;
 extern AL::event::EventId kPostClearStageCache;
@@ -254,6 +322,7 @@ class ProxyShape
     public AL::maya::utils::NodeHelper,
     public proxy::PrimFilterInterface,
     public AL::event::NodeEvents,
+    public RendererClient,
     public TfWeakBase
 {
   friend struct SelectionUndoHelper;
@@ -407,6 +476,12 @@ public:
   UsdStageRefPtr usdStage() const
     { return m_stage; }
 
+  /// \brief  returns the dependency graph of the layers used by the stage. The graph is built on first access after
+  ///         the stage has been loaded, or after the composition of the stage has changed.
+  /// \return the layer graph
+  AL_USDMAYA_PUBLIC
+  const proxy::LayerGraph& layerGraph();
+
   /// \brief  gets hold of the attributes on this node that control the rendering in some way
   /// \param  attribs the returned set of render attributes
   /// \param  frameContext the frame context for rendering
@@ -587,6 +662,43 @@ public:
     }
   }
 
+  /// \brief  The state of the transform reference of a prim. Used by the bulk transform commands to record (and later
+  ///         restore) the references they change.
+  struct TransformRefState
+  {
+    SdfPath m_path; ///< the prim path
+    MObjectHandle m_node; ///< the maya transform node of the prim
+    uint16_t m_required; ///< the required reference count
+    uint16_t m_selected; ///< the selected reference count
+    uint16_t m_refCount; ///< the requested reference count
+
+    /// \brief  returns true if the reference is held by the same node with the same counts
+    bool operator == (const TransformRefState& other) const
+      { return m_node == other.m_node && m_required == other.m_required && m_selected == other.m_selected &&
+               m_refCount == other.m_refCount; }
+    bool operator != (const TransformRefState& other) const
+      { return !(*this == other); }
+  };
+  typedef std::vector<TransformRefState> TransformRefStates;
+
+  /// \brief  returns the transform references of the prims at or below each of the root paths, and of their
+  ///         ancestors, sorted by path
+  /// \param  roots the root prim paths
+  /// \param  states the returned transform references
+  AL_USDMAYA_PUBLIC
+  void captureTransformRefs(const SdfPathVector& roots, TransformRefStates& states) const;
+
+  /// \brief  replaces the transform references of the paths with the given states (adding references that do not
+  ///         exist yet). The maya nodes are not modified.
+  /// \param  states the transform references to apply
+  AL_USDMAYA_PUBLIC
+  void restoreTransformRefs(const TransformRefStates& states);
+
+  /// \brief  removes the transform references of the paths. The maya nodes are not modified.
+  /// \param  paths the prim paths whose references are removed
+  AL_USDMAYA_PUBLIC
+  void eraseTransformRefs(const SdfPathVector& paths);
+
   /// \brief  Tests to see if a given MObject is currently selected in the proxy shape. If the specified MObject is
   ///         selected, then the path will be filled with the corresponding usd prim path.
   /// \param  obj the input MObject to see if it's selected.
@@ -675,6 +787,20 @@ public:
   SdfPathHashSet& selectedPaths()
     { return m_selectedPaths; }
 
+  /// \brief  must be called after the set returned by selectedPaths() has been modified, so that the cached
+  ///         combinedSelection() is rebuilt on its next use
+  inline void selectedPathsChanged()
+    { m_selectedPathsVersion = SelectionList::nextVersion(); }
+
+  /// \brief  returns the union of selectedPaths() and selectionList(). The result is cached, and only rebuilt when
+  ///         either of those has changed, so the returned version can be used to skip redundant selection updates.
+  /// \return the combined selection
+  inline const CombinedSelection& combinedSelection()
+    {
+      m_combinedSelection.update(m_selectedPaths, m_selectedPathsVersion, m_selectionList);
+      return m_combinedSelection;
+    }
+
   /// \brief  Performs a selection operation on this node. Intended for use by the ProxyShapeSelect command only
   /// \param  helper provides the arguments to the selection system, and stores the internal proxy shape state
   ///         changes that need to be done/undone
@@ -700,6 +826,17 @@ public:
   inline Engine* engine() const
     { return m_engine; }
 
+  /// \brief  returns true if this shape currently has an imaging engine
+  bool hasRenderEngine() const override
+    { return m_engine != 0; }
+
+  /// \brief  switches the imaging engine of this shape to a hydra renderer plugin. Prefer
+  ///         RendererManager::changeRendererPlugin, which skips the switch if the engine is already using the plugin.
+  /// \param  plugin the renderer plugin to use
+  /// \return true if the renderer was switched
+  AL_USDMAYA_PUBLIC
+  bool switchRendererPlugin(const TfToken& plugin) override;
+
   //--------------------------------------------------------------------------------------------------------------------
   /// \name   Miscellaneous
   //--------------------------------------------------------------------------------------------------------------------
@@ -824,9 +961,22 @@ public:
   AL_USDMAYA_PUBLIC
   void removeAttributeChangedCallback();
 
+  /// \brief  locks (or unlocks) the transform attributes of the maya nodes for the prims whose lock state has changed
+  ///         since the last call, and retries the locks of prims that did not have a maya transform at the time.
   AL_USDMAYA_PUBLIC
   void constructLockPrims();
 
+  /// \brief Returns the index of the lock states of the prims in the stage
+  const AL::usdmaya::LockPrimIndex& lockPrimIndex() const
+    { return m_lockPrimIndex; }
+
+  /// \brief  Returns the element counts and approximate heap sizes of the caches and tables held by this proxy shape
+  ///         (bounding box cache, translator prim mappings, selectability DB, lock sets, required paths, and the
+  ///         transform reference tables). This only walks container sizes, so is cheap enough to poll.
+  /// \param  usage the returned entries (appended to)
+  AL_USDMAYA_PUBLIC
+  void memoryUsage(MemoryUsage& usage) const;
+
   /// \brief Translates prims at the specified paths, the operation conducted by the translator depends on
   ///        which list you populate.
   /// \param importPaths paths you wish to import
@@ -880,7 +1030,8 @@ private:
   void constructExcludedPrims();
   bool updateLockPrims(const SdfPathSet& lockTransformPrims, const SdfPathSet& lockInheritedPrims,
                        const SdfPathSet& unlockedPrims);
-  bool lockTransformAttribute(const SdfPath& path, bool lock);
+  MObject findLockableTransform(const SdfPath& path) const;
+  void lockTransformAttributes(const SdfPathVector& paths, bool lock, SdfPathVector& applied);
 
   MObject makeUsdTransformChain_internal(
       const UsdPrim& usdPrim,
@@ -1045,8 +1196,13 @@ private:
   SelectionList m_selectionList;
   FindUnselectablePrimsLogic m_findUnselectablePrims;
   SdfPathHashSet m_selectedPaths;
+  uint64_t m_selectedPathsVersion = 0;
+  CombinedSelection m_combinedSelection;
   FindLockedPrimsLogic m_findLockedPrims;
   PrimPathToDagPath m_primPathToDagPath;
+  /// the nodes recorded alongside m_primPathToDagPath, so they can be found without a name lookup. Entries are removed
+  /// along with the transform references of the nodes.
+  PrimPathToNode m_primPathToNode;
   std::vector<SdfPath> m_paths;
   std::vector<UsdPrim> m_prims;
   TfNotice::Key m_objectsChangedNoticeKey;
@@ -1059,9 +1215,10 @@ private:
   MCallbackId m_onSelectionChanged = 0;
   SdfPathVector m_excludedGeometry;
   SdfPathVector m_excludedTaggedGeometry;
-  SdfPathSet m_lockTransformPrims;
-  SdfPathSet m_lockInheritedPrims;
+  AL::usdmaya::LockPrimIndex m_lockPrimIndex;
   SdfPathSet m_currentLockedPrims;
+  /// prims that should be locked, but that have no maya transform to lock (yet)
+  std::unordered_set<SdfPath, SdfPath::Hash> m_pendingLockPrims;
   static MObject m_transformTranslate;
   static MObject m_transformRotate;
   static MObject m_transformScale;
@@ -1072,11 +1229,13 @@ private:
   SdfPath m_changedPath;
   SdfPathVector m_variantSwitchedPrims;
   SdfLayerHandle m_prevEditTarget;
+  proxy::LayerGraph m_layerGraph;
   Engine* m_engine = 0;
 
   uint32_t m_engineRefCount = 0;
   bool m_compositionHasChanged = false;
   bool m_drivenTransformsDirty = false;
+  bool m_layerGraphDirty = true;
   bool m_pleaseIgnoreSelection = false;
   bool m_hasChangedSelection = false;
 };
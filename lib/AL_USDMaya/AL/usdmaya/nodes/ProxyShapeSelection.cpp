@@ -23,6 +23,7 @@
 #include "maya/MFnDagNode.h"
 #include "maya/MPxCommand.h"
 
+#include <atomic>
 #include <set>
 #include <algorithm>
 #include "AL/usdmaya/utils/Utils.h"
@@ -48,6 +49,36 @@ inline void addObjToSelectionList(MSelectionList& list, const MObject& object)
 };
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t SelectionList::nextVersion()
+{
+  static std::atomic<uint64_t> counter(0);
+  return ++counter;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool CombinedSelection::update(const SdfPathHashSet& selectedPaths, uint64_t selectedPathsVersion, const SelectionList& selectionList)
+{
+  if(m_version &&
+     m_selectedPathsVersion == selectedPathsVersion &&
+     m_selectionListVersion == selectionList.version())
+  {
+    return false;
+  }
+
+  const auto& listPaths = selectionList.paths();
+  m_paths.clear();
+  m_paths.reserve(selectedPaths.size() + listPaths.size());
+  m_paths.insert(m_paths.end(), selectedPaths.begin(), selectedPaths.end());
+  m_paths.insert(m_paths.end(), listPaths.begin(), listPaths.end());
+
+  m_selectedPathsVersion = selectedPathsVersion;
+  m_selectionListVersion = selectionList.version();
+  m_version = SelectionList::nextVersion();
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("CombinedSelection::update rebuilt %lu paths\n", m_paths.size());
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 /// I have to handle the case where maya commands are issued (e.g. select -cl) that will remove our transform nodes
 /// from mayas global selection list (but will have left those nodes behind, and left them in the transform refs
@@ -428,6 +459,7 @@ MObject ProxyShape::makeUsdTransformChain(
       TransformReferenceMap::iterator previous = m_requiredPaths.find(usdPrim.GetPath());
       return previous->second.node();
     }
+    selectedPathsChanged();
   }
 
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::makeUsdTransformChain on %s\n", usdPrim.GetPath().GetText());
@@ -714,7 +746,10 @@ void ProxyShape::removeUsdTransformChain_internal(
         modifier.reparentNode(object);
         modifier.deleteNode(object);
       }
-      m_currentLockedPrims.erase(primPath);
+      if(m_currentLockedPrims.erase(primPath) && m_lockPrimIndex.isLocked(primPath))
+      {
+        m_pendingLockPrims.insert(primPath);
+      }
     }
 
     parentPrim = parentPrim.GetParent();
@@ -756,7 +791,11 @@ void ProxyShape::removeUsdTransformChain(
         }
       }
 
-      m_currentLockedPrims.erase(parentPrim);
+      if(m_currentLockedPrims.erase(parentPrim) && m_lockPrimIndex.isLocked(parentPrim))
+      {
+        m_pendingLockPrims.insert(parentPrim);
+      }
+      m_primPathToNode.erase(parentPrim);
       m_requiredPaths.erase(it);
     }
 
@@ -782,6 +821,7 @@ void ProxyShape::removeUsdTransformChain(
     if(selectedPath != m_selectedPaths.end())
     {
       m_selectedPaths.erase(selectedPath);
+      selectedPathsChanged();
     }
     else
     {
@@ -809,6 +849,7 @@ void ProxyShape::removeUsdTransformChain(
         modifier.deleteNode(object);
       }
 
+      m_primPathToNode.erase(it->first);
       m_requiredPaths.erase(it);
     }
 
@@ -841,6 +882,7 @@ void ProxyShape::removeUsdTransformsInternal(
     // work around for Maya's love of deleting the parent transforms of custom transform nodes :(
     modifier.reparentNode(it->second.node());
     modifier.deleteNode(it->second.node());
+    m_primPathToNode.erase(it->first);
     m_requiredPaths.erase(it);
   }
 }
@@ -883,6 +925,71 @@ void ProxyShape::insertTransformRefs(const std::vector<std::pair<SdfPath, MObjec
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::captureTransformRefs(const SdfPathVector& roots, TransformRefStates& states) const
+{
+  states.clear();
+  auto capture = [&states] (const TransformReferenceMap::value_type& ref)
+  {
+    states.push_back(TransformRefState{ref.first, MObjectHandle(ref.second.node()), uint16_t(ref.second.required()),
+                                       uint16_t(ref.second.selected()), uint16_t(ref.second.refCount())});
+  };
+
+  for(const SdfPath& root : roots)
+  {
+    for(SdfPath parent = root.GetParentPath(); !parent.IsEmpty() && parent != SdfPath::AbsoluteRootPath();
+        parent = parent.GetParentPath())
+    {
+      auto it = m_requiredPaths.find(parent);
+      if(it != m_requiredPaths.end())
+      {
+        capture(*it);
+      }
+    }
+
+    // the map is sorted, so the descendants of the root follow it
+    for(auto it = m_requiredPaths.lower_bound(root), end = m_requiredPaths.end(); it != end && it->first.HasPrefix(root); ++it)
+    {
+      capture(*it);
+    }
+  }
+
+  std::sort(states.begin(), states.end(),
+            [] (const TransformRefState& a, const TransformRefState& b) { return a.m_path < b.m_path; });
+  states.erase(std::unique(states.begin(), states.end(),
+                           [] (const TransformRefState& a, const TransformRefState& b) { return a.m_path == b.m_path; }),
+               states.end());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::restoreTransformRefs(const TransformRefStates& states)
+{
+  for(const TransformRefState& state : states)
+  {
+    MObject node = state.m_node.object();
+    MFnDependencyNode fn(node);
+    Transform* transform = fn.typeId() == AL_USDMAYA_TRANSFORM ? (Transform*)fn.userNode() : 0;
+    TransformReference ref(node, transform, state.m_required, state.m_selected, state.m_refCount);
+    ref.prepSelect();
+    auto inserted = m_requiredPaths.emplace(state.m_path, ref);
+    if(!inserted.second)
+    {
+      inserted.first->second = ref;
+    }
+    m_primPathToNode[state.m_path] = state.m_node;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::eraseTransformRefs(const SdfPathVector& paths)
+{
+  for(const SdfPath& path : paths)
+  {
+    m_primPathToNode.erase(path);
+    m_requiredPaths.erase(path);
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 SelectionUndoHelper::SelectionUndoHelper(nodes::ProxyShape* proxy, const SdfPathHashSet& paths, MGlobal::ListAdjustment mode, bool internal)
   : m_proxy(proxy), m_paths(paths), m_mode(mode), m_modifier1(), m_modifier2(), m_insertedRefs(), m_removedRefs(), m_internal(internal)
@@ -898,7 +1005,16 @@ void SelectionUndoHelper::doIt()
   m_modifier2.doIt();
   m_proxy->insertTransformRefs(m_insertedRefs, nodes::ProxyShape::kSelection);
   m_proxy->removeTransformRefs(m_removedRefs, nodes::ProxyShape::kSelection);
-  m_proxy->selectedPaths() = m_paths;
+  auto& selectedPaths = m_proxy->selectedPaths();
+  for(const auto& removed : m_removedRefs)
+  {
+    selectedPaths.erase(removed.first);
+  }
+  for(const auto& inserted : m_insertedRefs)
+  {
+    selectedPaths.insert(inserted.first);
+  }
+  m_proxy->selectedPathsChanged();
   if(!m_internal)
   {
     MGlobal::setActiveSelectionList(m_newSelection, MGlobal::kReplaceList);
@@ -916,7 +1032,16 @@ void SelectionUndoHelper::undoIt()
   m_modifier1.undoIt();
   m_proxy->insertTransformRefs(m_removedRefs, nodes::ProxyShape::kSelection);
   m_proxy->removeTransformRefs(m_insertedRefs, nodes::ProxyShape::kSelection);
-  m_proxy->selectedPaths() = m_previousPaths;
+  auto& selectedPaths = m_proxy->selectedPaths();
+  for(const auto& inserted : m_insertedRefs)
+  {
+    selectedPaths.erase(inserted.first);
+  }
+  for(const auto& removed : m_removedRefs)
+  {
+    selectedPaths.insert(removed.first);
+  }
+  m_proxy->selectedPathsChanged();
   if(!m_internal)
   {
     MGlobal::setActiveSelectionList(m_previousSelection, MGlobal::kReplaceList);
@@ -939,6 +1064,7 @@ void ProxyShape::removeTransformRefs(const std::vector<std::pair<SdfPath, MObjec
       {
         if(it->second.decRef(reason))
         {
+          m_primPathToNode.erase(it->first);
           m_requiredPaths.erase(it);
         }
       }
@@ -1009,6 +1135,7 @@ bool ProxyShape::removeAllSelectedNodes(SelectionUndoHelper& helper)
       }
     }
     m_selectedPaths.clear();
+    selectedPathsChanged();
 
     return true;
   }
@@ -1029,7 +1156,6 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
 
   MGlobal::getActiveSelectionList(helper.m_previousSelection);
 
-  helper.m_previousPaths = selectedPaths();
   if(MGlobal::kReplaceList == helper.m_mode)
   {
     if(helper.m_paths.empty())
@@ -1073,7 +1199,8 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
 
       std::sort(keepPrims.begin(), keepPrims.end());
 
-      m_selectedPaths.clear();
+      SdfPathHashSet previousPaths;
+      previousPaths.swap(m_selectedPaths);
 
       uint32_t hasNodesToCreate = 0;
       for(auto prim : insertPrims)
@@ -1086,7 +1213,7 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
         helper.m_insertedRefs.emplace_back(prim.GetPath(), object);
       }
 
-      for(auto iter : helper.m_previousPaths)
+      for(const auto& iter : previousPaths)
       {
         auto temp = m_requiredPaths.find(iter);
         MObject object = temp->second.node();
@@ -1102,8 +1229,6 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
           m_selectedPaths.insert(iter);
         }
       }
-
-      helper.m_paths = m_selectedPaths;
     }
     break;
 
@@ -1125,8 +1250,6 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
         }
       }
 
-      helper.m_paths.insert(helper.m_previousPaths.begin(), helper.m_previousPaths.end());
-
       uint32_t hasNodesToCreate = 0;
       for(auto prim : prims)
       {
@@ -1193,14 +1316,9 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
               break;
             }
           }
-          helper.m_paths = m_selectedPaths;
           helper.m_removedRefs.emplace_back(prim.GetPath(), object);
         }
       }
-      else
-      {
-        helper.m_paths.clear();
-      }
     }
     break;
 
@@ -1262,10 +1380,13 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
         addObjToSelectionList(helper.m_newSelection, object);
         helper.m_insertedRefs.emplace_back(prim.GetPath(), object);
       }
-      helper.m_paths = m_selectedPaths;
     }
     break;
   }
+  selectedPathsChanged();
+
+  // the undo helper only needs the inserted/removed refs from here on, so release the requested paths
+  SdfPathHashSet().swap(helper.m_paths);
 
   if(newlySelectedPaths.length())
   {
@@ -286,6 +286,8 @@ void ProxyShapeUI::draw(const MDrawRequest& request, M3dView& view) const
   params.drawMode = style;
   params.wireframeColor = colour;
   engine->SetSelected(paths);
+  // this is not the combined selection, so make sure the VP2 draw override resubmits its own
+  engine->setSelectionVersion(0);
   engine->SetSelectionColor(GfVec4f(1.0f, 2.0f/3.0f, 0.0f, 1.0f));
   engine->Render(shape->getRootPrim(), params);
 
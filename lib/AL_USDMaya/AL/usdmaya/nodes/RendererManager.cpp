@@ -17,12 +17,12 @@
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/nodes/Engine.h"
 #include "AL/usdmaya/nodes/RendererManager.h"
-#include "AL/usdmaya/nodes/ProxyShape.h"
 
 #include "pxr/usdImaging/usdImaging/version.h"
 #include "pxr/usdImaging/usdImagingGL/engine.h"
 
 #include "maya/MGlobal.h"
+#include "maya/MEventMessage.h"
 #include "maya/MFnDependencyNode.h"
 #include "maya/MItDependencyNodes.h"
 
@@ -36,9 +36,40 @@ namespace AL {
 namespace usdmaya {
 namespace nodes {
 
+//----------------------------------------------------------------------------------------------------------------------
+RendererClient::RendererClient()
+{
+  // a client starts out with the default renderer
+  const TfTokenVector& plugins = RendererManager::m_rendererPluginsTokens;
+  RendererManager::m_clients.emplace(this, plugins.empty() ? TfToken() : plugins[0]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+RendererClient::~RendererClient()
+{
+  RendererManager::m_clients.erase(this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RendererClient::renderEngineCreated()
+{
+  auto it = RendererManager::m_clients.find(this);
+  if(it != RendererManager::m_clients.end())
+  {
+    const TfTokenVector& plugins = RendererManager::m_rendererPluginsTokens;
+    it->second = plugins.empty() ? TfToken() : plugins[0];
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 RendererManager::~RendererManager()
 {
   removeAttributeChangedCallback();
+  if(m_idle != 0)
+  {
+    MMessage::removeCallback(m_idle);
+    m_idle = 0;
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -49,6 +80,7 @@ MObject RendererManager::m_rendererPlugin = MObject::kNullObj;
 
 TfTokenVector RendererManager::m_rendererPluginsTokens;
 MStringArray RendererManager::m_rendererPluginsNames;
+std::unordered_map<RendererClient*, TfToken> RendererManager::m_clients;
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus RendererManager::initialise()
@@ -237,52 +269,119 @@ bool RendererManager::getInternalValueInContext(const MPlug& plug, MDataHandle&
 //----------------------------------------------------------------------------------------------------------------------
 void RendererManager::onRendererChanged()
 {
-  // Find all proxy shapes and change renderer plugin
-  MFnDependencyNode fn;
-  MItDependencyNodes iter(MFn::kPluginShape);
-  for(; !iter.isDone(); iter.next())
+  if(!m_deferRendererChanges)
   {
-    fn.setObject(iter.item());
-    if(fn.typeId() == ProxyShape::kTypeId)
+    applyRendererChange();
+    return;
+  }
+
+  // coalesce all of the changes made before the next idle into a single switch
+  m_rendererChangePending = true;
+  if(m_idle == 0)
+  {
+    m_idle = MEventMessage::addEventCallback("idle", onIdle, this);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RendererManager::onIdle(void* clientData)
+{
+  RendererManager* manager = static_cast<RendererManager*>(clientData);
+  assert(manager);
+  manager->applyRendererChange();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t RendererManager::applyRendererChange()
+{
+  TF_DEBUG(ALUSDMAYA_RENDERER).Msg("RendererManager::applyRendererChange\n");
+  m_rendererChangePending = false;
+  if(m_idle != 0)
+  {
+    MMessage::removeCallback(m_idle);
+    m_idle = 0;
+  }
+
+  TfToken plugin;
+  if(!currentRendererPlugin(plugin))
+  {
+    return 0;
+  }
+
+  uint32_t numChanged = 0;
+  for(auto& it : m_clients)
+  {
+    if(applyRendererPlugin(it.first, it.second, plugin))
     {
-      ProxyShape* proxy = static_cast<ProxyShape*>(fn.userNode());
-      changeRendererPlugin(proxy);
+      ++numChanged;
     }
   }
+
   //! We need to refresh viewport to changes take effect
-  MGlobal::executeCommandOnIdle("refresh -force");
+  if(numChanged)
+  {
+    MGlobal::executeCommandOnIdle("refresh -force");
+  }
+  return numChanged;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void RendererManager::changeRendererPlugin(ProxyShape* proxy, bool creation)
+void RendererManager::changeRendererPlugin(RendererClient* client, bool creation)
 {
   TF_DEBUG(ALUSDMAYA_RENDERER).Msg("RendererManager::changeRendererPlugin\n");
-  assert(proxy);
-  if (proxy->engine())
+  assert(client);
+  auto it = m_clients.find(client);
+  if(it == m_clients.end())
   {
-    int rendererId = getRendererPluginIndex();
-    if (rendererId >= 0)
-    {
-      // Skip redundant renderer changes on ProxyShape creation
-      if (rendererId == 0 && creation)
-        return;
-      
-      assert(static_cast<size_t>(rendererId) < m_rendererPluginsTokens.size());
-      TfToken plugin = m_rendererPluginsTokens[rendererId];
-      if (!proxy->engine()->SetRendererPlugin(plugin))
-      {
-        MString data(plugin.data());
-        MGlobal::displayError(MString("Failed to set renderer plugin: ") + data);
-      }
-    }
-    else
-    {
-      MPlug plug(thisMObject(), m_rendererPluginName);
-      MString pluginName = plug.asString();
-      if (pluginName.length())
-        MGlobal::displayError(MString("Invalid renderer plugin: ") + pluginName);
-    }
+    return;
+  }
+
+  // a newly created engine is using the default renderer
+  if(creation)
+  {
+    it->second = m_rendererPluginsTokens.empty() ? TfToken() : m_rendererPluginsTokens[0];
+  }
+
+  TfToken plugin;
+  if(currentRendererPlugin(plugin))
+  {
+    applyRendererPlugin(client, it->second, plugin);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool RendererManager::currentRendererPlugin(TfToken& plugin) const
+{
+  int rendererId = getRendererPluginIndex();
+  if (rendererId < 0)
+  {
+    MPlug plug(thisMObject(), m_rendererPluginName);
+    MString pluginName = plug.asString();
+    if (pluginName.length())
+      MGlobal::displayError(MString("Invalid renderer plugin: ") + pluginName);
+    return false;
+  }
+  assert(static_cast<size_t>(rendererId) < m_rendererPluginsTokens.size());
+  plugin = m_rendererPluginsTokens[rendererId];
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool RendererManager::applyRendererPlugin(RendererClient* client, TfToken& applied, const TfToken& plugin)
+{
+  // skip redundant renderer changes, which would otherwise rebuild the render delegate
+  if(applied == plugin || !client->hasRenderEngine())
+  {
+    return false;
+  }
+  if(!client->switchRendererPlugin(plugin))
+  {
+    MString data(plugin.data());
+    MGlobal::displayError(MString("Failed to set renderer plugin: ") + data);
+    return false;
   }
+  applied = plugin;
+  return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
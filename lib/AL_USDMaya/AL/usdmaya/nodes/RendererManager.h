@@ -22,10 +22,13 @@
 #include "pxr/usd/usd/stage.h"
 
 #include "maya/MPxLocatorNode.h"
+#include "maya/MMessage.h"
 #include "maya/MNodeMessage.h"
+#include "maya/MGlobal.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
 
 #include <map>
+#include <unordered_map>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -35,6 +38,40 @@ namespace nodes {
 
 class ProxyShape;
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The interface through which the RendererManager switches the hydra renderer used to draw a node. The
+///         ProxyShape implements this for its imaging engine. Clients register themselves with the RendererManager on
+///         construction, and unregister on destruction.
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+class RendererClient
+{
+public:
+
+  /// \brief  ctor, registers the client with the RendererManager
+  AL_USDMAYA_PUBLIC
+  RendererClient();
+
+  /// \brief  dtor, unregisters the client from the RendererManager
+  AL_USDMAYA_PUBLIC
+  virtual ~RendererClient();
+
+  /// \brief  returns true if the client currently has an engine whose renderer can be switched
+  virtual bool hasRenderEngine() const = 0;
+
+  /// \brief  switches the engine to the specified renderer plugin
+  /// \param  plugin the hydra renderer plugin to use
+  /// \return true if the renderer was switched
+  virtual bool switchRendererPlugin(const TfToken& plugin) = 0;
+
+protected:
+
+  /// \brief  records that the client's engine has been (re)created, and is therefore using the default renderer. This
+  ///         must be called whenever the engine is replaced, even if there is no RendererManager node to apply the
+  ///         current renderer, otherwise the manager would later skip switching the new engine to that renderer.
+  AL_USDMAYA_PUBLIC
+  void renderEngineCreated();
+};
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The layer manager node handles serialization and deserialization of all layers used by all ProxyShapes
@@ -48,7 +85,7 @@ public:
 
   /// \brief  ctor
   inline RendererManager()
-    : MPxNode(), NodeHelper() {}
+    : MPxNode(), NodeHelper(), m_deferRendererChanges(MGlobal::mayaState() == MGlobal::kInteractive) {}
 
   ~RendererManager();
 
@@ -80,14 +117,34 @@ public:
   /// Methods to handle renderer plugin
   //--------------------------------------------------------------------------------------------------------------------
 
-  /// \brief  Set current renderer for all proxy shapes
+  /// \brief  Set current renderer for all proxy shapes. When changes are deferred (the default in interactive
+  ///         sessions), the switch is applied on the next idle event, so that a number of renderer changes in quick
+  ///         succession only switch the renderers once.
   void onRendererChanged();
 
+  /// \brief  Switches the renderer of every registered client whose renderer differs from the current renderer
+  ///         plugin, and clears any pending renderer change.
+  /// \return the number of clients whose renderer was switched
+  AL_USDMAYA_PUBLIC
+  uint32_t applyRendererChange();
+
+  /// \brief  returns true if a renderer change is waiting for the next idle event
+  bool isRendererChangePending() const
+    { return m_rendererChangePending; }
+
+  /// \brief  Enable or disable deferring renderer changes to the next idle event. When disabled, a renderer change is
+  ///         applied immediately. Changes are only deferred by default in interactive sessions.
+  void setDeferRendererChanges(bool defer)
+    { m_deferRendererChanges = defer; }
+
   /// \brief  Set current renderer plugin based on provided name
   bool setRendererPlugin(const MString& pluginName);
 
-  /// \brief  Change current renderer plugin for provided ProxyShape
-  void changeRendererPlugin(ProxyShape* proxy, bool creation=false);
+  /// \brief  Change current renderer plugin for provided client (if it differs from the client's current renderer)
+  /// \param  client the client (typically a ProxyShape) to update
+  /// \param  creation true if the client has just created a new engine (which will be using the default renderer)
+  AL_USDMAYA_PUBLIC
+  void changeRendererPlugin(RendererClient* client, bool creation=false);
   
   /// \brief  Get current renderer plugin index
   int getRendererPluginIndex() const;
@@ -110,8 +167,16 @@ public:
   AL_DECL_ATTRIBUTE(rendererPlugin);
 
 private:
+  friend class RendererClient;
   static MObject _findNode();
   static void onAttributeChanged(MNodeMessage::AttributeMessage, MPlug&, MPlug&, void*);
+  static void onIdle(void*);
+
+  /// \brief  returns the token of the current renderer plugin, or reports an error if the plugin name is invalid
+  bool currentRendererPlugin(TfToken& plugin) const;
+
+  /// \brief  switches the renderer of a client, if it is not already using the plugin
+  bool applyRendererPlugin(RendererClient* client, TfToken& applied, const TfToken& plugin);
 
   /// \brief  adds the attribute changed callback to manager
   void addAttributeChangedCallback();
@@ -120,10 +185,16 @@ private:
   void removeAttributeChangedCallback();
 
   MCallbackId m_attributeChanged = 0;
+  MCallbackId m_idle = 0;
+  bool m_rendererChangePending = false;
+  bool m_deferRendererChanges;
 
   static TfTokenVector m_rendererPluginsTokens;
   static MStringArray m_rendererPluginsNames;
 
+  /// the registered clients, and the renderer plugin each of them is currently using
+  static std::unordered_map<RendererClient*, TfToken> m_clients;
+
   //--------------------------------------------------------------------------------------------------------------------
   /// MPxNode overrides
   //--------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,211 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/LayerGraph.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/usd/sdf/layerUtils.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <algorithm>
+#include <set>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr LayerGraph::NodeIndex LayerGraph::kInvalidIndex;
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerGraph::build(const UsdStageRefPtr& stage)
+{
+  if(stage)
+  {
+    build(stage->GetUsedLayers());
+  }
+  else
+  {
+    clear();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerGraph::build(const SdfLayerHandleVector& layers)
+{
+  TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerGraph::build %lu layers\n", layers.size());
+  clear();
+  m_nodes.reserve(layers.size());
+
+  // first pass, hash all of the layers by identifier and display name
+  for(const SdfLayerHandle& layer : layers)
+  {
+    if(!layer)
+      continue;
+    const NodeIndex index = NodeIndex(m_nodes.size());
+    if(!m_identifierToIndex.insert(std::make_pair(layer->GetIdentifier(), index)).second)
+    {
+      // duplicate entry in the input
+      continue;
+    }
+    m_displayNameToIndices[layer->GetDisplayName()].push_back(index);
+    Node node;
+    node.layer = layer;
+    m_nodes.push_back(node);
+  }
+
+  // second pass, resolve each external reference with a hashed lookup
+  for(Node& node : m_nodes)
+  {
+    const std::set<std::string> refs = node.layer->GetExternalReferences();
+    node.children.reserve(refs.size());
+    for(const std::string& ref : refs)
+    {
+      const NodeIndex child = resolveReference(node.layer, ref);
+      if(child != kInvalidIndex && std::find(node.children.begin(), node.children.end(), child) == node.children.end())
+      {
+        node.children.push_back(child);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerGraph::clear()
+{
+  m_nodes.clear();
+  m_identifierToIndex.clear();
+  m_displayNameToIndices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerGraph::NodeIndex LayerGraph::resolveReference(const SdfLayerHandle& layer, const std::string& reference) const
+{
+  if(reference.empty())
+    return kInvalidIndex;
+
+  NodeIndex index = indexOf(reference);
+  if(index != kInvalidIndex)
+    return index;
+
+  // relative asset paths are anchored to the referencing layer
+  index = indexOf(SdfComputeAssetPathRelativeToLayer(layer, reference));
+  if(index != kInvalidIndex)
+    return index;
+
+  auto it = m_displayNameToIndices.find(reference);
+  if(it != m_displayNameToIndices.end())
+    return it->second.front();
+
+  return kInvalidIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerGraph::NodeIndex LayerGraph::indexOf(const std::string& identifier) const
+{
+  auto it = m_identifierToIndex.find(identifier);
+  return it != m_identifierToIndex.end() ? it->second : kInvalidIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerHandle LayerGraph::findLayer(const std::string& name) const
+{
+  NodeIndex index = indexOf(name);
+  if(index != kInvalidIndex)
+    return m_nodes[index].layer;
+
+  auto it = m_displayNameToIndices.find(name);
+  if(it != m_displayNameToIndices.end())
+    return m_nodes[it->second.front()].layer;
+
+  return SdfLayerHandle();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerHandleVector LayerGraph::findLayersByDisplayName(const std::string& displayName) const
+{
+  SdfLayerHandleVector layers;
+  auto it = m_displayNameToIndices.find(displayName);
+  if(it != m_displayNameToIndices.end())
+  {
+    layers.reserve(it->second.size());
+    for(NodeIndex index : it->second)
+    {
+      layers.push_back(m_nodes[index].layer);
+    }
+  }
+  return layers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerHandleVector LayerGraph::children(const SdfLayerHandle& layer) const
+{
+  SdfLayerHandleVector layers;
+  if(layer)
+  {
+    const NodeIndex index = indexOf(layer->GetIdentifier());
+    if(index != kInvalidIndex)
+    {
+      const std::vector<NodeIndex>& kids = m_nodes[index].children;
+      layers.reserve(kids.size());
+      for(NodeIndex child : kids)
+      {
+        layers.push_back(m_nodes[child].layer);
+      }
+    }
+  }
+  return layers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerHandleVector LayerGraph::descendants(const SdfLayerHandle& layer) const
+{
+  SdfLayerHandleVector layers;
+  if(!layer)
+    return layers;
+
+  const NodeIndex root = indexOf(layer->GetIdentifier());
+  if(root == kInvalidIndex)
+    return layers;
+
+  // iterative depth first walk. The visited flags guard against reference cycles.
+  std::vector<bool> visited(m_nodes.size(), false);
+  std::vector<NodeIndex> stack(m_nodes[root].children.rbegin(), m_nodes[root].children.rend());
+  while(!stack.empty())
+  {
+    const NodeIndex index = stack.back();
+    stack.pop_back();
+    if(visited[index])
+      continue;
+    visited[index] = true;
+    layers.push_back(m_nodes[index].layer);
+
+    const std::vector<NodeIndex>& kids = m_nodes[index].children;
+    for(auto it = kids.rbegin(); it != kids.rend(); ++it)
+    {
+      if(!visited[*it])
+        stack.push_back(*it);
+    }
+  }
+  return layers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,137 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/tf/hash.h"
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/common.h"
+
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A dependency graph of the layers used by a stage. Each layer is stored once (keyed by its identifier), and
+///         the sublayers and references of each layer are resolved once when the graph is built. This avoids having
+///         to repeatedly scan the list of used layers when looking up a layer by name, or when walking the layer tree.
+///         Layers that share the same display name are all retained, and cycles within the layer references are
+///         tolerated by the traversal methods.
+//----------------------------------------------------------------------------------------------------------------------
+class LayerGraph
+{
+public:
+
+  /// index of a layer within the graph
+  typedef uint32_t NodeIndex;
+
+  /// returned when a layer cannot be found in the graph
+  static constexpr NodeIndex kInvalidIndex = ~NodeIndex(0);
+
+  /// \brief  ctor
+  LayerGraph() = default;
+
+  /// \brief  rebuilds the graph from the layers used by the specified stage
+  /// \param  stage the stage to build the graph from
+  AL_USDMAYA_PUBLIC
+  void build(const UsdStageRefPtr& stage);
+
+  /// \brief  rebuilds the graph from the specified layers. Any external references to layers not within this list
+  ///         are ignored.
+  /// \param  layers the layers to insert into the graph
+  AL_USDMAYA_PUBLIC
+  void build(const SdfLayerHandleVector& layers);
+
+  /// \brief  removes all layers from the graph
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  returns the number of layers in the graph
+  inline size_t size() const
+    { return m_nodes.size(); }
+
+  /// \brief  returns true if the graph contains no layers
+  inline bool empty() const
+    { return m_nodes.empty(); }
+
+  /// \brief  returns the layer at the specified index
+  inline const SdfLayerHandle& layer(NodeIndex index) const
+    { return m_nodes[index].layer; }
+
+  /// \brief  returns the indices of the layers directly referenced (or sublayered) by the layer at the given index
+  inline const std::vector<NodeIndex>& childIndices(NodeIndex index) const
+    { return m_nodes[index].children; }
+
+  /// \brief  returns the index of the layer with the given identifier
+  /// \param  identifier the layer identifier
+  /// \return the index of the layer, or kInvalidIndex if not found
+  AL_USDMAYA_PUBLIC
+  NodeIndex indexOf(const std::string& identifier) const;
+
+  /// \brief  finds a layer by identifier. If no layer matches the identifier, the first layer (in used-layer order)
+  ///         with the specified display name is returned.
+  /// \param  name the identifier or display name of the layer
+  /// \return the layer, or an invalid handle if not found
+  AL_USDMAYA_PUBLIC
+  SdfLayerHandle findLayer(const std::string& name) const;
+
+  /// \brief  returns all of the layers that share the given display name
+  /// \param  displayName the display name of the layer
+  /// \return the matching layers, in used-layer order
+  AL_USDMAYA_PUBLIC
+  SdfLayerHandleVector findLayersByDisplayName(const std::string& displayName) const;
+
+  /// \brief  returns the layers directly referenced (or sublayered) by the specified layer
+  /// \param  layer the layer to query
+  /// \return the child layers
+  AL_USDMAYA_PUBLIC
+  SdfLayerHandleVector children(const SdfLayerHandle& layer) const;
+
+  /// \brief  returns all layers reachable from the specified layer (not including the layer itself, unless it is part
+  ///         of a cycle). Each layer is returned once, in depth first order.
+  /// \param  layer the layer to query
+  /// \return the reachable layers
+  AL_USDMAYA_PUBLIC
+  SdfLayerHandleVector descendants(const SdfLayerHandle& layer) const;
+
+private:
+  struct Node
+  {
+    SdfLayerHandle layer;
+    std::vector<NodeIndex> children;
+  };
+  NodeIndex resolveReference(const SdfLayerHandle& layer, const std::string& reference) const;
+
+  std::vector<Node> m_nodes;
+  TfHashMap<std::string, NodeIndex, TfHash> m_identifierToIndex;
+  TfHashMap<std::string, std::vector<NodeIndex>, TfHash> m_displayNameToIndices;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 // limitations under the License.
 //
 #include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/nodes/LayerManager.h"
 #include "AL/maya/utils/Utils.h"
 
 #include <boost/python/args.hpp>
@@ -21,6 +22,7 @@
 #include <boost/python.hpp>
 
 #include "maya/MBoundingBox.h"
+#include "maya/MDagPath.h"
 #include "maya/MFnDagNode.h"
 #include "maya/MFnDependencyNode.h"
 #include "maya/MDagModifier.h"
@@ -30,10 +32,17 @@
 #include "pxr/base/tf/pyEnum.h"
 #include "pxr/base/tf/pyResultConversions.h"
 #include "pxr/base/tf/refPtr.h"
+#include "pxr/usd/usdGeom/bboxCache.h"
+#include "pxr/usd/usdGeom/xformCache.h"
 
+#include <boost/python/stl_iterator.hpp>
+
+#include <cstring>
 #include <memory>
 
 using AL::usdmaya::nodes::ProxyShape;
+using AL::usdmaya::nodes::LayerManager;
+using AL::usdmaya::MemoryUsage;
 using boost::python::reference_existing_object;
 using boost::python::object;
 
@@ -46,12 +55,20 @@ namespace {
     static PyObject* convert(const MBoundingBox& bbox)
     {
         TfPyLock lock;
-        object OpenMaya = boost::python::import("maya.OpenMaya");
         // Considered grabbing the raw pointer to the MBoundingBox
         // from the swig wrapper, but this seems sketchy, so I'm
-        // just re-constructing "in python"
-        object PyMBoundingBox = OpenMaya.attr("MBoundingBox");
-        object PyMPoint = OpenMaya.attr("MPoint");
+        // just re-constructing "in python". The class objects are looked up once and kept alive for the lifetime
+        // of the process (intentionally leaked, so they are never released after the interpreter has shut down).
+        static object* PyMBoundingBoxPtr = nullptr;
+        static object* PyMPointPtr = nullptr;
+        if(!PyMBoundingBoxPtr)
+        {
+          object OpenMaya = boost::python::import("maya.OpenMaya");
+          PyMBoundingBoxPtr = new object(OpenMaya.attr("MBoundingBox"));
+          PyMPointPtr = new object(OpenMaya.attr("MPoint"));
+        }
+        const object& PyMBoundingBox = *PyMBoundingBoxPtr;
+        const object& PyMPoint = *PyMPointPtr;
         MPoint min = bbox.min();
         MPoint max = bbox.max();
         object pyMin = PyMPoint(min.x, min.y, min.z, min.w);
@@ -106,6 +123,56 @@ namespace {
     }
   }
 
+  //----------------------------------------------------------------------------------------------------------------------
+  /// \brief  Converts a python iterable of SdfPaths (or strings) into an SdfPathVector
+  /// \param  paths the python sequence to convert
+  /// \return the paths
+  SdfPathVector toPathVector(const object& paths)
+  {
+    SdfPathVector result;
+    const Py_ssize_t count = PyObject_Length(paths.ptr());
+    if(count > 0)
+    {
+      result.reserve(count);
+    }
+    else
+    {
+      PyErr_Clear();
+    }
+    result.insert(result.end(),
+                  boost::python::stl_input_iterator<SdfPath>(paths),
+                  boost::python::stl_input_iterator<SdfPath>());
+    return result;
+  }
+
+  //----------------------------------------------------------------------------------------------------------------------
+  /// \brief  Allocates an uninitialised python bytearray of the given size. The returned buffer is filled in place by
+  ///         the bulk query methods, so the results are never copied once computed.
+  /// \param  numBytes the size of the buffer
+  /// \param  data returns the address of the first byte of the buffer
+  /// \return the bytearray
+  object makeByteArray(size_t numBytes, char*& data)
+  {
+    object result(boost::python::handle<>(PyByteArray_FromStringAndSize(nullptr, Py_ssize_t(numBytes))));
+    data = PyByteArray_AS_STRING(result.ptr());
+    return result;
+  }
+
+  //----------------------------------------------------------------------------------------------------------------------
+  /// \brief  Returns the maya world space matrix of the proxy shape, which maps stage space into maya world space.
+  ///         If the shape is instanced, the first path to it is used.
+  /// \param  proxyShape the ProxyShape to query
+  /// \return the world matrix of the proxy shape
+  GfMatrix4d proxyWorldMatrix(const ProxyShape& proxyShape)
+  {
+    MDagPath path;
+    if(!MDagPath::getAPathTo(proxyShape.thisMObject(), path))
+    {
+      return GfMatrix4d(1.0);
+    }
+    return GfMatrix4d(path.inclusiveMatrix().matrix);
+  }
+
   struct PyProxyShape
   {
 
@@ -130,6 +197,141 @@ namespace {
       return MobjToName(obj, desc);
     }
 
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Vectorised version of ProxyShape::isRequiredPath
+    /// \param  proxyShape the ProxyShape to query
+    /// \param  paths a sequence of SdfPaths (or path strings)
+    /// \return a bytearray holding one byte per path, 1 if the path is required, 0 otherwise
+    static object isRequiredPaths(const ProxyShape& proxyShape, const object& paths)
+    {
+      const SdfPathVector pathVec = toPathVector(paths);
+      char* data = nullptr;
+      object result = makeByteArray(pathVec.size(), data);
+      for(size_t i = 0, n = pathVec.size(); i < n; ++i)
+      {
+        data[i] = proxyShape.isRequiredPath(pathVec[i]) ? 1 : 0;
+      }
+      return result;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Vectorised version of findRequiredPath
+    /// \param  proxyShape the ProxyShape to query
+    /// \param  paths a sequence of SdfPaths (or path strings)
+    /// \return a list holding the name of the maya transform for each path (or None if the path is not required)
+    static boost::python::list findRequiredPaths(const ProxyShape& proxyShape, const object& paths)
+    {
+      const SdfPathVector pathVec = toPathVector(paths);
+      boost::python::list result;
+      for(const SdfPath& path : pathVec)
+      {
+        MObject obj = proxyShape.findRequiredPath(path);
+        if(obj.isNull())
+        {
+          result.append(object());
+          continue;
+        }
+        MString desc = MString("from SdfPath '") + path.GetText() + "'";
+        result.append(MobjToName(obj, desc));
+      }
+      return result;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Computes the maya world space bounds of a set of prims at the current time of the proxy shape, i.e. the
+    ///         stage space bounds transformed by the world matrix of the proxy shape. The purposes included match those
+    ///         drawn by the proxy shape.
+    /// \param  proxyShape the ProxyShape to query
+    /// \param  paths a sequence of SdfPaths (or path strings)
+    /// \return a bytearray holding 6 doubles per path (minX, minY, minZ, maxX, maxY, maxZ). Paths that do not resolve
+    ///         to a valid prim return an empty box (min > max).
+    static object boundingBoxes(const ProxyShape& proxyShape, const object& paths)
+    {
+      const SdfPathVector pathVec = toPathVector(paths);
+      char* data = nullptr;
+      object result = makeByteArray(pathVec.size() * sizeof(double) * 6, data);
+
+      TfTokenVector purposes;
+      purposes.push_back(UsdGeomTokens->default_);
+      purposes.push_back(UsdGeomTokens->proxy);
+      if(proxyShape.displayGuidesPlug().asBool())
+        purposes.push_back(UsdGeomTokens->guide);
+      if(proxyShape.displayRenderGuidesPlug().asBool())
+        purposes.push_back(UsdGeomTokens->render);
+
+      const GfMatrix4d proxyMatrix = proxyWorldMatrix(proxyShape);
+      UsdStageRefPtr stage = proxyShape.getUsdStage();
+      UsdGeomBBoxCache cache(UsdTimeCode(proxyShape.outTimePlug().asMTime().as(MTime::uiUnit())), purposes, true);
+      for(size_t i = 0, n = pathVec.size(); i < n; ++i)
+      {
+        GfRange3d range;
+        UsdPrim prim = stage ? stage->GetPrimAtPath(pathVec[i]) : UsdPrim();
+        if(prim)
+        {
+          GfBBox3d bbox = cache.ComputeWorldBound(prim);
+          bbox.Transform(proxyMatrix);
+          range = bbox.ComputeAlignedRange();
+        }
+        const double bounds[6] = {
+          range.GetMin()[0], range.GetMin()[1], range.GetMin()[2],
+          range.GetMax()[0], range.GetMax()[1], range.GetMax()[2]
+        };
+        std::memcpy(data + i * sizeof(bounds), bounds, sizeof(bounds));
+      }
+      return result;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Computes the local to maya world space matrices of a set of prims at the current time of the proxy shape,
+    ///         i.e. the stage space matrices multiplied by the world matrix of the proxy shape.
+    /// \param  proxyShape the ProxyShape to query
+    /// \param  paths a sequence of SdfPaths (or path strings)
+    /// \return a bytearray holding 16 doubles per path, in row major order (matching GfMatrix4d and MMatrix). Paths
+    ///         that do not resolve to a valid prim return the world matrix of the proxy shape.
+    static object worldMatrices(const ProxyShape& proxyShape, const object& paths)
+    {
+      const SdfPathVector pathVec = toPathVector(paths);
+      char* data = nullptr;
+      object result = makeByteArray(pathVec.size() * sizeof(GfMatrix4d), data);
+
+      const GfMatrix4d proxyMatrix = proxyWorldMatrix(proxyShape);
+      UsdStageRefPtr stage = proxyShape.getUsdStage();
+      UsdGeomXformCache cache(UsdTimeCode(proxyShape.outTimePlug().asMTime().as(MTime::uiUnit())));
+      for(size_t i = 0, n = pathVec.size(); i < n; ++i)
+      {
+        GfMatrix4d matrix = proxyMatrix;
+        UsdPrim prim = stage ? stage->GetPrimAtPath(pathVec[i]) : UsdPrim();
+        if(prim)
+        {
+          matrix = cache.GetLocalToWorldTransform(prim) * proxyMatrix;
+        }
+        std::memcpy(data + i * sizeof(GfMatrix4d), matrix.GetArray(), sizeof(GfMatrix4d));
+      }
+      return result;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Reports the element counts and approximate heap sizes of the caches held by the proxy shape (and by the
+    ///         layer manager), see ProxyShape::memoryUsage
+    /// \param  proxyShape the ProxyShape to query
+    /// \return a dict mapping each structure name to a (count, bytes) tuple
+    static boost::python::dict memoryUsage(const ProxyShape& proxyShape)
+    {
+      MemoryUsage usage;
+      proxyShape.memoryUsage(usage);
+      if(LayerManager* layerManager = LayerManager::findManager())
+      {
+        layerManager->memoryUsage(usage);
+      }
+
+      boost::python::dict result;
+      for(const auto& entry : usage)
+      {
+        result[entry.name] = boost::python::make_tuple(entry.count, entry.bytes);
+      }
+      return result;
+    }
+
     //------------------------------------------------------------------------------------------------------------------
     /// \brief  Utility method, for better readability, that returns whether given MObject is a ProxyShape
     static bool isProxyShape(MObject mobj)
@@ -395,6 +597,15 @@ void wrapProxyShape()
     .def("boundingBox", PyProxyShape::boundingBox)
     .def("isRequiredPath", &ProxyShape::isRequiredPath)
     .def("findRequiredPath", PyProxyShape::findRequiredPath)
+    .def("isRequiredPaths", PyProxyShape::isRequiredPaths,
+        (boost::python::arg("paths")))
+    .def("findRequiredPaths", PyProxyShape::findRequiredPaths,
+        (boost::python::arg("paths")))
+    .def("boundingBoxes", PyProxyShape::boundingBoxes,
+        (boost::python::arg("paths")))
+    .def("worldMatrices", PyProxyShape::worldMatrices,
+        (boost::python::arg("paths")))
+    .def("memoryUsage", PyProxyShape::memoryUsage)
     .def("makeUsdTransformChain", PyProxyShape::makeUsdTransformChain,
         (boost::python::arg("usdPrim"),
          boost::python::arg("reason")=ProxyShape::kRequested,
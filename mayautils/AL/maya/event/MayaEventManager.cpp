@@ -610,7 +610,8 @@ bool MayaEventHandler::registerEvent(
   AL::event::EventType eventType,
   MayaMessageType messageType,
   MayaCallbackType callbackType,
-  uint32_t mmessageEnum)
+  uint32_t mmessageEnum,
+  const MString& nodeType)
 {
   // first register the new event with the scheduler
   AL::event::EventId id = scheduler->registerEvent(eventName, eventType);
@@ -627,7 +628,8 @@ bool MayaEventHandler::registerEvent(
     messageType,
     callbackType,
     mmessageEnum,
-    0
+    0,
+    nodeType
   };
   m_callbacks.push_back(cb);
   m_eventMapping[id] = index;
@@ -635,6 +637,37 @@ bool MayaEventHandler::registerEvent(
   return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+AL::event::EventId MayaEventHandler::nodeTypeEvent(const char* const eventName, const char* const nodeType)
+{
+  const MayaCallbackInfo* info = getEventInfo(eventName);
+  if(!info || !nodeType || !*nodeType)
+    return 0;
+
+  if(info->mayaMessageType != MayaMessageType::kDGMessage ||
+     (info->mmessageEnum != DGMessage::kNodeAdded && info->mmessageEnum != DGMessage::kNodeRemoved) ||
+     info->nodeType.length())
+  {
+    std::cerr << "unable to filter maya event " << eventName << " by node type" << std::endl;
+    return 0;
+  }
+
+  const std::string filteredName = std::string(eventName) + ":" + nodeType;
+  const AL::event::EventDispatcher* const dispatcher = m_scheduler->event(filteredName.c_str());
+  if(dispatcher)
+  {
+    return dispatcher->eventId();
+  }
+
+  const AL::event::EventType eventType = m_scheduler->event(eventName)->eventType();
+  if(!registerEvent(m_scheduler, filteredName.c_str(), eventType, info->mayaMessageType, info->mayaCallbackType,
+                    info->mmessageEnum, MString(nodeType)))
+  {
+    return 0;
+  }
+  return m_callbacks.back().eventId;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void MayaEventHandler::onCallbackCreated(const AL::event::CallbackId callbackId)
 {
@@ -823,8 +856,8 @@ void MayaEventHandler::initDGMessage(MayaCallbackInfo& cbi)
   case DGMessage::kDelayedTimeChange: cbi.mayaCallback = MDGMessage::addDelayedTimeChangeCallback(bindTimeFunction, &cbi); break;
   case DGMessage::kDelayedTimeChangeRunup: cbi.mayaCallback = MDGMessage::addDelayedTimeChangeRunupCallback(bindTimeFunction, &cbi); break;
   case DGMessage::kForceUpdate: cbi.mayaCallback = MDGMessage::addForceUpdateCallback(bindTimeFunction, &cbi); break;
-  case DGMessage::kNodeAdded: cbi.mayaCallback = MDGMessage::addNodeAddedCallback(bindNodeFunction, kDefaultNodeType, &cbi); break;
-  case DGMessage::kNodeRemoved: cbi.mayaCallback = MDGMessage::addNodeRemovedCallback(bindNodeFunction, kDefaultNodeType, &cbi); break;
+  case DGMessage::kNodeAdded: cbi.mayaCallback = MDGMessage::addNodeAddedCallback(bindNodeFunction, cbi.nodeType.length() ? cbi.nodeType : kDefaultNodeType, &cbi); break;
+  case DGMessage::kNodeRemoved: cbi.mayaCallback = MDGMessage::addNodeRemovedCallback(bindNodeFunction, cbi.nodeType.length() ? cbi.nodeType : kDefaultNodeType, &cbi); break;
   case DGMessage::kConnection: cbi.mayaCallback = MDGMessage::addConnectionCallback(bindPlugFunction, &cbi); break;
   case DGMessage::kPreConnection: cbi.mayaCallback = MDGMessage::addPreConnectionCallback(bindPlugFunction, &cbi); break;
   default: break;
@@ -834,14 +867,14 @@ void MayaEventHandler::initDGMessage(MayaCallbackInfo& cbi)
 //----------------------------------------------------------------------------------------------------------------------
 void MayaEventHandler::registerDGMessages(AL::event::EventScheduler* scheduler, AL::event::EventType eventType)
 {
-  registerEvent(scheduler, "TimeChange", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kTimeFunction, DGMessage::kTimeChange);
-  registerEvent(scheduler, "DelayedTimeChange", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kTimeFunction, DGMessage::kDelayedTimeChange);
-  registerEvent(scheduler, "DelayedTimeChangeRunup", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kTimeFunction, DGMessage::kDelayedTimeChangeRunup);
-  registerEvent(scheduler, "ForceUpdate", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kTimeFunction, DGMessage::kForceUpdate);
-  registerEvent(scheduler, "NodeAdded", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kNodeFunction, DGMessage::kNodeAdded);
-  registerEvent(scheduler, "NodeRemoved", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kNodeFunction, DGMessage::kNodeRemoved);
-  registerEvent(scheduler, "Connection", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kPlugFunction, DGMessage::kConnection);
-  registerEvent(scheduler, "PreConnection", eventType, MayaMessageType::kDagMessage, MayaCallbackType::kPlugFunction, DGMessage::kPreConnection);
+  registerEvent(scheduler, "TimeChange", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kTimeFunction, DGMessage::kTimeChange);
+  registerEvent(scheduler, "DelayedTimeChange", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kTimeFunction, DGMessage::kDelayedTimeChange);
+  registerEvent(scheduler, "DelayedTimeChangeRunup", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kTimeFunction, DGMessage::kDelayedTimeChangeRunup);
+  registerEvent(scheduler, "ForceUpdate", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kTimeFunction, DGMessage::kForceUpdate);
+  registerEvent(scheduler, "NodeAdded", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kNodeFunction, DGMessage::kNodeAdded);
+  registerEvent(scheduler, "NodeRemoved", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kNodeFunction, DGMessage::kNodeRemoved);
+  registerEvent(scheduler, "Connection", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kPlugFunction, DGMessage::kConnection);
+  registerEvent(scheduler, "PreConnection", eventType, MayaMessageType::kDGMessage, MayaCallbackType::kPlugFunction, DGMessage::kPreConnection);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1158,6 +1191,21 @@ AL::event::CallbackId MayaEventManager::registerCallbackInternal(
   return scheduler->registerCallback(id, tag, func, weight, userData);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+AL::event::CallbackId MayaEventManager::registerNodeTypeCallback(
+    MMessage::MNodeFunction func,
+    const char* const eventName,
+    const char* const nodeType,
+    const char* const tag,
+    const uint32_t weight,
+    void* const userData)
+{
+  const AL::event::EventId id = m_mayaEvents->nodeTypeEvent(eventName, nodeType);
+  if(!id)
+    return 0;
+  return m_mayaEvents->scheduler()->registerCallback(id, tag, (const void*)func, weight, userData);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MayaEventHandler::~MayaEventHandler()
 {
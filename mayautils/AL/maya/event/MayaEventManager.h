@@ -17,12 +17,14 @@
 
 #include "./Api.h"
 
+#include <deque>
 #include <string>
 #include <vector>
 #include "maya/MCommandMessage.h"
 #include "maya/MDagMessage.h"
 #include "maya/MPaintMessage.h"
 #include "maya/MSceneMessage.h"
+#include "maya/MString.h"
 
 #include "AL/event/EventHandler.h"
 
@@ -377,6 +379,7 @@ public:
     MayaCallbackType mayaCallbackType; ///< the type of C callback function needed to execute the callback
     uint32_t mmessageEnum; ///< the enum value from one of the MSceneMessage / MEventMessage etc classes.
     MCallbackId mayaCallback; ///< the maya callback ID
+    MString nodeType; ///< the node type filter for the NodeAdded / NodeRemoved events (empty for all node types)
   };
 
   /// \brief  constructor function
@@ -405,7 +408,7 @@ public:
   {
     const auto it = m_eventMapping.find(event);
     if(it == m_eventMapping.end()) return 0;
-    return m_callbacks.data() + it->second;
+    return &m_callbacks[it->second];
   }
 
   /// \brief  queries whether the event has an associated MCallbackId (indicating the callback is active with maya)
@@ -439,6 +442,16 @@ public:
     return cbi ? cbi->refCount != 0 : false;
   }
 
+  /// \brief  returns the event that is only triggered for nodes of the specified type. The first time a node type is
+  ///         requested, a new event named "<eventName>:<nodeType>" is registered. Each of these events installs its
+  ///         own maya callback with the node type filter, so callbacks registered against them are never dispatched
+  ///         for nodes of any other type.
+  /// \param  eventName the node event, either "NodeAdded" or "NodeRemoved"
+  /// \param  nodeType the maya node type name, e.g. "transform"
+  /// \return the id of the filtered event, or 0 if the event does not support a node type filter
+  AL_MAYA_EVENTS_PUBLIC
+  AL::event::EventId nodeTypeEvent(const char* const eventName, const char* const nodeType);
+
 private:
   void onCallbackCreated(const AL::event::CallbackId callbackId) override;
   void onCallbackDestroyed(const AL::event::CallbackId callbackId) override;
@@ -448,7 +461,8 @@ private:
       AL::event::EventType eventType,
       MayaMessageType messageType,
       MayaCallbackType callbackType,
-      uint32_t mmessageEnum);
+      uint32_t mmessageEnum,
+      const MString& nodeType = MString());
   void initEvent(MayaCallbackInfo& cbi);
   void initAnimMessage(MayaCallbackInfo& cbi);
   void initCameraSetMessage(MayaCallbackInfo& cbi);
@@ -484,7 +498,9 @@ private:
   void registerSceneMessages(AL::event::EventScheduler* scheduler, AL::event::EventType eventType);
   void registerTimerMessages(AL::event::EventScheduler* scheduler, AL::event::EventType eventType);
   void registerUiMessages(AL::event::EventScheduler* scheduler, AL::event::EventType eventType);
-  std::vector<MayaCallbackInfo> m_callbacks;
+  // the addresses of the entries are handed to maya as client data, and node type events are added on demand, so this
+  // must not relocate its elements when it grows.
+  std::deque<MayaCallbackInfo> m_callbacks;
   EventToMaya m_eventMapping;
   AL::event::EventScheduler* m_scheduler;
 };
@@ -905,6 +921,17 @@ public:
   AL::event::CallbackId registerCallback(MPaintMessage::MPathObjectPlugColorsFunction func, const char* const eventName, const char* const tag, uint32_t weight, void* userData = 0)
     { return registerCallbackInternal((void*)func, MayaCallbackType::kPathObjectPlugColoursFunction, eventName, tag, weight, userData); }
 
+  /// \brief  registers a C++ callback against a maya node event, that is only triggered for nodes of a given type
+  /// \param  func the C++ function
+  /// \param  eventName the event, either "NodeAdded" or "NodeRemoved"
+  /// \param  nodeType the maya node type the callback is interested in, e.g. "transform"
+  /// \param  tag the unique tag for the callback
+  /// \param  weight the weight (lower weights at executed before higher weights)
+  /// \param  userData custom user data pointer
+  /// \return the callback id
+  AL_MAYA_EVENTS_PUBLIC
+  AL::event::CallbackId registerNodeTypeCallback(MMessage::MNodeFunction func, const char* const eventName, const char* const nodeType, const char* const tag, uint32_t weight, void* userData = 0);
+
   /// \brief  unregisters the callback id
   /// \param  id the callback id to unregister
   bool unregisterCallback(AL::event::CallbackId id)
@@ -33,9 +33,11 @@ MStatus initializePlugin(MObject obj)
   AL_REGISTER_DEPEND_NODE(plugin, AL::maya::tests::utils::NodeHelperUnitTest);
   AL_REGISTER_COMMAND(plugin, AL::maya::tests::utils::CommandGuiHelperTestCMD);
   AL_REGISTER_COMMAND(plugin, UnitTestHarness);
+  AL_REGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
+  AL_REGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiDeferredEval);
+  AL::maya::utils::MenuBuilder::setDeferredEvalCommand(AL::maya::utils::CommandGuiDeferredEval::kName);
   AL::maya::tests::utils::CommandGuiHelperTestCMD::makeGUI();
 
-  AL_REGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
   CHECK_MSTATUS(AL::maya::utils::MenuBuilder::generatePluginUI(plugin, "mayaplugintest"));
   return status;
 }
@@ -49,6 +51,9 @@ MStatus uninitializePlugin(MObject obj)
 
   MStatus status;
   AL_UNREGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiListGen);
+  AL_UNREGISTER_COMMAND(plugin, AL::maya::utils::CommandGuiDeferredEval);
+  AL::maya::utils::MenuBuilder::setDeferredEvalCommand(MString());
+  AL::maya::utils::MenuBuilder::clearDeferredSources();
   return status;
 }
 
@@ -14,9 +14,13 @@
 // limitations under the License.
 //
 //#include "test_usdmaya.h"
+#include "AL/maya/utils/CommandGuiHelper.h"
 #include "AL/maya/utils/MenuBuilder.h"
+#include "AL/maya/test/testHelpers.h"
 #include <gtest/gtest.h>
 
+#include <string>
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  Test USD to attribute enum mappings
 //----------------------------------------------------------------------------------------------------------------------
@@ -255,4 +259,145 @@ TEST(maya_MenuBuilder, simpleRadioButton)
   EXPECT_TRUE(item2.radioButtonValue);
 
   AL::maya::utils::MenuBuilder::clearRootMenus();
-}
\ No newline at end of file
+}
+namespace {
+using AL::maya::utils::CommandGuiHelper;
+using AL::maya::utils::MenuBuilder;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+// stands in for MFnPlugin when generating the plugin UI
+struct MockPlugin
+{
+  MStatus registerUI(const MString& initProc, const MString& exitProc)
+  {
+    ++numCalls;
+    return MS::kSuccess;
+  }
+  int numCalls = 0;
+};
+
+// restores the GUI generation mode at the end of a test
+struct ScopedGuiGeneration
+{
+  ScopedGuiGeneration(MenuBuilder::GuiGeneration generation)
+    : m_previous(MenuBuilder::guiGeneration())
+    { MenuBuilder::setGuiGeneration(generation); }
+  ~ScopedGuiGeneration()
+    { MenuBuilder::setGuiGeneration(m_previous); }
+  MenuBuilder::GuiGeneration m_previous;
+};
+
+bool procExists(const std::string& proc)
+{
+  int result = 0;
+  MGlobal::executeCommand(MString("exists ") + proc.c_str(), result);
+  return result != 0;
+}
+
+// roughly the number and size of the option boxes registered by AL_USDMaya
+void makeCommandGuis(const std::string& prefix, uint32_t numCommands)
+{
+  const char* const enumNames[] = { "never", "eat", "shredded", "wheat", 0 };
+  for(uint32_t i = 0; i < numCommands; ++i)
+  {
+    const std::string name = prefix + std::to_string(i);
+    const std::string menuPath = "FOO/" + prefix + "/" + name;
+    CommandGuiHelper gui(name.c_str(), name.c_str(), "Go", menuPath.c_str());
+    gui.addFlagOption("flag", "Flag", false, false);
+    gui.addBoolOption("bool", "Bool", true, false);
+    gui.addIntOption("int", "Int", 42, false);
+    gui.addDoubleOption("double", "Double", 2.3, false);
+    gui.addVec3Option("vec3", "Vec3", 0.5, 0.6, 0.9, false);
+    gui.addEnumOption("enum", "Enum", 0, enumNames, 0, false, false);
+    gui.addStringOption("string", "String", "hello", false);
+    gui.addFilePathOption("file", "File", CommandGuiHelper::kLoad);
+  }
+}
+}
+
+// In deferred mode, neither the option box procedures nor the menu contents exist until they are first requested
+TEST(maya_MenuBuilder, deferredGuiGeneration)
+{
+  ScopedGuiGeneration scope(MenuBuilder::kGuiDeferred);
+  MenuBuilder::clearRootMenus();
+  makeCommandGuis("deferredGui", 1);
+
+  EXPECT_TRUE(MenuBuilder::hasDeferredSource("deferredGui0"));
+  EXPECT_FALSE(procExists("build_deferredGui0_optionGUI"));
+  EXPECT_FALSE(procExists("execute_deferredGui0_optionGUI"));
+
+  // the menu items ensure the procedures are evaluated before calling them
+  const MenuBuilder::MenuItem& item = MenuBuilder::rootMenus().begin()->childMenus().begin()->menuItems()[0];
+  EXPECT_EQ(std::string("AL_usdmaya_CommandGuiDeferredEval -p execute_deferredGui0_optionGUI deferredGui0"), item.command);
+  EXPECT_EQ(std::string("AL_usdmaya_CommandGuiDeferredEval -p build_deferredGui0_optionGUI deferredGui0"), item.optionBox);
+
+  EXPECT_TRUE(MGlobal::executeCommand("AL_usdmaya_CommandGuiDeferredEval deferredGui0"));
+  EXPECT_FALSE(MenuBuilder::hasDeferredSource("deferredGui0"));
+  EXPECT_TRUE(procExists("build_deferredGui0_optionGUI"));
+  EXPECT_TRUE(procExists("init_deferredGui0_optionGUI"));
+  EXPECT_TRUE(procExists("execute_deferredGui0_optionGUI"));
+  EXPECT_TRUE(procExists("alFileDialogHandler"));
+
+  // evaluating it again is a no-op, and unknown sources are an error
+  EXPECT_TRUE(MGlobal::executeCommand("AL_usdmaya_CommandGuiDeferredEval deferredGui0"));
+  EXPECT_FALSE(MGlobal::executeCommand("AL_usdmaya_CommandGuiDeferredEval deferredGuiUnknown"));
+
+  // the init script only creates the top level menu, and keeps its contents until the menu is opened
+  MockPlugin plugin;
+  EXPECT_TRUE(MenuBuilder::generatePluginUI(plugin, "deferredGuiTest"));
+  EXPECT_EQ(1, plugin.numCalls);
+  EXPECT_TRUE(procExists("deferredGuiTest_initGUI"));
+  EXPECT_TRUE(MenuBuilder::hasDeferredSource("FOOdeferredGuiTest"));
+  EXPECT_TRUE(MenuBuilder::rootMenus().empty());
+}
+
+// In batch mode, no GUI code is generated at all
+TEST(maya_MenuBuilder, skippedGuiGeneration)
+{
+  ScopedGuiGeneration scope(MenuBuilder::kGuiSkip);
+  MenuBuilder::clearRootMenus();
+  makeCommandGuis("skippedGui", 1);
+  {
+    CommandGuiHelper checkBox("skippedGuiCheckBox", "FOO/skippedGui/CheckBox", true);
+  }
+
+  EXPECT_FALSE(MenuBuilder::hasDeferredSource("skippedGui0"));
+  EXPECT_FALSE(procExists("build_skippedGui0_optionGUI"));
+  EXPECT_TRUE(MenuBuilder::rootMenus().empty());
+  // procedures used by a menu item may also be used by scripts, so they are still sourced
+  EXPECT_TRUE(MenuBuilder::addSourcedEntry("FOO/skippedGui/Sourced", "skippedGuiProc", "skippedGuiProc", "global proc skippedGuiProc() {}") == nullptr);
+  EXPECT_TRUE(procExists("skippedGuiProc"));
+
+  MockPlugin plugin;
+  EXPECT_TRUE(MenuBuilder::generatePluginUI(plugin, "skippedGuiTest"));
+  EXPECT_EQ(0, plugin.numCalls);
+  EXPECT_FALSE(procExists("skippedGuiTest_initGUI"));
+}
+
+// Times the GUI generation done during plugin load for the immediate, deferred and batch modes
+TEST(maya_MenuBuilder, pluginLoadGuiTiming)
+{
+  const uint32_t numCommands = 27;
+  const MenuBuilder::GuiGeneration modes[] = { MenuBuilder::kGuiImmediate, MenuBuilder::kGuiDeferred, MenuBuilder::kGuiSkip };
+  const char* const names[] = { "immediate", "deferred", "batch" };
+  for(int i = 0; i < 3; ++i)
+  {
+    ScopedGuiGeneration scope(modes[i]);
+    MenuBuilder::clearRootMenus();
+    const std::string prefix = std::string(names[i]) + "LoadTiming";
+
+    const double loadTime = timeMilliseconds([&] ()
+    {
+      makeCommandGuis(prefix, numCommands);
+      MockPlugin plugin;
+      EXPECT_TRUE(MenuBuilder::generatePluginUI(plugin, (prefix + "Test").c_str()));
+    });
+
+    EXPECT_EQ(modes[i] == MenuBuilder::kGuiImmediate, procExists("build_" + prefix + "0_optionGUI"));
+    EXPECT_EQ(modes[i] != MenuBuilder::kGuiSkip, procExists(prefix + "Test_initGUI"));
+    printTimings("MenuBuilder GUI generation for " + std::to_string(numCommands) + " commands",
+                 { { names[i], loadTime } });
+  }
+  MenuBuilder::clearRootMenus();
+}
@@ -14,6 +14,7 @@
 // limitations under the License.
 //
 #include "AL/maya/utils/CommandGuiHelper.h"
+#include "AL/maya/utils/MenuBuilder.h"
 #include "AL/maya/tests/mayaplugintest/utils/CommandGuiHelperTest.h"
 
 #include "maya/MString.h"
@@ -329,6 +330,10 @@ MStatus CommandGuiHelperTestCMD::doIt(const MArgList& args)
 //----------------------------------------------------------------------------------------------------------------------
 bool test_CommandGuiHelper()
 {
+  // the option box procedures are called directly below, so make sure they are evaluated straight away
+  const AL::maya::utils::MenuBuilder::GuiGeneration generation = AL::maya::utils::MenuBuilder::guiGeneration();
+  AL::maya::utils::MenuBuilder::setGuiGeneration(AL::maya::utils::MenuBuilder::kGuiImmediate);
+
   const MString polyCube_constructionHistory = MString("polyCube_constructionHistory");
   const MString polyCube_width = MString("polyCube_width");
   const MString polyCube_height = MString("polyCube_height");
@@ -480,6 +485,7 @@ bool test_CommandGuiHelper()
     if(MGlobal::optionVarExists(polyCube_name)) MGlobal::removeOptionVar(polyCube_name);
     if(MGlobal::optionVarExists(polyCube_axis)) MGlobal::removeOptionVar(polyCube_axis);
   }
+  AL::maya::utils::MenuBuilder::setGuiGeneration(generation);
   return result;
 }
 
@@ -91,35 +91,98 @@ MStatus CommandGuiListGen::doIt(const MArgList& args)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* menuItemPath, bool checkBoxValue) : m_checkBoxCommand(true)
+AL_MAYA_DEFINE_COMMAND(CommandGuiDeferredEval, AL_usdmaya);
+
+//----------------------------------------------------------------------------------------------------------------------
+MSyntax CommandGuiDeferredEval::createSyntax()
+{
+  MSyntax syn;
+  syn.addFlag("-p", "-proc", MSyntax::kString);
+  syn.addArg(MSyntax::kString);
+  return syn;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus CommandGuiDeferredEval::doIt(const MArgList& args)
+{
+  MStatus status;
+  MArgDatabase database(syntax(), args, &status);
+  if(!status)
+  {
+    return status;
+  }
+
+  MString key;
+  if(!database.getCommandArgument(0, key))
+  {
+    return MS::kFailure;
+  }
+
+  status = MenuBuilder::evaluateDeferredSource(key.asChar());
+  if(status == MS::kNotFound)
+  {
+    MGlobal::displayError(MString("No deferred GUI has been registered for \"") + key + "\"");
+    return MS::kFailure;
+  }
+
+  if(status && database.isFlagSet("-p"))
+  {
+    MString proc;
+    database.getFlagArgument("-p", 0, proc);
+    status = MGlobal::executeCommand(proc);
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* menuItemPath, bool checkBoxValue)
+  : m_checkBoxCommand(true), m_skipGui(MenuBuilder::guiGeneration() == MenuBuilder::kGuiSkip)
 {
   m_hasFilePath = false;
 
   // insert into the main menu
-  MenuBuilder::addEntry(menuItemPath, commandName, true, checkBoxValue);
+  if(!m_skipGui)
+  {
+    MenuBuilder::addEntry(menuItemPath, commandName, true, checkBoxValue);
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* windowTitle, const char* doitLabel, const char* menuItemPath, bool hasOptionBox) : m_checkBoxCommand(false)
+CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* windowTitle, const char* doitLabel, const char* menuItemPath, bool hasOptionBox)
+  : m_checkBoxCommand(false), m_skipGui(MenuBuilder::guiGeneration() == MenuBuilder::kGuiSkip)
 {
   m_hasFilePath = false;
   m_commandName = commandName;
-  // generate and execute the main option box routine
+
+  // in batch mode, there is no menu to add the GUI to
+  if(m_skipGui)
+  {
+    return;
+  }
+
+  // generate the main option box routine
   std::string mycmd_optionGUI = commandName;
   mycmd_optionGUI += "_optionGUI";
 
-  // insert into the main menu
+  // insert into the main menu. If the GUI is deferred, the menu items make sure the procedures exist before calling them.
+  std::string executeCommand = std::string("execute_") + mycmd_optionGUI;
+  std::string buildCommand = std::string("build_") + mycmd_optionGUI;
+  if(MenuBuilder::guiGeneration() == MenuBuilder::kGuiDeferred)
+  {
+    const std::string deferredEval = std::string(MenuBuilder::deferredEvalCommand().asChar()) + " -p ";
+    executeCommand = deferredEval + executeCommand + " " + commandName;
+    buildCommand = deferredEval + buildCommand + " " + commandName;
+  }
   if(hasOptionBox)
   {
-    MenuBuilder::addEntry(menuItemPath, (std::string("execute_") + mycmd_optionGUI).c_str(), (std::string("build_") + mycmd_optionGUI).c_str());
+    MenuBuilder::addEntry(menuItemPath, executeCommand.c_str(), buildCommand.c_str());
   }
   else
   {
-    MenuBuilder::addEntry(menuItemPath, (std::string("build_") + mycmd_optionGUI).c_str());
+    MenuBuilder::addEntry(menuItemPath, buildCommand.c_str());
   }
 
-  std::ostringstream ui;
-  ui << "global proc build_" << mycmd_optionGUI << "()\n"
+  m_window << "global proc build_" << mycmd_optionGUI << "()\n"
         "{\n"
         "  if(`window -q -ex \"" << mycmd_optionGUI << "\"`)\n"
         "  {\n"
@@ -166,14 +229,6 @@ CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* windowTi
         "  showWindow;\n"
         "}\n";
 
-  MGlobal::executeCommand(MString(ui.str().data(), ui.str().length()));
-
-  // if you want to validate the output code
-  if (AL_MAYAUTILS_DEBUG)
-  {
-    std::cout << ui.str() + "\n" << std::endl;
-  }
-
   // begin construction of the 6 utils functions for this dialog
   m_init << "global proc init_" << mycmd_optionGUI << "()\n{\n";
   m_save << "global proc save_" << mycmd_optionGUI << "()\n{\n";
@@ -187,7 +242,7 @@ CommandGuiHelper::CommandGuiHelper(const char* commandName, const char* windowTi
 //----------------------------------------------------------------------------------------------------------------------
 CommandGuiHelper::~CommandGuiHelper()
 {
-  if (m_checkBoxCommand)
+  if (m_checkBoxCommand || m_skipGui)
   {
     return;
   }
@@ -204,6 +259,7 @@ CommandGuiHelper::~CommandGuiHelper()
   // if you want to validate the output code
   if (AL_MAYAUTILS_DEBUG)
   {
+    std::cout << m_window.str() + "\n"   << std::endl;
     std::cout << m_global.str() + "\n"   << std::endl;
     std::cout << m_init.str() + "\n"     << std::endl;
     std::cout << m_save.str() + "\n"     << std::endl;
@@ -228,20 +284,30 @@ CommandGuiHelper::~CommandGuiHelper()
     "}\n";
 
   // if we happen to have a file dialog knocking about in our GUI, ensure the handler is available.
+  std::string source;
   if(m_hasFilePath)
   {
-    MGlobal::executeCommand(alFileDialogHandler);
+    source += alFileDialogHandler;
+  }
+  source += m_window.str();
+  source += m_global.str();
+  source += m_init.str();
+  source += m_save.str();
+  source += m_load.str();
+  source += m_reset.str();
+  source += m_execute.str();
+  source += m_labels.str();
+  source += m_controls.str();
+
+  // and execute them, or wait until the menu item or option box is first used
+  if(MenuBuilder::guiGeneration() == MenuBuilder::kGuiDeferred)
+  {
+    MenuBuilder::addDeferredSource(m_commandName, std::move(source));
+  }
+  else
+  {
+    MGlobal::executeCommand(MString(source.data(), source.size()));
   }
-
-  // and execute them
-  MGlobal::executeCommand(MString(m_global.str().data(), m_global.str().size()));
-  MGlobal::executeCommand(MString(m_init.str().data(), m_init.str().size()));
-  MGlobal::executeCommand(MString(m_save.str().data(), m_save.str().size()));
-  MGlobal::executeCommand(MString(m_load.str().data(), m_load.str().size()));
-  MGlobal::executeCommand(MString(m_reset.str().data(), m_reset.str().size()));
-  MGlobal::executeCommand(MString(m_execute.str().data(), m_execute.str().size()));
-  MGlobal::executeCommand(MString(m_labels.str().data(), m_labels.str().size()));
-  MGlobal::executeCommand(MString(m_controls.str().data(), m_controls.str().size()));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
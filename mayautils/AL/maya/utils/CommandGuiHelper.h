@@ -60,6 +60,22 @@ private:
   static std::vector<std::pair<MString, GenerateListFn>> m_funcs;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A method used by the generated menus to evaluate the MEL for a menu or command GUI the first time it is
+///         needed (see AL::maya::utils::MenuBuilder::addDeferredSource), and then optionally call a procedure from it.
+///         e.g. "AL_usdmaya_CommandGuiDeferredEval -p build_polyCube_optionGUI polyCube"
+/// \ingroup mayagui
+//----------------------------------------------------------------------------------------------------------------------
+class CommandGuiDeferredEval
+  : public MPxCommand
+{
+public:
+  AL_MAYA_DECLARE_COMMAND();
+private:
+  bool isUndoable() const override { return false; }
+  MStatus doIt(const MArgList& args) override;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  This class isn't really a wrapper around command options as such, it's mainly just a helper
 ///         to auto generate some GUI code to create a menu item + option box dialog.
@@ -95,6 +111,11 @@ private:
 /// If the above code is called somewhere within your initialisePlugin method, and you end up calling
 /// AL::maya::MenuBuilder::generatePluginUI() at the end of your initialise method, then that command (+optionBox) will
 /// be available on the main maya menu.
+///
+/// By default the MEL procedures for the option box are only evaluated when the menu item or option box is first used,
+/// and are not generated at all in batch mode (see AL::maya::utils::MenuBuilder::guiGeneration). The plugin must
+/// register the CommandGuiDeferredEval command, and pass its name to MenuBuilder::setDeferredEvalCommand, for the GUIs
+/// to be deferred.
 /// \ingroup mayagui
 //----------------------------------------------------------------------------------------------------------------------
 class CommandGuiHelper
@@ -137,7 +158,7 @@ public:
   AL_MAYA_UTILS_PUBLIC
   CommandGuiHelper(const char* commandName, const char* menuItemPath, bool checkBoxValue = false);
 
-  /// \brief  dtor - auto generates, and executes the GUI code.
+  /// \brief  dtor - auto generates the GUI code, and executes it (or defers it until the GUI is first displayed).
   AL_MAYA_UTILS_PUBLIC
   ~CommandGuiHelper();
 
@@ -437,6 +458,7 @@ public:
   void addFilePathOption(const char* commandFlag, const char* label, FileMode fileMode, const char* filter = "All files (*) (*)", StringPolicy policy = kStringOptional);
 
 private:
+  std::ostringstream m_window;
   std::ostringstream m_global;
   std::ostringstream m_init;
   std::ostringstream m_save;
@@ -448,6 +470,7 @@ private:
   std::string m_commandName;
   bool m_hasFilePath;
   bool m_checkBoxCommand;
+  bool m_skipGui;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
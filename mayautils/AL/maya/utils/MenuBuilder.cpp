@@ -23,6 +23,86 @@ namespace maya {
 namespace utils {
 //----------------------------------------------------------------------------------------------------------------------
 std::set<MenuBuilder::Menu> MenuBuilder::m_menus;
+std::unordered_map<std::string, MenuBuilder::DeferredSource> MenuBuilder::m_deferredSources;
+
+MString MenuBuilder::m_deferredEvalCommand;
+
+namespace {
+// -1 until the generation has been set, or determined from the maya state
+int g_guiGeneration = -1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MenuBuilder::GuiGeneration MenuBuilder::guiGeneration()
+{
+  if(g_guiGeneration < 0)
+  {
+    g_guiGeneration = MGlobal::mayaState() == MGlobal::kInteractive ? kGuiDeferred : kGuiSkip;
+  }
+
+  // without a command to evaluate the deferred code, the GUI can only be generated up front
+  if(g_guiGeneration == kGuiDeferred && !m_deferredEvalCommand.length())
+  {
+    return kGuiImmediate;
+  }
+  return GuiGeneration(g_guiGeneration);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MenuBuilder::setDeferredEvalCommand(const MString& command)
+{
+  m_deferredEvalCommand = command;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MenuBuilder::setGuiGeneration(GuiGeneration generation)
+{
+  g_guiGeneration = generation;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MenuBuilder::addDeferredSource(const std::string& key, std::string source, bool evaluateOnce)
+{
+  DeferredSource& deferred = m_deferredSources[key];
+  deferred.source = std::move(source);
+  deferred.evaluateOnce = evaluateOnce;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus MenuBuilder::evaluateDeferredSource(const std::string& key)
+{
+  auto it = m_deferredSources.find(key);
+  if(it == m_deferredSources.end())
+  {
+    return MS::kNotFound;
+  }
+
+  // once evaluated, global procs remain defined, so the source can be released (keeping the key so that later
+  // requests still succeed)
+  if(it->second.source.empty())
+  {
+    return MS::kSuccess;
+  }
+
+  if(AL_MAYAUTILS_DEBUG)
+  {
+    std::cout << it->second.source << std::endl;
+  }
+
+  MStatus status = MGlobal::executeCommand(MString(it->second.source.data(), it->second.source.size()));
+  if(it->second.evaluateOnce)
+  {
+    std::string().swap(it->second.source);
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MenuBuilder::hasDeferredSource(const std::string& key)
+{
+  auto it = m_deferredSources.find(key);
+  return it != m_deferredSources.end() && !it->second.source.empty();
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 MenuBuilder::MenuItem* MenuBuilder::addEntry(const char* menuItemPath, const char* command, bool hasCheckbox, bool defaultCheckBoxValue, bool isRadioButton, bool radioButtonCheckedState)
@@ -95,6 +175,22 @@ MenuBuilder::MenuItem* MenuBuilder::addEntry(const char* menuItemPath, const cha
   return menuItem;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MenuBuilder::MenuItem* MenuBuilder::addSourcedEntry(const char* menuItemPath, const char* procName, const char* sourceKey, const char* source)
+{
+  // the procedures may be called by scripts as well as the menu, so they are sourced now, even in batch mode
+  if(!m_deferredSources.count(sourceKey))
+  {
+    addDeferredSource(sourceKey, source);
+    evaluateDeferredSource(sourceKey);
+  }
+  if(guiGeneration() == kGuiSkip)
+  {
+    return 0;
+  }
+  return addEntry(menuItemPath, procName);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool MenuBuilder::addEntry(const char* menuItemPath, const char* command, const char* optionBoxCommand)
 {
@@ -107,7 +203,7 @@ bool MenuBuilder::addEntry(const char* menuItemPath, const char* command, const
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void MenuBuilder::Menu::generate(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent) const
+void MenuBuilder::Menu::generate(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent, bool deferred) const
 {
   print_indent(os, indent);
   if(!indent)
@@ -122,6 +218,19 @@ void MenuBuilder::Menu::generate(std::ostringstream& os, std::ostringstream& kil
           nameWithNoSpaces[i] == '\r') nameWithNoSpaces[i] = '_';
     }
     os << "if(`menu -exists " << nameWithNoSpaces << "`) return;\n";
+    if(deferred)
+    {
+      // only create the top level menu now, and fill it in the first time it is opened
+      os << "menu -parent $gMainWindow -l \"" << m_name << "\" -aob 1 -pmo 1 -pmc \"" << m_deferredEvalCommand.asChar() << " "
+         << nameWithNoSpaces << "\" " << nameWithNoSpaces << ";\n";
+      kill << nameWithNoSpaces << " ";
+
+      std::ostringstream items;
+      items << "setParent -menu " << nameWithNoSpaces << ";\n";
+      generateContents(items, kill, prefix, indent + 1);
+      MenuBuilder::addDeferredSource(nameWithNoSpaces, items.str(), false);
+      return;
+    }
     os << "menu -parent $gMainWindow -l \"" << m_name << "\" -aob 1 " << nameWithNoSpaces << ";\n";
     kill << nameWithNoSpaces << " ";
   }
@@ -129,8 +238,12 @@ void MenuBuilder::Menu::generate(std::ostringstream& os, std::ostringstream& kil
   {
     os << "menuItem -subMenu true -l \"" << m_name << "\";\n";
   }
+  generateContents(os, kill, prefix, indent + 1);
+}
 
-  ++indent;
+//----------------------------------------------------------------------------------------------------------------------
+void MenuBuilder::Menu::generateContents(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent) const
+{
   for(auto it = m_childMenus.begin(); it != m_childMenus.end(); ++it)
   {
     it->generate(os, kill, prefix, indent);
@@ -177,7 +290,6 @@ void MenuBuilder::Menu::generate(std::ostringstream& os, std::ostringstream& kil
 
   print_indent(os, indent);
   os << "setParent -menu ..;\n";
-  --indent;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include "AL/maya/utils/ForwardDeclares.h"
 #include "AL/maya/utils/DebugCodes.h"
@@ -60,6 +61,14 @@ class MenuBuilder
 {
 public:
 
+  /// \brief  Determines when the MEL for the menus and command option boxes is generated and evaluated
+  enum GuiGeneration
+  {
+    kGuiSkip, ///< no GUI code is generated (the default in batch mode, where the GUI is never displayed)
+    kGuiDeferred, ///< the GUI code is evaluated when a menu or option box is first opened (the default when interactive)
+    kGuiImmediate ///< the GUI code is evaluated as soon as it is generated
+  };
+
   /// \brief  A structure that represents a menu item
   struct MenuItem
   {
@@ -94,13 +103,14 @@ public:
       { for(int i = 0; i <= indent; ++i) os << "  "; }
 
     AL_MAYA_UTILS_PUBLIC
-    void generate(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent = 0) const;
+    void generate(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent = 0, bool deferred = false) const;
 
     const std::string& name() const { return m_name; }
     const std::set<Menu>& childMenus() const { return m_childMenus; }
     const std::vector<MenuItem>& menuItems() const { return m_menuItems; }
 
   private:
+    void generateContents(std::ostringstream& os, std::ostringstream& kill, const char* prefix, int indent) const;
     std::string m_name;
     mutable std::set<Menu> m_childMenus;
     mutable std::vector<MenuItem> m_menuItems;
@@ -115,6 +125,52 @@ public:
     { m_menus.clear(); }
   #endif
 
+  /// \brief  returns how the GUI code is generated. Unless it has been set with setGuiGeneration, this is kGuiSkip when
+  ///         maya is not running interactively, and kGuiDeferred otherwise. kGuiDeferred is only returned once the
+  ///         plugin has set the command that evaluates the deferred code (see setDeferredEvalCommand), and
+  ///         kGuiImmediate is returned in its place until then.
+  AL_MAYA_UTILS_PUBLIC
+  static GuiGeneration guiGeneration();
+
+  /// \brief  overrides how the GUI code is generated (e.g. to force the option box procedures to exist in batch mode)
+  /// \param  generation the GUI generation mode
+  AL_MAYA_UTILS_PUBLIC
+  static void setGuiGeneration(GuiGeneration generation);
+
+  /// \brief  sets the name of the command the generated MEL calls to evaluate deferred code. This should be called by the
+  ///         plugin once it has registered AL::maya::utils::CommandGuiDeferredEval (and reset to an empty string when
+  ///         the command is unregistered).
+  /// \param  command the registered name of the command, e.g. CommandGuiDeferredEval::kName
+  AL_MAYA_UTILS_PUBLIC
+  static void setDeferredEvalCommand(const MString& command);
+
+  /// \brief  returns the name of the command used to evaluate deferred code (empty if it has not been set)
+  static const MString& deferredEvalCommand()
+    { return m_deferredEvalCommand; }
+
+  /// \brief  stores some MEL code to be evaluated by evaluateDeferredSource when the GUI that requires it is displayed
+  /// \param  key the unique key that identifies the code
+  /// \param  source the MEL code
+  /// \param  evaluateOnce if true, the code is discarded after it has been evaluated (e.g. global proc definitions).
+  ///         If false, it is evaluated on every request (e.g. the contents of a menu, which may be rebuilt)
+  AL_MAYA_UTILS_PUBLIC
+  static void addDeferredSource(const std::string& key, std::string source, bool evaluateOnce = true);
+
+  /// \brief  evaluates the MEL code previously stored against the key
+  /// \param  key the key passed to addDeferredSource
+  /// \return MS::kSuccess if the code was evaluated (or had already been evaluated)
+  AL_MAYA_UTILS_PUBLIC
+  static MStatus evaluateDeferredSource(const std::string& key);
+
+  /// \brief  returns true if there is MEL code waiting to be evaluated for the key
+  /// \param  key the key passed to addDeferredSource
+  AL_MAYA_UTILS_PUBLIC
+  static bool hasDeferredSource(const std::string& key);
+
+  /// \brief  discards all of the deferred MEL code (e.g. when the plugin is unloaded)
+  static void clearDeferredSources()
+    { m_deferredSources.clear(); }
+
   /// \brief  add an entry to the menu
   /// \param  menuItemPath forward slash seperated path to the menu item, e.g. "Create/polygons/Construct Teapot"
   /// \param  command the MEL command to execute when the item is clicked.
@@ -133,6 +189,17 @@ public:
                             bool isRadioButton = false,
                             bool radioButtonCheckedState = false);
 
+  /// \brief  add an entry to the menu that calls a MEL procedure defined within a block of MEL code. The code is
+  ///         evaluated immediately (once per sourceKey), whatever the guiGeneration, since the procedures may be used
+  ///         by scripts in batch mode. Only the menu item itself is skipped in batch mode.
+  /// \param  menuItemPath forward slash seperated path to the menu item, e.g. "Create/polygons/Construct Teapot"
+  /// \param  procName the name of the MEL procedure to call when the item is clicked
+  /// \param  sourceKey a unique key for the MEL code (which may be shared by a number of menu items)
+  /// \param  source the MEL code that defines the procedure
+  /// \return pointer to the menu item added (or null if the GUI is not being generated)
+  AL_MAYA_UTILS_PUBLIC
+  static MenuItem* addSourcedEntry(const char* menuItemPath, const char* procName, const char* sourceKey, const char* source);
+
   /// \brief  add an entry to the menu
   /// \param  menuItemPath forward slash seperated path to the menu item, e.g. "Create/polygons/Construct Teapot"
   /// \param  command the MEL command to execute when the item is clicked.
@@ -143,7 +210,8 @@ public:
 
   /// \brief  generates an init and exit script that intialises the GUI on plugin load/unload (via MFnPlugin::registerUI).
   ///         This method should only be called once during your plugins initializePlugin method, and that should probably
-  ///         be at or near the end of that function call.
+  ///         be at or near the end of that function call. In batch mode (see guiGeneration) no scripts are generated,
+  ///         and when deferred, the init script only creates the top level menus, which are filled in when first opened.
   /// \param  fnPlugin an instance of an MFnPlugin class
   /// \param  prefix some unique prefix that is unique to your plugin
   /// \param  extraOnInit some extra MEL code to execute within the initGUI method for your plugin
@@ -154,6 +222,14 @@ public:
   {
     if(m_menus.empty())
       return MS::kSuccess;
+
+    const GuiGeneration generation = guiGeneration();
+    if(generation == kGuiSkip)
+    {
+      m_menus.clear();
+      return MS::kSuccess;
+    }
+
     MString ui_init = prefix + "_initGUI";
     MString ui_exit = prefix + "_exitGUI";
 
@@ -174,7 +250,7 @@ public:
     // now construct all of the menu related gubbins.
     for(auto it = m_menus.begin(); it != m_menus.end(); ++it)
     {
-      it->generate(initGUI, exitGUI, prefix.asChar());
+      it->generate(initGUI, exitGUI, prefix.asChar(), 0, generation == kGuiDeferred);
     }
     m_menus.clear();
 
@@ -197,8 +273,17 @@ public:
   }
 
 private:
+  struct DeferredSource
+  {
+    std::string source;
+    bool evaluateOnce;
+  };
   AL_MAYA_UTILS_PUBLIC
   static std::set<Menu> m_menus;
+  AL_MAYA_UTILS_PUBLIC
+  static std::unordered_map<std::string, DeferredSource> m_deferredSources;
+  AL_MAYA_UTILS_PUBLIC
+  static MString m_deferredEvalCommand;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
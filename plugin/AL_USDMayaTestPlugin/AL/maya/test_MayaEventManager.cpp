@@ -17,6 +17,7 @@
 
 #include "AL/maya/event/MayaEventManager.h"
 #include "maya/MFileIO.h"
+#include "maya/MGlobal.h"
 
 
 using namespace AL::maya::event;
@@ -224,3 +225,76 @@ TEST(maya_Event, userDataIsWorking)
   EXPECT_TRUE(ev.unregisterCallback(id));
   delete d;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Test that node type filtered callbacks are only triggered for nodes of that type
+//----------------------------------------------------------------------------------------------------------------------
+TEST(maya_Event, nodeTypeFilteredEvents)
+{
+  MFileIO::newFile(true);
+  MayaEventManager& ev = MayaEventManager::instance();
+  MayaEventHandler* meh = ev.mayaEventsHandler();
+
+  struct Counts
+  {
+    int added = 0;
+    int removed = 0;
+  };
+  Counts transforms, cameras;
+
+  auto onAdded = [](MObject& node, void* userData)
+    {
+      ++static_cast<Counts*>(userData)->added;
+    };
+  auto onRemoved = [](MObject& node, void* userData)
+    {
+      ++static_cast<Counts*>(userData)->removed;
+    };
+
+  // only node events can be filtered
+  EXPECT_EQ(0u, ev.registerNodeTypeCallback(onAdded, "AfterNew", "transform", "nodeTypeFilteredEvents", 1000, &transforms));
+  EXPECT_EQ(0u, ev.registerNodeTypeCallback(onAdded, "NodeAdded", "", "nodeTypeFilteredEvents", 1000, &transforms));
+
+  auto transformAdded = ev.registerNodeTypeCallback(onAdded, "NodeAdded", "transform", "nodeTypeFilteredEvents", 1000, &transforms);
+  auto transformRemoved = ev.registerNodeTypeCallback(onRemoved, "NodeRemoved", "transform", "nodeTypeFilteredEvents", 1000, &transforms);
+  auto cameraAdded = ev.registerNodeTypeCallback(onAdded, "NodeAdded", "camera", "nodeTypeFilteredEvents", 1000, &cameras);
+  ASSERT_NE(0u, transformAdded);
+  ASSERT_NE(0u, transformRemoved);
+  ASSERT_NE(0u, cameraAdded);
+
+  // each node type gets its own event, which shares the prototype of the unfiltered event
+  EXPECT_NE(meh->scheduler()->event("NodeAdded:transform"), meh->scheduler()->event("NodeAdded:camera"));
+  EXPECT_TRUE(meh->isMayaCallbackRegistered("NodeAdded:transform"));
+  EXPECT_TRUE(meh->isMayaCallbackRegistered("NodeAdded:camera"));
+  EXPECT_FALSE(meh->isMayaCallbackRegistered("NodeAdded"));
+  EXPECT_EQ(MString("transform"), meh->getEventInfo("NodeAdded:transform")->nodeType);
+  EXPECT_EQ(MayaCallbackType::kNodeFunction, meh->getEventInfo("NodeAdded:transform")->mayaCallbackType);
+
+  MGlobal::executeCommand("createNode \"transform\" -n \"filteredA\"");
+  MGlobal::executeCommand("createNode \"transform\" -n \"filteredB\"");
+  MGlobal::executeCommand("createNode \"addDoubleLinear\" -n \"filteredC\"");
+  MGlobal::executeCommand("createNode \"camera\" -p \"filteredA\"");
+  MGlobal::executeCommand("delete \"filteredB\" \"filteredC\"");
+
+  EXPECT_EQ(2, transforms.added);
+  EXPECT_EQ(1, transforms.removed);
+  EXPECT_EQ(1, cameras.added);
+  EXPECT_EQ(0, cameras.removed);
+
+  // the maya callback of a filtered event is removed along with its last callback
+  EXPECT_TRUE(ev.unregisterCallback(cameraAdded));
+  EXPECT_FALSE(meh->isMayaCallbackRegistered("NodeAdded:camera"));
+  EXPECT_TRUE(meh->isMayaCallbackRegistered("NodeAdded:transform"));
+
+  // registering against an existing filter reuses the same event
+  auto secondAdded = ev.registerNodeTypeCallback(onAdded, "NodeAdded", "transform", "nodeTypeFilteredEvents2", 1001, &transforms);
+  EXPECT_EQ(extractEventId(transformAdded), extractEventId(secondAdded));
+  MGlobal::executeCommand("createNode \"transform\"");
+  EXPECT_EQ(4, transforms.added);
+
+  EXPECT_TRUE(ev.unregisterCallback(secondAdded));
+  EXPECT_TRUE(ev.unregisterCallback(transformAdded));
+  EXPECT_TRUE(ev.unregisterCallback(transformRemoved));
+  EXPECT_FALSE(meh->isMayaCallbackRegistered("NodeAdded:transform"));
+  EXPECT_FALSE(meh->isMayaCallbackRegistered("NodeRemoved:transform"));
+}
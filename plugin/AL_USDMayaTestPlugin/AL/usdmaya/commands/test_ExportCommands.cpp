@@ -15,12 +15,29 @@
 //
 
 #include "AL/maya/utils/Utils.h"
+#include "AL/usdmaya/fileio/Export.h"
 #include "test_usdmaya.h"
 #include "maya/MGlobal.h"
 #include "maya/MFileIO.h"
 #include "maya/MFnDagNode.h"
+#include "maya/MItDag.h"
+#include "maya/MSelectionList.h"
+
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/listOp.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/reference.h"
+#include "pxr/usd/usd/clipsAPI.h"
+#include "pxr/usd/usd/primRange.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
 
 using AL::maya::test::buildTempPath;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 TEST(ExportCommands, exportUVOnly)
 {
@@ -170,3 +187,379 @@ TEST(ExportCommands, extensiveAnimationCheck)
   MGlobal::executeCommand(exportCmd, true);
   expectAnimation(false);
 }
+
+TEST(ExportCommands, exportAnimationClips)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand(MString("createNode transform -n anim;setKeyframe -t 1 -v 0 anim.tx;setKeyframe -t 25 -v 24 anim.tx;select anim;"), false, true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_exportAnimationClips.usda");
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1 -frameRange 1 25 -clipFrames 10"), AL::maya::utils::convert(temp_path));
+  MGlobal::executeCommand(exportCmd, true);
+
+  // 3 clips: [1, 11], [11, 21], [21, 25]
+  const std::string clip0 = buildTempPath("AL_USDMayaTests_exportAnimationClips.clip0000.usda");
+  const std::string clip2 = buildTempPath("AL_USDMayaTests_exportAnimationClips.clip0002.usda");
+  const std::string manifest = buildTempPath("AL_USDMayaTests_exportAnimationClips.manifest.usda");
+  ASSERT_TRUE(SdfLayer::FindOrOpen(clip0));
+  ASSERT_TRUE(SdfLayer::FindOrOpen(clip2));
+  ASSERT_TRUE(SdfLayer::FindOrOpen(manifest));
+  EXPECT_FALSE(SdfLayer::FindOrOpen(buildTempPath("AL_USDMayaTests_exportAnimationClips.clip0003.usda")));
+
+  UsdStageRefPtr stage = UsdStage::Open(temp_path);
+  ASSERT_TRUE(stage);
+  UsdPrim prim = stage->GetPrimAtPath(SdfPath("/anim"));
+  ASSERT_TRUE(prim.IsValid());
+
+  VtArray<SdfAssetPath> assetPaths;
+  EXPECT_TRUE(UsdClipsAPI(prim).GetClipAssetPaths(&assetPaths));
+  EXPECT_EQ(3u, assetPaths.size());
+
+  UsdGeomXform transform(prim);
+  bool resetsXformStack;
+  std::vector<UsdGeomXformOp> ops = transform.GetOrderedXformOps(&resetsXformStack);
+  ASSERT_FALSE(ops.empty());
+  UsdAttribute translate = ops[0].GetAttr();
+
+  // no samples remain in the root layer, they have all been moved into the clips
+  EXPECT_EQ(0u, stage->GetRootLayer()->GetNumTimeSamplesForPath(translate.GetPath()));
+
+  for(double frame : { 1.0, 5.0, 11.0, 17.0, 25.0 })
+  {
+    VtValue value;
+    EXPECT_TRUE(translate.Get(&value, frame));
+    const double tx = value.IsHolding<GfVec3f>() ? value.UncheckedGet<GfVec3f>()[0] : value.Get<GfVec3d>()[0];
+    EXPECT_NEAR(frame - 1.0, tx, 1e-5);
+  }
+}
+
+TEST(ExportCommands, filterTimeSamples)
+{
+  using AL::usdmaya::fileio::filterTimeSamples;
+  auto keys = [] (const SdfTimeSampleMap& samples)
+  {
+    std::vector<double> times;
+    for(const auto& it : samples)
+      times.push_back(it.first);
+    return times;
+  };
+
+  // the first and last sample of each constant run are kept, but only the first of the run at the end
+  SdfTimeSampleMap samples;
+  const double values[] = { 0, 0, 0, 1, 1, 2, 2, 2 };
+  for(int i = 0; i < 8; ++i)
+  {
+    samples[i + 1] = VtValue(values[i]);
+  }
+  SdfTimeSampleMap filtered;
+  EXPECT_TRUE(filterTimeSamples(samples, filtered));
+  EXPECT_EQ(std::vector<double>({ 1, 3, 4, 5, 6 }), keys(filtered));
+
+  // nothing to remove
+  SdfTimeSampleMap distinct;
+  distinct[1] = VtValue(std::string("a"));
+  distinct[2] = VtValue(std::string("b"));
+  distinct[3] = VtValue(1.0f);
+  EXPECT_FALSE(filterTimeSamples(distinct, filtered));
+
+  // arrays are compared element-wise within the tolerance
+  VtArray<GfVec3f> points(100, GfVec3f(1.0f));
+  VtArray<GfVec3f> nudged(100, GfVec3f(1.0f));
+  nudged[50][1] += 1e-6f;
+  SdfTimeSampleMap arrays;
+  arrays[1] = VtValue(points);
+  arrays[2] = VtValue(nudged);
+  arrays[3] = VtValue(points);
+  EXPECT_FALSE(filterTimeSamples(arrays, filtered));
+  EXPECT_TRUE(filterTimeSamples(arrays, filtered, 1e-5));
+  EXPECT_EQ(std::vector<double>({ 1 }), keys(filtered));
+
+  // a run is measured from its first sample, so a slow drift is not removed
+  SdfTimeSampleMap drift;
+  for(int i = 0; i < 10; ++i)
+  {
+    drift[i] = VtValue(GfVec3d(i * 0.4e-5, 0, 0));
+  }
+  EXPECT_TRUE(filterTimeSamples(drift, filtered, 1e-5));
+  EXPECT_EQ(std::vector<double>({ 0, 2, 3, 5, 6, 8, 9 }), keys(filtered));
+
+  // a NaN never falls within the tolerance of a number, so it is kept even when the tolerance path is used
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  VtArray<GfVec3f> broken(100, GfVec3f(1.0f));
+  broken[50][1] = nan;
+  SdfTimeSampleMap nans;
+  nans[1] = VtValue(points);
+  nans[2] = VtValue(broken);
+  nans[3] = VtValue(points);
+  EXPECT_FALSE(filterTimeSamples(nans, filtered, 1e-5));
+  SdfTimeSampleMap nanScalars;
+  nanScalars[1] = VtValue(1.0f);
+  nanScalars[2] = VtValue(nan);
+  nanScalars[3] = VtValue(1.0f);
+  EXPECT_FALSE(filterTimeSamples(nanScalars, filtered, 1e-5));
+
+  // a typical animated export, with long static sections in each attribute
+  const uint32_t numSamples = 200;
+  VtArray<GfVec3f> moved(10000, GfVec3f(2.0f));
+  SdfTimeSampleMap mesh;
+  for(uint32_t i = 0; i < numSamples; ++i)
+  {
+    VtArray<GfVec3f> copy((i / 50) & 1 ? moved : points);
+    copy.data(); // force a unique copy of the data, as each sample read from Maya would be
+    mesh[i] = VtValue(copy);
+  }
+  const double filterTime = timeMilliseconds([&] () { EXPECT_TRUE(filterTimeSamples(mesh, filtered)); });
+  EXPECT_EQ(7u, filtered.size());
+  printTimings("filterTimeSamples: " + std::to_string(numSamples) + " samples of " + std::to_string(moved.size()) +
+               " points", { { "filter", filterTime } });
+}
+
+TEST(ExportCommands, filterSample)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand(MString("createNode transform -n anim;"
+                                  "setKeyframe -itt linear -ott linear -t 1 -v 0 anim.tx;"
+                                  "setKeyframe -itt linear -ott linear -t 10 -v 0 anim.tx;"
+                                  "setKeyframe -itt linear -ott linear -t 20 -v 10 anim.tx;select anim;"), false, true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_filterSample.usda");
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1 -frameRange 1 20 -fs 1"), AL::maya::utils::convert(temp_path));
+  MGlobal::executeCommand(exportCmd, true);
+
+  UsdStageRefPtr stage = UsdStage::Open(temp_path);
+  ASSERT_TRUE(stage);
+  UsdGeomXform transform(stage->GetPrimAtPath(SdfPath("/anim")));
+  ASSERT_TRUE(transform);
+  bool resetsXformStack;
+  std::vector<UsdGeomXformOp> ops = transform.GetOrderedXformOps(&resetsXformStack);
+  ASSERT_FALSE(ops.empty());
+  UsdAttribute translate = ops[0].GetAttr();
+
+  // frames 1 to 10 collapse to their first and last samples
+  std::vector<double> times;
+  translate.GetTimeSamples(&times);
+  ASSERT_EQ(12u, times.size());
+  EXPECT_EQ(1.0, times[0]);
+  EXPECT_EQ(10.0, times[1]);
+  EXPECT_EQ(11.0, times[2]);
+
+  for(double frame : { 1.0, 5.0, 10.0, 15.0, 20.0 })
+  {
+    VtValue value;
+    EXPECT_TRUE(translate.Get(&value, frame));
+    const double tx = value.IsHolding<GfVec3f>() ? value.UncheckedGet<GfVec3f>()[0] : value.Get<GfVec3d>()[0];
+    EXPECT_NEAR(frame <= 10.0 ? 0.0 : frame - 10.0, tx, 1e-5);
+  }
+}
+
+TEST(ExportCommands, namespacedHierarchy)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand(MString("namespace -add ns;namespace -add other;"
+                                  "createNode transform -n \"ns:root\";"
+                                  "createNode transform -n \"other:child\" -p \"ns:root\";"
+                                  "createNode transform -n \"leaf\" -p \"other:child\";"
+                                  "createNode transform -n \"ns:sibling\" -p \"ns:root\";"
+                                  "polyCube -n \"ns:cube\";parent \"ns:cube\" \"ns:sibling\";"
+                                  "select \"ns:root\";"), false, true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_namespacedHierarchy.usda");
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1 -mt 0"), AL::maya::utils::convert(temp_path));
+  MGlobal::executeCommand(exportCmd, true);
+
+  // the namespaces are stripped from each node name in the path
+  UsdStageRefPtr stage = UsdStage::Open(temp_path);
+  ASSERT_TRUE(stage);
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root")));
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root/child")));
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root/child/leaf")));
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root/sibling/cube")));
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root/sibling/cube/cubeShape")));
+}
+
+TEST(ExportCommands, exportHierarchyBenchmark)
+{
+  MFileIO::newFile(true);
+
+  // 200k transforms, made up of chains that are 30 nodes deep
+  const uint32_t numNodes = 200000;
+  const uint32_t depth = 30;
+  MFnDagNode fn;
+  MObject root = fn.create("transform", "root");
+  for(uint32_t i = 0; i < numNodes / depth; ++i)
+  {
+    MObject parent = root;
+    for(uint32_t j = 0; j < depth; ++j)
+    {
+      parent = fn.create("transform", MString("node") + j, parent);
+    }
+  }
+
+  MSelectionList sl;
+  sl.add("root");
+  MGlobal::setActiveSelectionList(sl);
+
+  // the cost of the previous approach, which converted the full path name of every node into an SdfPath
+  MDagPath rootPath;
+  sl.getDagPath(0, rootPath);
+  MItDag it(MItDag::kDepthFirst, MFn::kTransform);
+  it.reset(rootPath, MItDag::kDepthFirst, MFn::kTransform);
+  size_t numPaths = 0;
+  const double fullPathTime = timeMilliseconds([&] ()
+  {
+    for(; !it.isDone(); it.next())
+    {
+      MDagPath path;
+      it.getPath(path);
+      std::string fpn = AL::maya::utils::convert(path.fullPathName());
+      std::replace(fpn.begin(), fpn.end(), '|', '/');
+      numPaths += !SdfPath(fpn).IsEmpty();
+    }
+  });
+  EXPECT_EQ(size_t(numNodes / depth * depth + 1), numPaths);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_exportHierarchyBenchmark.usdc");
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1"), AL::maya::utils::convert(temp_path));
+  const double exportTime = timeMilliseconds([&] () { MGlobal::executeCommand(exportCmd, false); });
+
+  UsdStageRefPtr stage = UsdStage::Open(temp_path);
+  ASSERT_TRUE(stage);
+  SdfPath deepest("/root");
+  for(uint32_t j = 0; j < depth; ++j)
+  {
+    deepest = deepest.AppendChild(TfToken("node" + std::to_string(j)));
+  }
+  EXPECT_TRUE(stage->GetPrimAtPath(deepest));
+
+  printTimings("exportSceneHierarchy: " + std::to_string(numPaths) + " transforms, " + std::to_string(depth) + " deep",
+               { { "export", exportTime }, { "full path name conversion alone", fullPathTime } });
+}
+
+namespace
+{
+// the path of the prim referenced by the prim at the given path in the root layer of the stage
+SdfPath referencedPath(const UsdStageRefPtr& stage, const SdfPath& path)
+{
+  SdfPrimSpecHandle spec = stage->GetRootLayer()->GetPrimAtPath(path);
+  if(!spec)
+  {
+    return SdfPath();
+  }
+  SdfReferenceVector references;
+  spec->GetInfo(SdfFieldKeys->References).GetWithDefault<SdfReferenceListOp>().ApplyOperations(&references);
+  return references.empty() ? SdfPath() : references[0].GetPrimPath();
+}
+
+// the time taken to export the selection to the file with the additional export flags
+double timedExport(const std::string& path, const char* const flags)
+{
+  MString exportCmd;
+  exportCmd.format(MString("AL_usdmaya_ExportCommand -f \"^1s\" -sl 1 ^2s"), AL::maya::utils::convert(path), flags);
+  return timeMilliseconds([&] () { MGlobal::executeCommand(exportCmd, false); });
+}
+
+// expects every prim under /root in the plain stage to compose to the same type and attribute values in the
+// deduplicated stage
+void expectSameComposedPrims(const UsdStageRefPtr& plainStage, const UsdStageRefPtr& dedupStage)
+{
+  for(const UsdPrim& plainPrim : UsdPrimRange(plainStage->GetPrimAtPath(SdfPath("/root"))))
+  {
+    UsdPrim dedupPrim = dedupStage->GetPrimAtPath(plainPrim.GetPath());
+    ASSERT_TRUE(dedupPrim) << plainPrim.GetPath().GetString();
+    EXPECT_EQ(plainPrim.GetTypeName(), dedupPrim.GetTypeName());
+    for(const UsdAttribute& plainAttr : plainPrim.GetAttributes())
+    {
+      VtValue plainValue, dedupValue;
+      plainAttr.Get(&plainValue);
+      dedupPrim.GetAttribute(plainAttr.GetName()).Get(&dedupValue);
+      EXPECT_EQ(plainValue, dedupValue) << plainAttr.GetPath().GetString();
+    }
+  }
+}
+}
+
+TEST(ExportCommands, deduplicateMeshes)
+{
+  MFileIO::newFile(true);
+
+  // many duplicated (not instanced) copies of a prop, one copy that has been edited, and one that has been flipped
+  const uint32_t numCopies = 200;
+  std::string createCmd("polySphere -sx 40 -sy 40 -n prop;delete -ch prop;createNode transform -n root;parent prop root;");
+  for(uint32_t i = 0; i < numCopies; ++i)
+  {
+    const std::string copy = "copy" + std::to_string(i);
+    createCmd += "duplicate -n " + copy + " prop;move " + std::to_string(i) + " 0 0 " + copy + ";";
+  }
+  createCmd += "duplicate -n odd prop;move -r 0 1 0 odd.vtx[0];";
+  createCmd += "duplicate -n flipped prop;string $flippedShapes[] = `listRelatives -s flipped`;"
+               "setAttr ($flippedShapes[0] + \".opposite\") 1;select root;";
+  MGlobal::executeCommand(MString(createCmd.c_str()), false, true);
+
+  const std::string plain_path = buildTempPath("AL_USDMayaTests_deduplicateMeshesOff.usda");
+  const std::string dedup_path = buildTempPath("AL_USDMayaTests_deduplicateMeshesOn.usda");
+  const double plainTime = timedExport(plain_path, "");
+  const double dedupTime = timedExport(dedup_path, "-dm 1");
+
+  UsdStageRefPtr plainStage = UsdStage::Open(plain_path);
+  UsdStageRefPtr dedupStage = UsdStage::Open(dedup_path);
+  ASSERT_TRUE(plainStage);
+  ASSERT_TRUE(dedupStage);
+  EXPECT_FALSE(plainStage->GetPrimAtPath(SdfPath("/InstanceSources")));
+
+  // one master for the prop, one for the edited copy and one for the flipped copy
+  UsdPrim sources = dedupStage->GetPrimAtPath(SdfPath("/InstanceSources"));
+  ASSERT_TRUE(sources);
+  EXPECT_EQ(3u, std::distance(sources.GetChildren().begin(), sources.GetChildren().end()));
+  const SdfPath master = referencedPath(dedupStage, SdfPath("/root/prop"));
+  ASSERT_FALSE(master.IsEmpty());
+  for(uint32_t i = 0; i < numCopies; ++i)
+  {
+    EXPECT_EQ(master, referencedPath(dedupStage, SdfPath("/root/copy" + std::to_string(i))));
+  }
+  const SdfPath oddMaster = referencedPath(dedupStage, SdfPath("/root/odd"));
+  EXPECT_FALSE(oddMaster.IsEmpty());
+  EXPECT_NE(master, oddMaster);
+  const SdfPath flippedMaster = referencedPath(dedupStage, SdfPath("/root/flipped"));
+  EXPECT_FALSE(flippedMaster.IsEmpty());
+  EXPECT_NE(master, flippedMaster);
+  EXPECT_NE(oddMaster, flippedMaster);
+
+  // the composed geometry and transforms are identical to those of the plain export
+  expectSameComposedPrims(plainStage, dedupStage);
+
+  std::ifstream plainFile(plain_path, std::ios::binary | std::ios::ate);
+  std::ifstream dedupFile(dedup_path, std::ios::binary | std::ios::ate);
+  const std::streamoff plainSize = plainFile.tellg();
+  const std::streamoff dedupSize = dedupFile.tellg();
+  EXPECT_LT(dedupSize * 10, plainSize);
+
+  printTimings("deduplicateMeshes: " + std::to_string(numCopies + 3) + " meshes, " + std::to_string(plainSize) +
+               " bytes exported, " + std::to_string(dedupSize) + " bytes deduplicated",
+               { { "export", plainTime }, { "deduplicated export", dedupTime } });
+
+  // without merged transforms, each copy keeps its own shape prim (named after its own shape), so nothing is
+  // deduplicated
+  const std::string unmerged_plain_path = buildTempPath("AL_USDMayaTests_deduplicateMeshesUnmergedOff.usda");
+  const std::string unmerged_dedup_path = buildTempPath("AL_USDMayaTests_deduplicateMeshesUnmergedOn.usda");
+  timedExport(unmerged_plain_path, "-mt 0");
+  timedExport(unmerged_dedup_path, "-mt 0 -dm 1");
+
+  UsdStageRefPtr unmergedPlainStage = UsdStage::Open(unmerged_plain_path);
+  UsdStageRefPtr unmergedDedupStage = UsdStage::Open(unmerged_dedup_path);
+  ASSERT_TRUE(unmergedPlainStage);
+  ASSERT_TRUE(unmergedDedupStage);
+  for(uint32_t i = 0; i < numCopies; ++i)
+  {
+    const SdfPath copyPath("/root/copy" + std::to_string(i));
+    EXPECT_TRUE(referencedPath(unmergedDedupStage, copyPath).IsEmpty());
+    for(const UsdPrim& shapePrim : unmergedDedupStage->GetPrimAtPath(copyPath).GetChildren())
+    {
+      EXPECT_TRUE(referencedPath(unmergedDedupStage, shapePrim.GetPath()).IsEmpty());
+    }
+  }
+  expectSameComposedPrims(unmergedPlainStage, unmergedDedupStage);
+}
@@ -15,6 +15,7 @@
 //
 #include "test_usdmaya.h"
 
+#include "AL/usdmaya/cmds/ProxyShapeCommands.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/StageCache.h"
@@ -27,10 +28,13 @@
 #include "maya/MItDependencyNodes.h"
 #include "maya/MFileIO.h"
 #include "maya/MUuid.h"
+#include "maya/MPlugArray.h"
 
 #include <functional>
 
 using AL::maya::test::buildTempPath;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 
 TEST(ProxyShapeImport, populationMaskInclude)
@@ -288,3 +292,275 @@ over "root" {
      EXPECT_NEAR(3.4, translation.z, EPSILON);
    }
 }
+
+namespace {
+// builds a stage with numRoots root prims, each with numChildren children, and loads it into a new proxy shape
+AL::usdmaya::nodes::ProxyShape* buildTransformRangeProxy(const char* name, uint32_t numRoots, uint32_t numChildren)
+{
+  const std::string temp_path = buildTempPath(name);
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    for(uint32_t i = 0; i < numRoots; ++i)
+    {
+      const std::string root = "/root" + std::to_string(i);
+      UsdGeomXform::Define(stage, SdfPath(root));
+      for(uint32_t j = 0; j < numChildren; ++j)
+      {
+        UsdGeomXform::Define(stage, SdfPath(root + "/child" + std::to_string(j)));
+      }
+    }
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  return proxy;
+}
+
+uint32_t countTransforms()
+{
+  MStringArray result;
+  MGlobal::executeCommand("ls -type \"AL_usdmaya_Transform\"", result);
+  return result.length();
+}
+}
+
+TEST(ProxyShapeImportAllTransforms, undoRedo)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand("undoInfo -state 1;");
+  const uint32_t numRoots = 4, numChildren = 50;
+  const uint32_t numPrims = numRoots * (numChildren + 1);
+  buildTransformRangeProxy("AL_USDMayaTests_importAllTransformsUndo.usda", numRoots, numChildren);
+
+  EXPECT_EQ(0u, countTransforms());
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeImportAllTransforms -p2p true \"AL_usdmaya_ProxyShape1\"", false, true);
+  EXPECT_EQ(numPrims, countTransforms());
+
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(0u, countTransforms());
+  MGlobal::executeCommand("redo", false, true);
+  EXPECT_EQ(numPrims, countTransforms());
+
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeRemoveAllTransforms \"AL_usdmaya_ProxyShape1\"", false, true);
+  EXPECT_EQ(0u, countTransforms());
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numPrims, countTransforms());
+
+  // the recreated transforms keep the pushToPrim state they were imported with
+  {
+    MSelectionList sl;
+    sl.add("root0");
+    MObject node;
+    sl.getDependNode(0, node);
+    MFnDependencyNode fn(node);
+    EXPECT_TRUE(fn.findPlug("pushToPrim").asBool());
+  }
+
+  MGlobal::executeCommand("redo", false, true);
+  EXPECT_EQ(0u, countTransforms());
+
+  // a single prim range
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeImportAllTransforms -pp \"/root1\" \"AL_usdmaya_ProxyShape1\"", false, true);
+  EXPECT_EQ(numChildren + 1, countTransforms());
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(0u, countTransforms());
+}
+
+TEST(ProxyShapeImportAllTransforms, undoMemory)
+{
+  // an import keeps one reference record per created transform, and no modifier operations, for each undo/redo
+  auto measure = [] (const char* name, uint32_t numChildren)
+  {
+    MFileIO::newFile(true);
+    AL::usdmaya::nodes::ProxyShape* proxy = buildTransformRangeProxy(name, 2, numChildren);
+    const SdfPathVector roots = { SdfPath("/root0"), SdfPath("/root1") };
+    const size_t numTransforms = 2 * (numChildren + 1);
+    AL::usdmaya::cmds::TransformRangeUndoHelper helper(
+        proxy->thisMObject(), roots, AL::usdmaya::nodes::ProxyShape::kRequested, false, true);
+
+    EXPECT_EQ(MStatus(MS::kSuccess), helper.doIt());
+    EXPECT_EQ(numTransforms, countTransforms());
+    EXPECT_EQ(numTransforms, helper.numAdded());
+    EXPECT_EQ(0u, helper.numRemoved());
+    EXPECT_FALSE(helper.holdsModifier());
+    const size_t bytes = helper.memoryUsage();
+    const size_t recordBytes = sizeof(AL::usdmaya::nodes::ProxyShape::TransformRefState) + sizeof(SdfPath);
+    EXPECT_GE(sizeof(helper) + sizeof(SdfPath) * roots.size() + recordBytes * numTransforms, bytes);
+
+    // undo needs a modifier to delete the nodes, which redo releases once it has brought the same nodes back
+    EXPECT_EQ(MStatus(MS::kSuccess), helper.undoIt());
+    EXPECT_EQ(0u, countTransforms());
+    EXPECT_TRUE(helper.holdsModifier());
+    EXPECT_EQ(MStatus(MS::kSuccess), helper.doIt());
+    EXPECT_EQ(numTransforms, countTransforms());
+    EXPECT_FALSE(helper.holdsModifier());
+    EXPECT_EQ(bytes, helper.memoryUsage());
+
+    // removal has to keep its modifier, to be able to bring back the user's nodes
+    AL::usdmaya::cmds::TransformRangeUndoHelper removeHelper(
+        proxy->thisMObject(), roots, AL::usdmaya::nodes::ProxyShape::kRequested, false, false);
+    EXPECT_EQ(MStatus(MS::kSuccess), removeHelper.doIt());
+    EXPECT_EQ(0u, countTransforms());
+    EXPECT_EQ(numTransforms, removeHelper.numRemoved());
+    EXPECT_EQ(0u, removeHelper.numAdded());
+    EXPECT_TRUE(removeHelper.holdsModifier());
+    EXPECT_EQ(MStatus(MS::kSuccess), removeHelper.undoIt());
+    EXPECT_EQ(numTransforms, countTransforms());
+    return bytes - sizeof(helper) - sizeof(SdfPath) * roots.size();
+  };
+
+  // the record grows by the same number of bytes per transform, however many transforms there are
+  const size_t smallBytes = measure("AL_USDMayaTests_importAllTransformsMemSmall.usda", 5);
+  const size_t largeBytes = measure("AL_USDMayaTests_importAllTransformsMemLarge.usda", 1000);
+  EXPECT_EQ(smallBytes / 12, largeBytes / 2002);
+}
+
+TEST(ProxyShapeImportAllTransforms, undoRestoresNodes)
+{
+  // undo/redo should only touch the transforms (and transform references) changed by the command, and should bring
+  // back the same maya nodes rather than recreating them
+  MFileIO::newFile(true);
+  MGlobal::executeCommand("undoInfo -state 1;");
+  const uint32_t numRoots = 2, numChildren = 3;
+  const uint32_t numPrims = numRoots * (numChildren + 1);
+  AL::usdmaya::nodes::ProxyShape* proxy = buildTransformRangeProxy("AL_USDMayaTests_importAllTransformsNodes.usda", numRoots, numChildren);
+
+  struct Counts
+  {
+    uint32_t selected, required, refCount;
+    bool operator == (const Counts& c) const
+      { return selected == c.selected && required == c.required && refCount == c.refCount; }
+  };
+  auto counts = [proxy] (const char* path)
+  {
+    Counts c = { 0, 0, 0 };
+    proxy->getCounts(SdfPath(path), c.selected, c.required, c.refCount);
+    return c;
+  };
+  auto uuid = [proxy] (const char* path)
+  {
+    MObject node = proxy->findRequiredPath(SdfPath(path));
+    return node.isNull() ? MString() : MFnDependencyNode(node).uuid().asString();
+  };
+  const char* const paths[] = { "/root0", "/root0/child0", "/root0/child2", "/root1", "/root1/child1" };
+
+  // a selected transform that exists before the bulk import, and that should survive its undo
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeSelect -r -pp \"/root0/child0\" \"AL_usdmaya_ProxyShape1\"", false, true);
+  const uint32_t numExisting = countTransforms();
+  ASSERT_LT(0u, numExisting);
+  const MString existingUuid = uuid("/root0/child0");
+  ASSERT_NE(0u, existingUuid.length());
+  std::vector<Counts> initialCounts;
+  for(const char* path : paths)
+  {
+    initialCounts.push_back(counts(path));
+  }
+
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeImportAllTransforms \"AL_usdmaya_ProxyShape1\"", false, true);
+  ASSERT_EQ(numPrims, countTransforms());
+  std::vector<Counts> importedCounts;
+  std::vector<MString> importedUuids;
+  for(const char* path : paths)
+  {
+    importedCounts.push_back(counts(path));
+    importedUuids.push_back(uuid(path));
+  }
+
+  // undo removes only the transforms that were created by the import
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numExisting, countTransforms());
+  EXPECT_EQ(existingUuid, uuid("/root0/child0"));
+  for(size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+  {
+    EXPECT_TRUE(initialCounts[i] == counts(paths[i])) << paths[i];
+  }
+
+  // redo brings back the same nodes
+  MGlobal::executeCommand("redo", false, true);
+  EXPECT_EQ(numPrims, countTransforms());
+  for(size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+  {
+    EXPECT_EQ(importedUuids[i], uuid(paths[i])) << paths[i];
+    EXPECT_TRUE(importedCounts[i] == counts(paths[i])) << paths[i];
+  }
+
+  // edit one of the transforms, remove them all, and undo. The same (edited) nodes should come back.
+  MGlobal::executeCommand("addAttr -ln \"userEdit\" -at \"long\" -dv 42 \"root1\"", false, true);
+  MGlobal::executeCommand("createNode \"transform\" -n \"userNode\"", false, true);
+  MGlobal::executeCommand("connectAttr \"root1.tx\" \"userNode.tx\"", false, true);
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeRemoveAllTransforms \"AL_usdmaya_ProxyShape1\"", false, true);
+  EXPECT_EQ(0u, countTransforms());
+  for(const char* path : paths)
+  {
+    EXPECT_TRUE(proxy->findRequiredPath(SdfPath(path)).isNull()) << path;
+  }
+
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numPrims, countTransforms());
+  for(size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+  {
+    EXPECT_EQ(importedUuids[i], uuid(paths[i])) << paths[i];
+    EXPECT_TRUE(importedCounts[i] == counts(paths[i])) << paths[i];
+  }
+  {
+    MObject node = proxy->findRequiredPath(SdfPath("/root1"));
+    ASSERT_FALSE(node.isNull());
+    MFnDependencyNode fn(node);
+    EXPECT_TRUE(fn.hasAttribute("userEdit"));
+    EXPECT_EQ(42, fn.findPlug("userEdit").asInt());
+    MPlugArray destinations;
+    fn.findPlug("tx").connectedTo(destinations, false, true);
+    ASSERT_EQ(1u, destinations.length());
+    EXPECT_EQ(MString("userNode"), MFnDependencyNode(destinations[0].node()).name());
+  }
+
+  // undoing the import as well leaves the transform that existed beforehand
+  MGlobal::executeCommand("undo", false, true);
+  MGlobal::executeCommand("undo", false, true);
+  MGlobal::executeCommand("undo", false, true);
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numExisting, countTransforms());
+  EXPECT_EQ(existingUuid, uuid("/root0/child0"));
+  for(size_t i = 0; i < sizeof(paths) / sizeof(*paths); ++i)
+  {
+    EXPECT_TRUE(initialCounts[i] == counts(paths[i])) << paths[i];
+  }
+}
+
+TEST(ProxyShapeImport, lockLayoutSubtree)
+{
+  MFileIO::newFile(true);
+  const uint32_t numChildren = 2000;
+  AL::usdmaya::nodes::ProxyShape* proxy = buildTransformRangeProxy("AL_USDMayaTests_lockLayoutSubtree.usda", 1, numChildren);
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeImportAllTransforms \"AL_usdmaya_ProxyShape1\"", false, false);
+  ASSERT_EQ(numChildren + 1, countTransforms());
+
+  auto isLocked = [] (const char* name)
+  {
+    MSelectionList sl;
+    sl.add(name);
+    MObject node;
+    sl.getDependNode(0, node);
+    MFnDependencyNode fn(node);
+    return fn.findPlug("t").isLocked() && fn.findPlug("r").isLocked() && fn.findPlug("s").isLocked();
+  };
+
+  // locking the root of the layout locks every (inherited) child transform
+  UsdPrim root = proxy->getUsdStage()->GetPrimAtPath(SdfPath("/root0"));
+  const TfToken lockMetadata("al_usdmaya_lock");
+  const double lockTime = timeMilliseconds([&] () { root.SetMetadata(lockMetadata, TfToken("transform")); });
+  EXPECT_TRUE(isLocked("root0"));
+  EXPECT_TRUE(isLocked("child0"));
+  EXPECT_TRUE(isLocked((std::string("child") + std::to_string(numChildren - 1)).c_str()));
+
+  const double unlockTime = timeMilliseconds([&] () { root.SetMetadata(lockMetadata, TfToken("unlocked")); });
+  EXPECT_FALSE(isLocked("root0"));
+  EXPECT_FALSE(isLocked("child0"));
+
+  printTimings("Subtree of " + std::to_string(numChildren + 1) + " transforms",
+               { { "lock", lockTime }, { "unlock", unlockTime } });
+}
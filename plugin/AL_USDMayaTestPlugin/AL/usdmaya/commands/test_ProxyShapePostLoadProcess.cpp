@@ -0,0 +1,232 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+
+#include "AL/usdmaya/cmds/ProxyShapePostLoadProcess.h"
+#include "AL/usdmaya/fileio/SchemaPrims.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
+
+#include "maya/MFileIO.h"
+#include "maya/MFloatPointArray.h"
+#include "maya/MFnDagNode.h"
+#include "maya/MFnMesh.h"
+#include "maya/MObjectHandle.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/camera.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/xform.h"
+
+using AL::maya::test::buildTempPath;
+using AL::usdmaya::cmds::ProxyShapePostLoadProcess;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+//----------------------------------------------------------------------------------------------------------------------
+// static void huntForNativeNodes(nodes::ProxyShape* shape, const MDagPath& proxyTransformPath,
+//                                std::vector<UsdPrim>& schemaPrims, std::vector<ImportCallback>& postCallBacks);
+TEST(ProxyShapePostLoadProcess, huntForNativeNodes)
+{
+  const uint32_t numGroups = 1000;
+  const uint32_t numChildren = 20;
+
+  auto constructTransformChain = [numGroups, numChildren] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    for(uint32_t i = 0; i < numGroups; ++i)
+    {
+      SdfPath group(std::string("/group") + std::to_string(i));
+      UsdGeomXform xform = UsdGeomXform::Define(stage, group);
+
+      // some unrelated customData, which should be ignored
+      xform.GetPrim().SetCustomDataByKey(TfToken("someData"), VtValue(int(i)));
+
+      for(uint32_t j = 0; j < numChildren; ++j)
+      {
+        UsdGeomXform::Define(stage, group.AppendChild(TfToken(std::string("child") + std::to_string(j))));
+      }
+
+      // every tenth group gets a camera, every hundredth a pair of callbacks
+      if(!(i % 10))
+      {
+        UsdGeomCamera::Define(stage, group.AppendChild(TfToken("camera")));
+      }
+      if(!(i % 100))
+      {
+        VtDictionary callbacks;
+        callbacks["print \"a\""] = VtValue(VtDictionary());
+        callbacks["print \"b\""] = VtValue(VtDictionary());
+        xform.GetPrim().SetCustomDataByKey(TfToken("callbacks"), VtValue(callbacks));
+      }
+    }
+    return stage;
+  };
+
+  MFileIO::newFile(true);
+  MObject shapeParent;
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_huntForNativeNodes.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(constructTransformChain, temp_path, &shapeParent);
+  ASSERT_TRUE(proxy);
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  MDagPath proxyTransformPath;
+  MFnDagNode(shapeParent).getPath(proxyTransformPath);
+  proxyTransformPath.pop();
+
+  std::vector<UsdPrim> schemaPrims;
+  std::vector<ProxyShapePostLoadProcess::ImportCallback> callbacks;
+
+  const double huntTime = timeMilliseconds([&] ()
+  {
+    ProxyShapePostLoadProcess::huntForNativeNodes(proxy, proxyTransformPath, schemaPrims, callbacks);
+  });
+
+  EXPECT_EQ(numGroups / 10, schemaPrims.size());
+  for(const UsdPrim& prim : schemaPrims)
+  {
+    EXPECT_TRUE(prim.IsA<UsdGeomCamera>());
+  }
+
+  ASSERT_EQ(2 * (numGroups / 100), callbacks.size());
+  for(const auto& callback : callbacks)
+  {
+    EXPECT_EQ(ProxyShapePostLoadProcess::ImportCallback::kMel, callback.type);
+    EXPECT_TRUE(callback.name == "print \"a\"" || callback.name == "print \"b\"");
+  }
+
+  printTimings("huntForNativeNodes of " + std::to_string(numGroups * (numChildren + 1) + numGroups / 10) + " prims",
+               { { "classify", huntTime } });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+namespace
+{
+// a stage containing numMeshes grids of dim x dim quads, each offset in Y by its index
+UsdStageRefPtr constructMeshGrids(uint32_t numMeshes, uint32_t dim)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  VtArray<int> counts(dim * dim, 4);
+  VtArray<int> connects;
+  connects.reserve(dim * dim * 4);
+  for(uint32_t i = 0; i < dim; ++i)
+  {
+    for(uint32_t j = 0; j < dim; ++j)
+    {
+      const int v = i * (dim + 1) + j;
+      connects.push_back(v);
+      connects.push_back(v + 1);
+      connects.push_back(v + dim + 2);
+      connects.push_back(v + dim + 1);
+    }
+  }
+  for(uint32_t m = 0; m < numMeshes; ++m)
+  {
+    UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath(std::string("/mesh") + std::to_string(m)));
+    VtArray<GfVec3f> points((dim + 1) * (dim + 1));
+    for(uint32_t i = 0, k = 0; i <= dim; ++i)
+    {
+      for(uint32_t j = 0; j <= dim; ++j, ++k)
+      {
+        points[k] = GfVec3f(j, m, i);
+      }
+    }
+    mesh.GetFaceVertexCountsAttr().Set(counts);
+    mesh.GetFaceVertexIndicesAttr().Set(connects);
+    mesh.GetPointsAttr().Set(points);
+  }
+  return stage;
+}
+
+std::vector<UsdPrim> meshPrims(UsdStageRefPtr stage)
+{
+  std::vector<UsdPrim> prims;
+  for(const UsdPrim& prim : stage->Traverse())
+  {
+    if(prim.IsA<UsdGeomMesh>())
+      prims.push_back(prim);
+  }
+  return prims;
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// static void createSchemaPrims(nodes::ProxyShape* proxy, const std::vector<UsdPrim>& objsToCreate,
+//                               const fileio::translators::TranslatorParameters& param);
+TEST(ProxyShapePostLoadProcess, createSchemaPrimsParallelRead)
+{
+  const uint32_t numMeshes = 200;
+  const uint32_t dim = 50;
+
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_createSchemaPrimsParallelRead.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = CreateMayaProxyShape(
+      [numMeshes, dim]() { return constructMeshGrids(numMeshes, dim); }, temp_path);
+  ASSERT_TRUE(proxy);
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  // meshes are not imported by default, so force them in
+  AL::usdmaya::fileio::translators::TranslatorParameters param;
+  param.setForcePrimImport(true);
+
+  const std::vector<UsdPrim> prims = meshPrims(proxy->getUsdStage());
+  ASSERT_EQ(numMeshes, prims.size());
+
+  const double parallelTime = timeMilliseconds([&] ()
+  {
+    ProxyShapePostLoadProcess::createSchemaPrims(proxy, prims, param);
+  });
+
+  // every mesh must have been created from the data read in parallel
+  for(const UsdPrim& prim : prims)
+  {
+    MObjectHandle handle;
+    ASSERT_TRUE(proxy->context()->getMObject(prim, handle, MFn::kMesh));
+    MFnMesh fn(handle.object());
+    EXPECT_EQ(int(dim * dim), fn.numPolygons());
+    EXPECT_EQ(int((dim + 1) * (dim + 1)), fn.numVertices());
+
+    VtArray<GfVec3f> expected;
+    UsdGeomMesh(prim).GetPointsAttr().Get(&expected);
+    MFloatPointArray points;
+    fn.getPoints(points);
+    ASSERT_EQ(expected.size(), points.length());
+    EXPECT_NEAR(expected[expected.size() - 1][0], points[points.length() - 1].x, 1e-5f);
+    EXPECT_NEAR(expected[expected.size() - 1][1], points[points.length() - 1].y, 1e-5f);
+    EXPECT_NEAR(expected[expected.size() - 1][2], points[points.length() - 1].z, 1e-5f);
+  }
+
+  // the same import on a second proxy, where each prim is read from USD as it is created
+  const std::string temp_path2 = buildTempPath("AL_USDMayaTests_createSchemaPrimsSerialRead.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy2 = CreateMayaProxyShape(
+      [numMeshes, dim]() { return constructMeshGrids(numMeshes, dim); }, temp_path2);
+  ASSERT_TRUE(proxy2);
+  const std::vector<UsdPrim> prims2 = meshPrims(proxy2->getUsdStage());
+  auto& manufacture = proxy2->translatorManufacture();
+
+  const double serialTime = timeMilliseconds([&] ()
+  {
+    for(const UsdPrim& prim : prims2)
+    {
+      MObject parent = proxy2->findRequiredPath(prim.GetPath());
+      MObject created;
+      EXPECT_TRUE(AL::usdmaya::fileio::importSchemaPrim(prim, parent, created, proxy2->context(),
+                                                        manufacture.get(prim.GetTypeName()), param));
+    }
+  });
+
+  printTimings("createSchemaPrims of " + std::to_string(numMeshes) + " meshes",
+               { { "parallel read", parallelTime }, { "serial read", serialTime } });
+}
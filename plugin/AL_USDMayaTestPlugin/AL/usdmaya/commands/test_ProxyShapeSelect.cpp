@@ -1166,3 +1166,93 @@ TEST(ProxyShapeSelect, repeatedSelection)
   MGlobal::executeCommand("undo", false, true);
   { SCOPED_TRACE(""); assertNothingSelected(proxy); }
 }
+
+TEST(ProxyShapeSelect, selectPathList)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand("undoInfo -state 1;");
+
+  const uint32_t numPrims = 500;
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_selectPathList.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    for(uint32_t i = 0; i < numPrims; ++i)
+    {
+      UsdGeomXform::Define(stage, SdfPath("/root/prim" + std::to_string(i)));
+    }
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+
+  // build a newline separated list of every prim (with a trailing newline, blank line, and a duplicate)
+  std::string allPaths, evenPaths;
+  for(uint32_t i = 0; i < numPrims; ++i)
+  {
+    const std::string path = "/root/prim" + std::to_string(i) + "\n";
+    allPaths += path;
+    if(!(i & 1))
+      evenPaths += path;
+  }
+  allPaths += "\n/root/prim0\n";
+
+  auto selectCommand = [] (const char* mode, const std::string& paths)
+  {
+    MString cmd = "AL_usdmaya_ProxyShapeSelect ";
+    cmd += mode;
+    cmd += " -ppl \"";
+    // escape the newlines within the MEL string literal
+    std::string escaped;
+    for(char c : paths)
+    {
+      if(c == '\n')
+        escaped += "\\n";
+      else
+        escaped += c;
+    }
+    cmd += escaped.c_str();
+    cmd += "\" \"AL_usdmaya_ProxyShape1\"";
+    return cmd;
+  };
+
+  MGlobal::executeCommand("select -cl;");
+  MStringArray results;
+  MGlobal::executeCommand(selectCommand("-r", allPaths), results, false, true);
+  EXPECT_EQ(numPrims, results.length());
+  EXPECT_EQ(numPrims, proxy->selectedPaths().size());
+  EXPECT_EQ(1, proxy->selectedPaths().count(SdfPath("/root/prim0")));
+  EXPECT_EQ(1, proxy->selectedPaths().count(SdfPath("/root/prim499")));
+
+  // mixing -pp and -ppl
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeSelect -r -pp \"/root/prim1\" -ppl \"/root/prim2\\n/root/prim3\" \"AL_usdmaya_ProxyShape1\"", results, false, true);
+  EXPECT_EQ(3, proxy->selectedPaths().size());
+
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numPrims, proxy->selectedPaths().size());
+
+  // remove the even prims
+  MGlobal::executeCommand(selectCommand("-d", evenPaths), false, true);
+  EXPECT_EQ(numPrims / 2, proxy->selectedPaths().size());
+  EXPECT_EQ(0, proxy->selectedPaths().count(SdfPath("/root/prim0")));
+  EXPECT_EQ(1, proxy->selectedPaths().count(SdfPath("/root/prim1")));
+
+  // undo restores them, redo removes them again
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(numPrims, proxy->selectedPaths().size());
+  MGlobal::executeCommand("redo", false, true);
+  EXPECT_EQ(numPrims / 2, proxy->selectedPaths().size());
+
+  MGlobal::executeCommand("undo", false, true);
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_EQ(0, proxy->selectedPaths().size());
+  MGlobal::executeCommand("redo", false, true);
+  EXPECT_EQ(numPrims, proxy->selectedPaths().size());
+
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeSelect -cl \"AL_usdmaya_ProxyShape1\"", false, true);
+  EXPECT_EQ(0, proxy->selectedPaths().size());
+}
@@ -0,0 +1,130 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/fileio/TransformIterator.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/references.h"
+#include "pxr/usd/usdGeom/xform.h"
+
+using AL::usdmaya::fileio::TransformIterator;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// builds a stage containing a class prim with a (childrenPerLevel ^ depth) subtree, and numInstances instanceable
+/// prims referencing it.
+UsdStageRefPtr buildInstancedStage(uint32_t numInstances, uint32_t childrenPerLevel, uint32_t depth)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdPrim proto = stage->CreateClassPrim(SdfPath("/_prototype"));
+
+  std::vector<SdfPath> level(1, proto.GetPath());
+  for(uint32_t d = 0; d < depth; ++d)
+  {
+    std::vector<SdfPath> nextLevel;
+    for(const SdfPath& parent : level)
+    {
+      for(uint32_t c = 0; c < childrenPerLevel; ++c)
+      {
+        SdfPath path = parent.AppendChild(TfToken(std::string("child") + std::to_string(c)));
+        UsdGeomXform::Define(stage, path);
+        nextLevel.push_back(path);
+      }
+    }
+    level.swap(nextLevel);
+  }
+
+  for(uint32_t i = 0; i < numInstances; ++i)
+  {
+    UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath(std::string("/instance") + std::to_string(i)));
+    xform.GetPrim().GetReferences().AddInternalReference(proto.GetPath());
+    xform.GetPrim().SetInstanceable(true);
+  }
+  return stage;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t countPrims(UsdStageRefPtr stage, TransformIterator::InstanceMode mode, double& milliseconds)
+{
+  size_t count = 0;
+  milliseconds = timeMilliseconds([&] ()
+  {
+    for(TransformIterator it(stage, MDagPath(), mode); !it.done(); it.next())
+    {
+      ++count;
+    }
+  });
+  return count;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// TransformIterator(UsdStageRefPtr stage, const MDagPath& parentPath, InstanceMode instanceMode);
+// const TfHashMap<SdfPath, SdfPathVector, SdfPath::Hash>& masterInstances() const;
+TEST(TransformIterator, visitMasterOnce)
+{
+  UsdStageRefPtr stage = buildInstancedStage(8, 2, 2);
+
+  // 8 instances, each of which walks a master holding 2 + 4 prims
+  double milliseconds = 0;
+  EXPECT_EQ(8u + 8u * 6u, countPrims(stage, TransformIterator::kVisitMasterPerInstance, milliseconds));
+  EXPECT_EQ(8u + 6u, countPrims(stage, TransformIterator::kVisitMasterOnce, milliseconds));
+
+  TransformIterator it(stage, MDagPath(), TransformIterator::kVisitMasterOnce);
+  std::vector<SdfPath> masterPrims;
+  for(; !it.done(); it.next())
+  {
+    EXPECT_TRUE(it.prim().IsValid());
+    if(it.prim().IsInMaster())
+    {
+      masterPrims.push_back(it.prim().GetPath());
+    }
+  }
+  EXPECT_EQ(6u, masterPrims.size());
+
+  ASSERT_EQ(1u, it.visitedMasterPrimPaths().size());
+  ASSERT_EQ(1u, it.masterInstances().size());
+  const SdfPathVector& instances = it.masterInstances().begin()->second;
+  EXPECT_EQ(8u, instances.size());
+  for(const SdfPath& instance : instances)
+  {
+    EXPECT_TRUE(stage->GetPrimAtPath(instance).IsInstance());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Benchmark of the two instance modes on a stage with many instances of a moderately sized master
+TEST(TransformIterator, visitMasterOnceBenchmark)
+{
+  const uint32_t numInstances = 2000;
+  UsdStageRefPtr stage = buildInstancedStage(numInstances, 4, 3);
+
+  double perInstanceTime = 0, onceTime = 0;
+  const size_t perInstance = countPrims(stage, TransformIterator::kVisitMasterPerInstance, perInstanceTime);
+  const size_t once = countPrims(stage, TransformIterator::kVisitMasterOnce, onceTime);
+
+  const size_t masterSize = 4 + 16 + 64;
+  EXPECT_EQ(numInstances + numInstances * masterSize, perInstance);
+  EXPECT_EQ(numInstances + masterSize, once);
+
+  printTimings("TransformIterator over " + std::to_string(numInstances) + " instances",
+               { { (std::to_string(perInstance) + " prims visited per instance").c_str(), perInstanceTime },
+                 { (std::to_string(once) + " prims visited once").c_str(), onceTime } });
+}
@@ -0,0 +1,139 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/LayerGraph.h"
+
+#include "pxr/usd/sdf/fileFormat.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <algorithm>
+
+using AL::usdmaya::nodes::proxy::LayerGraph;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+namespace {
+SdfLayerRefPtr newLayer(const std::string& identifier)
+{
+  return SdfLayer::New(SdfFileFormat::FindByExtension("usda"), identifier);
+}
+
+bool contains(const SdfLayerHandleVector& layers, const SdfLayerHandle& layer)
+{
+  return std::find(layers.begin(), layers.end(), layer) != layers.end();
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// SdfLayerHandle findLayer(const std::string& name) const;
+// SdfLayerHandleVector findLayersByDisplayName(const std::string& displayName) const;
+TEST(LayerGraph, duplicateDisplayNames)
+{
+  SdfLayerRefPtr root = newLayer("/tmp/AL_USDMayaTests_LayerGraph/root.usda");
+  SdfLayerRefPtr a = newLayer("/tmp/AL_USDMayaTests_LayerGraph/a/dup.usda");
+  SdfLayerRefPtr b = newLayer("/tmp/AL_USDMayaTests_LayerGraph/b/dup.usda");
+  root->InsertSubLayerPath(a->GetIdentifier());
+  root->InsertSubLayerPath(b->GetIdentifier());
+
+  LayerGraph graph;
+  graph.build(SdfLayerHandleVector{root, a, b});
+  ASSERT_EQ(3u, graph.size());
+
+  SdfLayerHandleVector dups = graph.findLayersByDisplayName("dup.usda");
+  ASSERT_EQ(2u, dups.size());
+  EXPECT_EQ(SdfLayerHandle(a), dups[0]);
+  EXPECT_EQ(SdfLayerHandle(b), dups[1]);
+
+  // identifiers are unique, so always take precedence
+  EXPECT_EQ(SdfLayerHandle(a), graph.findLayer(a->GetIdentifier()));
+  EXPECT_EQ(SdfLayerHandle(b), graph.findLayer(b->GetIdentifier()));
+
+  // when matching display names, the first used layer wins
+  EXPECT_EQ(SdfLayerHandle(a), graph.findLayer("dup.usda"));
+  EXPECT_FALSE(graph.findLayer("missing.usda"));
+  EXPECT_EQ(LayerGraph::kInvalidIndex, graph.indexOf("missing.usda"));
+
+  // both layers should be children of the root, even though they share a display name
+  SdfLayerHandleVector kids = graph.children(root);
+  EXPECT_EQ(2u, kids.size());
+  EXPECT_TRUE(contains(kids, a));
+  EXPECT_TRUE(contains(kids, b));
+  EXPECT_TRUE(graph.children(a).empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// SdfLayerHandleVector descendants(const SdfLayerHandle& layer) const;
+TEST(LayerGraph, cycles)
+{
+  SdfLayerRefPtr a = newLayer("/tmp/AL_USDMayaTests_LayerGraph/cycleA.usda");
+  SdfLayerRefPtr b = newLayer("/tmp/AL_USDMayaTests_LayerGraph/cycleB.usda");
+  SdfLayerRefPtr c = newLayer("/tmp/AL_USDMayaTests_LayerGraph/cycleC.usda");
+  a->InsertSubLayerPath(b->GetIdentifier());
+  b->InsertSubLayerPath(c->GetIdentifier());
+  c->InsertSubLayerPath(a->GetIdentifier());
+
+  // a self reference should also be handled
+  c->InsertSubLayerPath(c->GetIdentifier());
+
+  LayerGraph graph;
+  graph.build(SdfLayerHandleVector{a, b, c});
+
+  SdfLayerHandleVector all = graph.descendants(a);
+  ASSERT_EQ(3u, all.size());
+  EXPECT_EQ(SdfLayerHandle(b), all[0]);
+  EXPECT_EQ(SdfLayerHandle(c), all[1]);
+  EXPECT_EQ(SdfLayerHandle(a), all[2]);
+
+  EXPECT_EQ(2u, graph.children(c).size());
+
+  // layers outside of the graph are ignored
+  SdfLayerRefPtr outside = newLayer("/tmp/AL_USDMayaTests_LayerGraph/outside.usda");
+  EXPECT_TRUE(graph.children(outside).empty());
+  EXPECT_TRUE(graph.descendants(outside).empty());
+
+  graph.clear();
+  EXPECT_TRUE(graph.empty());
+  EXPECT_FALSE(graph.findLayer(a->GetIdentifier()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// void build(const UsdStageRefPtr& stage);
+TEST(LayerGraph, largeLayerStack)
+{
+  const uint32_t numLayers = 4000;
+  SdfLayerRefPtr root = SdfLayer::CreateAnonymous("root.usda");
+  std::vector<SdfLayerRefPtr> sublayers;
+  sublayers.reserve(numLayers);
+  for(uint32_t i = 0; i < numLayers; ++i)
+  {
+    sublayers.push_back(newLayer("/tmp/AL_USDMayaTests_LayerGraph/large/layer" + std::to_string(i) + ".usda"));
+    root->InsertSubLayerPath(sublayers.back()->GetIdentifier(), -1);
+  }
+  UsdStageRefPtr stage = UsdStage::Open(root);
+  ASSERT_TRUE(stage);
+
+  LayerGraph graph;
+  const double buildTime = timeMilliseconds([&] () { graph.build(stage); });
+
+  // the root layer, the session layer, and the sublayers
+  EXPECT_EQ(numLayers + 2, graph.size());
+  EXPECT_EQ(numLayers, graph.children(root).size());
+  EXPECT_EQ(numLayers, graph.descendants(root).size());
+  EXPECT_EQ(SdfLayerHandle(sublayers[numLayers / 2]), graph.findLayer(sublayers[numLayers / 2]->GetIdentifier()));
+
+  printTimings("LayerGraph of " + std::to_string(graph.size()) + " layers", { { "build", buildTime } });
+}
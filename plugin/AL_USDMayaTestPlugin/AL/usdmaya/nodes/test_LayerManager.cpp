@@ -29,7 +29,12 @@
 #include "pxr/usd/usd/usdaFileFormat.h"
 #include "pxr/usd/usdGeom/tokens.h"
 
+#include <atomic>
+#include <thread>
+
 using AL::maya::test::buildTempPath;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 // Utilities -----------------------------------------------------------------------------------------------------------
 
@@ -558,3 +563,219 @@ TEST(LayerManager, simpleSaveRestore)
 //    confirmLayerEditsPresent();
 //  }
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(LayerManager, threadedAddFindRemove)
+{
+  MFileIO::newFile(true);
+
+  auto* manager = AL::usdmaya::nodes::LayerManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+
+  // the first half of the layers stay in the manager, the second half are repeatedly added and removed
+  const uint32_t numLayers = 64;
+  std::vector<SdfLayerRefPtr> layers;
+  std::vector<std::string> identifiers;
+  std::vector<std::string> aliases;
+  for(uint32_t i = 0; i < numLayers; ++i)
+  {
+    layers.push_back(SdfLayer::CreateAnonymous("threadedLayer"));
+    layers.back()->SetComment("dirty");
+    identifiers.push_back(layers.back()->GetIdentifier());
+    aliases.push_back("alias_" + std::to_string(i));
+    if(i < numLayers / 2)
+    {
+      ASSERT_TRUE(manager->addLayer(layers.back(), aliases.back()));
+    }
+  }
+
+  std::atomic<bool> finished(false);
+  std::atomic<uint32_t> failures(0);
+  std::atomic<uint32_t> lookups(0);
+
+  auto reader = [&] ()
+  {
+    uint32_t count = 0;
+    while(!finished)
+    {
+      for(uint32_t i = 0; i < numLayers; ++i, count += 2)
+      {
+        SdfLayerHandle byId = manager->findLayer(identifiers[i]);
+        SdfLayerHandle byAlias = manager->findLayer(aliases[i]);
+        const bool permanent = i < numLayers / 2;
+        if((byId && byId != layers[i]) || (byAlias && byAlias != layers[i]) || (permanent && (!byId || !byAlias)))
+        {
+          ++failures;
+        }
+      }
+    }
+    lookups += count;
+  };
+
+  auto writer = [&] (uint32_t first, uint32_t last)
+  {
+    for(uint32_t iteration = 0; iteration < 200; ++iteration)
+    {
+      for(uint32_t i = first; i < last; ++i)
+      {
+        manager->addLayer(layers[i], aliases[i]);
+        manager->addLayer(layers[i]);
+      }
+      for(uint32_t i = first; i < last; ++i)
+      {
+        manager->removeLayer(layers[i]);
+      }
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for(uint32_t i = 0; i < 4; ++i)
+  {
+    readers.emplace_back(reader);
+  }
+  std::thread writer0(writer, numLayers / 2, numLayers * 3 / 4);
+  std::thread writer1(writer, numLayers * 3 / 4, numLayers);
+  writer0.join();
+  writer1.join();
+  finished = true;
+  for(auto& thread : readers)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(0u, failures.load());
+  EXPECT_LT(0u, lookups.load());
+
+  // the database should be back to the permanent layers only
+  SdfLayerHandleVector found;
+  manager->getLayers(found);
+  EXPECT_EQ(size_t(numLayers / 2), found.size());
+  for(uint32_t i = 0; i < numLayers; ++i)
+  {
+    const bool permanent = i < numLayers / 2;
+    EXPECT_EQ(permanent, bool(manager->findLayer(identifiers[i])));
+    EXPECT_EQ(permanent, bool(manager->findLayer(aliases[i])));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(LayerManager, batchedAddRemove)
+{
+  AL::usdmaya::nodes::LayerDatabase database;
+  SdfLayerRefPtr existing = SdfLayer::CreateAnonymous("existingLayer");
+  existing->SetComment("dirty");
+  ASSERT_TRUE(database.addLayer(existing, "existingAlias"));
+
+  std::vector<SdfLayerRefPtr> layers;
+  for(uint32_t i = 0; i < 8; ++i)
+  {
+    layers.push_back(SdfLayer::CreateAnonymous("batchedLayer"));
+    layers.back()->SetComment("dirty");
+  }
+
+  {
+    AL::usdmaya::nodes::LayerDatabase::ScopedBatch batch(database);
+    for(size_t i = 0; i < layers.size(); ++i)
+    {
+      EXPECT_TRUE(database.addLayer(layers[i], "batchedAlias_" + std::to_string(i)));
+
+      // re-adding within the batch must see the layers added earlier in the same batch
+      EXPECT_FALSE(database.addLayer(layers[i]));
+    }
+    EXPECT_TRUE(database.removeLayer(existing));
+
+    // lookups see the index as it was before the batch, until the batch is published
+    EXPECT_FALSE(database.findLayer(layers[0]->GetIdentifier()));
+    EXPECT_EQ(existing, database.findLayer("existingAlias"));
+  }
+
+  for(size_t i = 0; i < layers.size(); ++i)
+  {
+    EXPECT_EQ(layers[i], database.findLayer(layers[i]->GetIdentifier()));
+    EXPECT_EQ(layers[i], database.findLayer("batchedAlias_" + std::to_string(i)));
+  }
+  EXPECT_FALSE(database.findLayer("existingAlias"));
+  EXPECT_FALSE(database.hasLayer(existing));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(LayerManager, findLayerBenchmark)
+{
+  MFileIO::newFile(true);
+
+  auto* manager = AL::usdmaya::nodes::LayerManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+
+  const uint32_t numLayers = 2000;
+  std::vector<SdfLayerRefPtr> layers;
+  std::vector<std::string> identifiers;
+  for(uint32_t i = 0; i < numLayers; ++i)
+  {
+    layers.push_back(SdfLayer::CreateAnonymous("benchmarkLayer"));
+    layers.back()->SetComment("dirty");
+    identifiers.push_back(layers.back()->GetIdentifier());
+  }
+
+  const double addTime = timeMilliseconds([&] ()
+  {
+    for(const auto& layer : layers)
+    {
+      manager->addLayer(layer);
+    }
+  });
+
+  // re-adding known layers is the common case during resync and save
+  const double readdTime = timeMilliseconds([&] ()
+  {
+    for(const auto& layer : layers)
+    {
+      EXPECT_FALSE(manager->addLayer(layer));
+    }
+  });
+
+  const uint32_t numPasses = 100;
+  uint32_t found = 0;
+  const double findTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t pass = 0; pass < numPasses; ++pass)
+    {
+      for(const auto& identifier : identifiers)
+      {
+        found += manager->findLayer(identifier) ? 1 : 0;
+      }
+    }
+  });
+  EXPECT_EQ(numLayers * numPasses, found);
+
+  const uint32_t numThreads = 4;
+  std::atomic<uint32_t> threadedFound(0);
+  const double threadedFindTime = timeMilliseconds([&] ()
+  {
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < numThreads; ++i)
+    {
+      threads.emplace_back([&] ()
+      {
+        uint32_t count = 0;
+        for(uint32_t pass = 0; pass < numPasses; ++pass)
+        {
+          for(const auto& identifier : identifiers)
+          {
+            count += manager->findLayer(identifier) ? 1 : 0;
+          }
+        }
+        threadedFound += count;
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+  });
+  EXPECT_EQ(numLayers * numPasses * numThreads, threadedFound.load());
+
+  printTimings("LayerManager with " + std::to_string(numLayers) + " layers, " + std::to_string(numPasses) +
+               " lookups of each",
+               { { "add", addTime }, { "re-add", readdTime }, { "lookups", findTime },
+                 { ("lookups over " + std::to_string(numThreads) + " threads").c_str(), threadedFindTime } });
+}
@@ -0,0 +1,308 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/nodes/MeshAnimCreator.h"
+#include "AL/usdmaya/utils/MeshUtils.h"
+
+#include "maya/MDGModifier.h"
+#include "maya/MDoubleArray.h"
+#include "maya/MFileIO.h"
+#include "maya/MFloatPointArray.h"
+#include "maya/MFnDagNode.h"
+#include "maya/MFnMesh.h"
+#include "maya/MFnMeshData.h"
+#include "maya/MGlobal.h"
+#include "maya/MTime.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
+
+using AL::maya::test::buildTempPath;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+namespace
+{
+// a grid of quads in XZ, where the points (and optionally the normals) are animated in Y over the frame range
+void createAnimatedGrid(const std::string& path, uint32_t dim, uint32_t numFrames, bool animateNormals)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/grid"));
+
+  VtArray<int> counts(dim * dim, 4);
+  VtArray<int> connects;
+  connects.reserve(dim * dim * 4);
+  for(uint32_t i = 0; i < dim; ++i)
+  {
+    for(uint32_t j = 0; j < dim; ++j)
+    {
+      const int v = i * (dim + 1) + j;
+      connects.push_back(v);
+      connects.push_back(v + 1);
+      connects.push_back(v + dim + 2);
+      connects.push_back(v + dim + 1);
+    }
+  }
+  mesh.GetFaceVertexCountsAttr().Set(counts);
+  mesh.GetFaceVertexIndicesAttr().Set(connects);
+
+  for(uint32_t frame = 1; frame <= numFrames; ++frame)
+  {
+    VtArray<GfVec3f> points((dim + 1) * (dim + 1));
+    for(uint32_t i = 0, k = 0; i <= dim; ++i)
+    {
+      for(uint32_t j = 0; j <= dim; ++j, ++k)
+      {
+        points[k] = GfVec3f(j, float(frame) * 0.5f + 0.001f * k, i);
+      }
+    }
+    mesh.GetPointsAttr().Set(points, UsdTimeCode(frame));
+
+    if(animateNormals)
+    {
+      VtArray<GfVec3f> normals(connects.size(), GfVec3f(0, 1, 0));
+      normals[0] = GfVec3f(float(frame), 1.0f, 0).GetNormalized();
+      mesh.GetNormalsAttr().Set(normals, UsdTimeCode(frame));
+    }
+  }
+  if(animateNormals)
+  {
+    mesh.SetNormalsInterpolation(UsdGeomTokens->faceVarying);
+  }
+  stage->Export(path, false);
+}
+
+// creates a proxy shape for the file, and a MeshAnimCreator node that is driven by it
+MObject createMeshAnimCreator(const std::string& path, AL::usdmaya::nodes::ProxyShape*& proxy)
+{
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(path.c_str());
+
+  MDGModifier modifier;
+  MObject creator = modifier.createNode("AL_usdmaya_MeshAnimCreator");
+  modifier.doIt();
+
+  MFnDependencyNode fnCreator(creator);
+  fnCreator.findPlug("primPath", true).setString("/grid");
+  modifier.connect(proxy->outStageDataPlug(), fnCreator.findPlug("inStageData", true));
+  modifier.doIt();
+  return creator;
+}
+
+MObject evaluateAt(MObject creator, double frame)
+{
+  MFnDependencyNode fnCreator(creator);
+  fnCreator.findPlug("inTime", true).setValue(MTime(frame, MTime::uiUnit()));
+  return fnCreator.findPlug("outMesh", true).asMObject();
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimCreator, animatedPoints)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimCreatorPoints.usda");
+  const uint32_t dim = 10;
+  createAnimatedGrid(temp_path, dim, 5, false);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = nullptr;
+  MObject creator = createMeshAnimCreator(temp_path, proxy);
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  UsdGeomMesh mesh(proxy->getUsdStage()->GetPrimAtPath(SdfPath("/grid")));
+  for(double frame = 1; frame <= 5; frame += 1)
+  {
+    MObject data = evaluateAt(creator, frame);
+    ASSERT_TRUE(data.hasFn(MFn::kMeshData));
+    MFnMesh fnMesh(data);
+    EXPECT_EQ(int(dim * dim), fnMesh.numPolygons());
+    EXPECT_EQ(int((dim + 1) * (dim + 1)), fnMesh.numVertices());
+    EXPECT_EQ(int(dim * dim * 4), fnMesh.numFaceVertices());
+
+    VtArray<GfVec3f> expected;
+    mesh.GetPointsAttr().Get(&expected, UsdTimeCode(frame));
+    MFloatPointArray points;
+    fnMesh.getPoints(points);
+    ASSERT_EQ(expected.size(), points.length());
+    for(uint32_t i = 0; i < points.length(); ++i)
+    {
+      EXPECT_NEAR(expected[i][0], points[i].x, 1e-5f);
+      EXPECT_NEAR(expected[i][1], points[i].y, 1e-5f);
+      EXPECT_NEAR(expected[i][2], points[i].z, 1e-5f);
+    }
+
+    // the face connects must be preserved between frames
+    MIntArray counts, connects;
+    fnMesh.getVertices(counts, connects);
+    EXPECT_EQ(0, connects[0]);
+    EXPECT_EQ(1, connects[1]);
+    EXPECT_EQ(int(dim + 2), connects[2]);
+    EXPECT_EQ(int(dim + 1), connects[3]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimCreator, animatedNormals)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimCreatorNormals.usda");
+  createAnimatedGrid(temp_path, 4, 3, true);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = nullptr;
+  MObject creator = createMeshAnimCreator(temp_path, proxy);
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  for(double frame = 1; frame <= 3; frame += 1)
+  {
+    MFnMesh fnMesh(evaluateAt(creator, frame));
+    MVector normal;
+    fnMesh.getFaceVertexNormal(0, 0, normal, MSpace::kObject);
+    const GfVec3f expected = GfVec3f(float(frame), 1.0f, 0).GetNormalized();
+    EXPECT_NEAR(expected[0], normal.x, 1e-5);
+    EXPECT_NEAR(expected[1], normal.y, 1e-5);
+    EXPECT_NEAR(expected[2], normal.z, 1e-5);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimCreator, outputBounds)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimCreatorBounds.usda");
+  const uint32_t dim = 4;
+  createAnimatedGrid(temp_path, dim, 3, false);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = nullptr;
+  MObject creator = createMeshAnimCreator(temp_path, proxy);
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  // drive a mesh shape, so that the bounds are computed by maya from the output mesh
+  MFnDagNode fn;
+  MObject xform = fn.create("transform", "animatedGrid");
+  MObject shape = fn.create("mesh", "animatedGridShape", xform);
+  MDGModifier modifier;
+  modifier.connect(MFnDependencyNode(creator).findPlug("outMesh", true), fn.findPlug("inMesh", true));
+  ASSERT_EQ(MStatus(MS::kSuccess), modifier.doIt());
+
+  // the last point of the grid is offset in Y from the first
+  const float pointOffset = 0.001f * ((dim + 1) * (dim + 1) - 1);
+  MObject previous;
+  for(double frame = 1; frame <= 3; frame += 1)
+  {
+    MFnDependencyNode(creator).findPlug("inTime", true).setValue(MTime(frame, MTime::uiUnit()));
+    MDoubleArray bounds;
+    ASSERT_TRUE(MGlobal::executeCommand("exactWorldBoundingBox animatedGrid", bounds));
+    ASSERT_EQ(6u, bounds.length());
+    EXPECT_NEAR(frame * 0.5, bounds[1], 1e-5);
+    EXPECT_NEAR(frame * 0.5 + pointOffset, bounds[4], 1e-5);
+
+    // the data output on the previous frame must not be modified by the update
+    MObject current = evaluateAt(creator, frame);
+    if(!previous.isNull())
+    {
+      MFloatPointArray points;
+      MFnMesh(previous).getPoints(points);
+      EXPECT_NEAR((frame - 1) * 0.5, points[0].y, 1e-5);
+    }
+    previous = current;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimCreator, topologyEdit)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimCreatorTopologyEdit.usda");
+  const uint32_t dim = 4;
+  createAnimatedGrid(temp_path, dim, 3, false);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = nullptr;
+  MObject creator = createMeshAnimCreator(temp_path, proxy);
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+  EXPECT_EQ(int(dim * dim), MFnMesh(evaluateAt(creator, 1)).numPolygons());
+
+  // replace the quads with triangles (keeping the same points), the cached mesh must not be reused
+  UsdGeomMesh mesh(stage->GetPrimAtPath(SdfPath("/grid")));
+  VtArray<int> connects;
+  mesh.GetFaceVertexIndicesAttr().Get(&connects);
+  VtArray<int> triangles;
+  for(size_t i = 0; i < connects.size(); i += 4)
+  {
+    const int quad[6] = { connects[i], connects[i + 1], connects[i + 2], connects[i], connects[i + 2], connects[i + 3] };
+    triangles.insert(triangles.end(), quad, quad + 6);
+  }
+  mesh.GetFaceVertexCountsAttr().Set(VtArray<int>(dim * dim * 2, 3));
+  mesh.GetFaceVertexIndicesAttr().Set(triangles);
+
+  MFnMesh fnMesh(evaluateAt(creator, 2));
+  EXPECT_EQ(int(dim * dim * 2), fnMesh.numPolygons());
+  EXPECT_EQ(int(dim * dim * 6), fnMesh.numFaceVertices());
+  EXPECT_EQ(int(dim * dim * 2), MFnMesh(evaluateAt(creator, 3)).numPolygons());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimCreator, benchmark)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimCreatorBenchmark.usda");
+  const uint32_t dim = 500;
+  const uint32_t numFrames = 20;
+  createAnimatedGrid(temp_path, dim, numFrames, false);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = nullptr;
+  MObject creator = createMeshAnimCreator(temp_path, proxy);
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+  UsdGeomMesh mesh(stage->GetPrimAtPath(SdfPath("/grid")));
+
+  // the first evaluation builds the mesh
+  evaluateAt(creator, 1);
+
+  // per frame evaluation of the node, which only updates the points
+  const double updateTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t frame = 2; frame <= numFrames; ++frame)
+    {
+      MFnMesh fnMesh(evaluateAt(creator, frame));
+      EXPECT_EQ(int((dim + 1) * (dim + 1)), fnMesh.numVertices());
+    }
+  });
+
+  // a full rebuild of the mesh on each frame
+  const double rebuildTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t frame = 2; frame <= numFrames; ++frame)
+    {
+      MFnMeshData fnData;
+      MObject obj = fnData.create();
+      AL::usdmaya::utils::MeshImportContext context(mesh, obj, MString(), UsdTimeCode(frame));
+      context.applyHoleFaces();
+      context.applyVertexNormals();
+      context.applyEdgeCreases();
+      context.applyVertexCreases();
+      context.applyPrimVars();
+    }
+  });
+
+  printTimings("MeshAnimCreator: " + std::to_string(numFrames - 1) + " frames of a " +
+               std::to_string((dim + 1) * (dim + 1)) + " vertex mesh",
+               { { "points update", updateTime }, { "full rebuild", rebuildTime } });
+}
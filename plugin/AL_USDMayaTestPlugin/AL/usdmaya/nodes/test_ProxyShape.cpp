@@ -27,12 +27,15 @@
 #include "maya/MDagModifier.h"
 #include "maya/MFileIO.h"
 #include "maya/MStringArray.h"
+#include "maya/MIntArray.h"
+#include "maya/MDoubleArray.h"
 #include "maya/MCommonSystemUtils.h"
 
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
+#include "pxr/usd/usdGeom/cube.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
@@ -40,6 +43,8 @@
 #include <fstream>
 
 using AL::maya::test::buildTempPath;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 // UsdStageRefPtr ProxyShape::getUsdStage() const;
 // UsdPrim ProxyShape::getRootPrim()
@@ -1126,6 +1131,360 @@ TEST(ProxyShape, selectedPaths)
   AL_USDMAYA_UNTESTED;
 }
 
+// uint64_t SelectionList::version() const
+// bool CombinedSelection::update(const SdfPathHashSet&, uint64_t, const SelectionList&)
+TEST(ProxyShape, combinedSelectionVersioning)
+{
+  using AL::usdmaya::nodes::SelectionList;
+  using AL::usdmaya::nodes::CombinedSelection;
+
+  SelectionList list;
+  SelectionList::SdfPathHashSet selected;
+  uint64_t selectedVersion = 0;
+  CombinedSelection combined;
+
+  // the first update always builds the cache
+  EXPECT_EQ(0u, combined.version());
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  EXPECT_TRUE(combined.paths().empty());
+  const uint64_t v0 = combined.version();
+  EXPECT_NE(0u, v0);
+
+  // no changes, no rebuild
+  EXPECT_FALSE(combined.update(selected, selectedVersion, list));
+  EXPECT_EQ(v0, combined.version());
+
+  // modifying the selection list triggers a rebuild
+  const uint64_t l0 = list.version();
+  list.add(SdfPath("/a"));
+  EXPECT_LT(l0, list.version());
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  EXPECT_LT(v0, combined.version());
+  ASSERT_EQ(1u, combined.paths().size());
+  EXPECT_EQ(SdfPath("/a"), combined.paths()[0]);
+
+  // adding an existing path, or removing a missing one, is not a change
+  const uint64_t l1 = list.version();
+  list.add(SdfPath("/a"));
+  list.remove(SdfPath("/missing"));
+  EXPECT_EQ(l1, list.version());
+  const uint64_t v1 = combined.version();
+  EXPECT_FALSE(combined.update(selected, selectedVersion, list));
+  EXPECT_EQ(v1, combined.version());
+
+  // modifying the selected paths (and bumping their version) triggers a rebuild
+  selected.insert(SdfPath("/b"));
+  selectedVersion = SelectionList::nextVersion();
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  EXPECT_LT(v1, combined.version());
+  EXPECT_EQ(2u, combined.paths().size());
+
+  // restoring a copy of the list (as undo does) is detected as a change
+  SelectionList previous = list;
+  EXPECT_EQ(list.version(), previous.version());
+  list.toggle(SdfPath("/c"));
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  EXPECT_EQ(3u, combined.paths().size());
+  list = previous;
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  EXPECT_EQ(2u, combined.paths().size());
+
+  list.clear();
+  EXPECT_TRUE(combined.update(selected, selectedVersion, list));
+  ASSERT_EQ(1u, combined.paths().size());
+  EXPECT_EQ(SdfPath("/b"), combined.paths()[0]);
+}
+
+// const CombinedSelection& combinedSelection()
+TEST(ProxyShape, combinedSelection)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand("undoInfo -state 1;");
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_combinedSelection.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    UsdGeomXform::Define(stage, SdfPath("/root/a"));
+    UsdGeomXform::Define(stage, SdfPath("/root/b"));
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+
+  const uint64_t v0 = proxy->combinedSelection().version();
+  EXPECT_TRUE(proxy->combinedSelection().paths().empty());
+  EXPECT_EQ(v0, proxy->combinedSelection().version());
+
+  // a maya selection of a prim updates the combined selection
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeSelect -r -pp \"/root/a\" \"AL_usdmaya_ProxyShape1\"", false, true);
+  const uint64_t v1 = proxy->combinedSelection().version();
+  EXPECT_NE(v0, v1);
+  ASSERT_EQ(1u, proxy->combinedSelection().paths().size());
+  EXPECT_EQ(SdfPath("/root/a"), proxy->combinedSelection().paths()[0]);
+
+  // as does an internal selection
+  MGlobal::executeCommand("AL_usdmaya_InternalProxyShapeSelect -a -pp \"/root/b\" \"AL_usdmaya_ProxyShape1\"", false, true);
+  const uint64_t v2 = proxy->combinedSelection().version();
+  EXPECT_NE(v1, v2);
+  EXPECT_EQ(2u, proxy->combinedSelection().paths().size());
+
+  // without any further changes, the version is stable
+  EXPECT_EQ(v2, proxy->combinedSelection().version());
+
+  // undo of both selections is seen by the cache
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_NE(v2, proxy->combinedSelection().version());
+  EXPECT_EQ(1u, proxy->combinedSelection().paths().size());
+  MGlobal::executeCommand("undo", false, true);
+  EXPECT_TRUE(proxy->combinedSelection().paths().empty());
+}
+
+// isRequiredPaths / findRequiredPaths / boundingBoxes / worldMatrices (python bindings)
+TEST(ProxyShape, bulkPythonQueries)
+{
+  MFileIO::newFile(true);
+
+  const uint32_t numPrims = 2000;
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_bulkPythonQueries.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    for(uint32_t i = 0; i < numPrims; ++i)
+    {
+      const SdfPath path(std::string("/root/cube") + std::to_string(i));
+      UsdGeomCube cube = UsdGeomCube::Define(stage, path);
+      UsdGeomXformCommonAPI(cube).SetTranslate(GfVec3d(i, 2.0 * i, 0));
+    }
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+
+  // make every other prim a required path
+  {
+    MDagModifier modifier;
+    for(uint32_t i = 0; i < numPrims; i += 2)
+    {
+      UsdPrim prim = stage->GetPrimAtPath(SdfPath(std::string("/root/cube") + std::to_string(i)));
+      proxy->makeUsdTransformChain(prim, modifier, AL::usdmaya::nodes::ProxyShape::kRequired);
+    }
+    modifier.doIt();
+  }
+
+  const char* const script = R"(
+import struct, time
+import maya.cmds as cmds
+from pxr import Gf, Sdf, Usd, UsdGeom
+import AL.usdmaya
+proxy = AL.usdmaya.ProxyShape.getByName('AL_usdmaya_ProxyShape1')
+stage = proxy.getUsdStage()
+
+# the bulk queries are in maya world space, so move the proxy away from the origin
+cmds.setAttr('%XFORM%.translate', 10, -5, 3)
+cmds.setAttr('%XFORM%.rotateY', 30)
+cmds.setAttr('%XFORM%.scale', 2, 2, 2)
+proxyMatrix = Gf.Matrix4d(*cmds.xform('%XFORM%', q=True, ws=True, m=True))
+paths = [Sdf.Path('/root/cube%d' % i) for i in range(%NUM%)] + [Sdf.Path('/doesNotExist')]
+tc = Usd.TimeCode(1.0)
+purposes = [UsdGeom.Tokens.default_, UsdGeom.Tokens.proxy]
+
+start = time.time()
+perRequired = [proxy.isRequiredPath(p) for p in paths]
+perNames = [proxy.findRequiredPath(p) for p in paths]
+perBounds = []
+perMatrices = []
+for p in paths:
+    prim = stage.GetPrimAtPath(p)
+    if prim:
+        bbox = UsdGeom.Imageable(prim).ComputeWorldBound(tc, *purposes)
+        bbox.Transform(proxyMatrix)
+        perBounds.append(bbox.ComputeAlignedRange())
+        perMatrices.append(UsdGeom.Xformable(prim).ComputeLocalToWorldTransform(tc) * proxyMatrix)
+    else:
+        perBounds.append(None)
+        perMatrices.append(None)
+perPathTime = (time.time() - start) * 1000.0
+
+start = time.time()
+bulkRequired = proxy.isRequiredPaths(paths)
+bulkNames = proxy.findRequiredPaths(paths)
+bulkBounds = proxy.boundingBoxes(paths)
+bulkMatrices = proxy.worldMatrices(paths)
+bulkTime = (time.time() - start) * 1000.0
+
+bulkOk = len(bulkRequired) == len(paths) and len(bulkNames) == len(paths)
+bulkOk = bulkOk and len(bulkBounds) == 48 * len(paths) and len(bulkMatrices) == 128 * len(paths)
+for i in range(len(paths)):
+    bulkOk = bulkOk and bool(bulkRequired[i]) == perRequired[i] and bulkNames[i] == perNames[i]
+    if perBounds[i] is not None:
+        b = struct.unpack_from('6d', bulkBounds, i * 48)
+        m = struct.unpack_from('16d', bulkMatrices, i * 128)
+        bulkOk = bulkOk and all(abs(b[j] - perBounds[i].GetMin()[j]) < 1e-6 for j in range(3))
+        bulkOk = bulkOk and all(abs(b[j + 3] - perBounds[i].GetMax()[j]) < 1e-6 for j in range(3))
+        bulkOk = bulkOk and all(abs(m[j] - perMatrices[i][j // 4][j % 4]) < 1e-6 for j in range(16))
+    else:
+        m = struct.unpack_from('16d', bulkMatrices, i * 128)
+        bulkOk = bulkOk and all(abs(m[j] - proxyMatrix[j // 4][j % 4]) < 1e-6 for j in range(16))
+)";
+
+  MString code(script);
+  code.substitute("%NUM%", MString() + numPrims);
+  code.substitute("%XFORM%", MFnDagNode(xform).fullPathName());
+  ASSERT_TRUE(MGlobal::executePythonCommand(code, false, false));
+
+  MString result;
+  EXPECT_TRUE(MGlobal::executePythonCommand("str(bulkOk)", result));
+  EXPECT_EQ(MString("True"), result);
+
+  MString perPathTime, bulkTime;
+  MGlobal::executePythonCommand("str(perPathTime)", perPathTime);
+  MGlobal::executePythonCommand("str(bulkTime)", bulkTime);
+  printTimings("ProxyShape python queries for " + std::to_string(numPrims) + " paths",
+               { { "per path", perPathTime.asDouble() }, { "bulk", bulkTime.asDouble() } });
+}
+
+TEST(ProxyShape, memoryUsage)
+{
+  MFileIO::newFile(true);
+
+  const uint32_t numPrims = 200;
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_memoryUsage.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    for(uint32_t i = 0; i < numPrims; ++i)
+    {
+      UsdGeomCube::Define(stage, SdfPath(std::string("/root/cube") + std::to_string(i)));
+    }
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  const MString proxyName = fn.name();
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+
+  auto findEntry = [proxy] (const char* name) -> AL::usdmaya::MemoryUsageEntry
+  {
+    AL::usdmaya::MemoryUsage usage;
+    proxy->memoryUsage(usage);
+    for(const auto& entry : usage)
+    {
+      if(entry.name == name)
+        return entry;
+    }
+    return AL::usdmaya::MemoryUsageEntry{name, size_t(-1), 0};
+  };
+
+  EXPECT_EQ(0u, findEntry("requiredPaths").count);
+  EXPECT_EQ(0u, findEntry("selectabilityDB").count);
+
+  // a transform chain for every other prim (plus the shared parent)
+  {
+    MDagModifier modifier;
+    for(uint32_t i = 0; i < numPrims; i += 2)
+    {
+      UsdPrim prim = stage->GetPrimAtPath(SdfPath(std::string("/root/cube") + std::to_string(i)));
+      proxy->makeUsdTransformChain(prim, modifier, AL::usdmaya::nodes::ProxyShape::kRequired);
+    }
+    modifier.doIt();
+  }
+  auto required = findEntry("requiredPaths");
+  EXPECT_EQ(size_t(numPrims / 2 + 1), required.count);
+  EXPECT_LE(required.count * sizeof(SdfPath), required.bytes);
+  EXPECT_EQ(size_t(numPrims / 2 + 1), findEntry("primPathToNode").count);
+
+  // the recorded nodes are forgotten along with the transforms
+  {
+    MDagModifier modifier;
+    for(uint32_t i = 0; i < numPrims; i += 4)
+    {
+      proxy->removeUsdTransformChain(SdfPath(std::string("/root/cube") + std::to_string(i)), modifier,
+                                     AL::usdmaya::nodes::ProxyShape::kRequired);
+    }
+    modifier.doIt();
+  }
+  EXPECT_EQ(size_t(numPrims / 4 + 1), findEntry("requiredPaths").count);
+  EXPECT_EQ(size_t(numPrims / 4 + 1), findEntry("primPathToNode").count);
+
+  SdfPathVector unselectable;
+  for(uint32_t i = 0; i < 10; ++i)
+  {
+    unselectable.push_back(SdfPath(std::string("/root/cube") + std::to_string(i)));
+  }
+  proxy->selectabilityDB().addPathsAsUnselectable(unselectable);
+  auto selectability = findEntry("selectabilityDB");
+  EXPECT_EQ(10u, selectability.count);
+  EXPECT_LE(10 * sizeof(SdfPath), selectability.bytes);
+
+  proxy->boundingBox();
+  EXPECT_EQ(1u, findEntry("boundingBoxCache").count);
+
+  // the command reports the same entries as the C++ API, plus the layer manager
+  MStringArray names;
+  MIntArray counts;
+  MDoubleArray bytes;
+  ASSERT_TRUE(MGlobal::executeCommand(MString("AL_usdmaya_ProxyShapeMemoryUsage -n ") + proxyName, names));
+  ASSERT_TRUE(MGlobal::executeCommand(MString("AL_usdmaya_ProxyShapeMemoryUsage -c ") + proxyName, counts));
+  ASSERT_TRUE(MGlobal::executeCommand(MString("AL_usdmaya_ProxyShapeMemoryUsage -b ") + proxyName, bytes));
+  ASSERT_EQ(names.length(), counts.length());
+  ASSERT_EQ(names.length(), bytes.length());
+
+  double total = 0, expectedTotal = 0;
+  ASSERT_TRUE(MGlobal::executeCommand(MString("AL_usdmaya_ProxyShapeMemoryUsage ") + proxyName, total));
+  bool foundRequired = false;
+  for(uint32_t i = 0; i < names.length(); ++i)
+  {
+    expectedTotal += bytes[i];
+    if(names[i] == "requiredPaths")
+    {
+      foundRequired = true;
+      EXPECT_EQ(int(required.count), counts[i]);
+      EXPECT_EQ(double(required.bytes), bytes[i]);
+    }
+  }
+  EXPECT_TRUE(foundRequired);
+  EXPECT_EQ(expectedTotal, total);
+
+  // and the python API returns a dict of (count, bytes) tuples
+  MString result;
+  const MString script = MString(
+    "import AL.usdmaya\n"
+    "usage = AL.usdmaya.ProxyShape.getByName('") + proxyName + "').memoryUsage()\n";
+  ASSERT_TRUE(MGlobal::executePythonCommand(script));
+  EXPECT_TRUE(MGlobal::executePythonCommand("str(usage['requiredPaths'][0])", result));
+  EXPECT_EQ(MString() + int(required.count), result);
+  EXPECT_TRUE(MGlobal::executePythonCommand("str(usage['selectabilityDB'][0])", result));
+  EXPECT_EQ(MString("10"), result);
+
+  // cheap enough to poll
+  const uint32_t numQueries = 1000;
+  const double queryTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t i = 0; i < numQueries; ++i)
+    {
+      AL::usdmaya::MemoryUsage usage;
+      proxy->memoryUsage(usage);
+    }
+  });
+  printTimings("ProxyShape", { { (std::to_string(numQueries) + " memory usage queries").c_str(), queryTime } });
+}
+
 // void findExcludedGeometry();
 TEST(ProxyShape, findExcludedGeometry)
 {
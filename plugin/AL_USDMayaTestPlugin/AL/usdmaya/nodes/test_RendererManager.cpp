@@ -0,0 +1,195 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/RendererManager.h"
+
+#include "maya/MFileIO.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using AL::usdmaya::nodes::RendererClient;
+using AL::usdmaya::nodes::RendererManager;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+namespace
+{
+// stands in for the imaging engine of a proxy shape, and records the renderer switches it is asked to make
+struct MockRendererClient : public RendererClient
+{
+  bool hasRenderEngine() const override
+    { return engine; }
+
+  bool switchRendererPlugin(const TfToken& plugin) override
+  {
+    ++numSwitches;
+    renderer = plugin;
+    return true;
+  }
+
+  // replaces the engine without going through the manager, so it is back on the default renderer
+  void recreateEngine()
+  {
+    renderer = TfToken();
+    renderEngineCreated();
+  }
+
+  bool engine = true;
+  uint32_t numSwitches = 0;
+  TfToken renderer;
+};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(RendererManager, coalescedChanges)
+{
+  MFileIO::newFile(true);
+  RendererManager* manager = RendererManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+  const MStringArray& plugins = RendererManager::getRendererPluginList();
+  if(plugins.length() < 2)
+  {
+    std::cout << "RendererManager: only one renderer plugin available, skipping renderer switches" << std::endl;
+    return;
+  }
+  manager->setDeferRendererChanges(false);
+  manager->setRendererPlugin(plugins[0]);
+  manager->setDeferRendererChanges(true);
+
+  MockRendererClient a, b;
+  manager->changeRendererPlugin(&a, true);
+  manager->changeRendererPlugin(&b, true);
+  EXPECT_EQ(0u, a.numSwitches);
+  EXPECT_EQ(0u, b.numSwitches);
+
+  // a scripted loop of renderer changes is deferred until the next idle
+  for(uint32_t i = 0; i < 10; ++i)
+  {
+    manager->setRendererPlugin(plugins[1]);
+    manager->setRendererPlugin(plugins[0]);
+  }
+  manager->setRendererPlugin(plugins[1]);
+  EXPECT_TRUE(manager->isRendererChangePending());
+  EXPECT_EQ(0u, a.numSwitches);
+
+  // ... where each engine is switched once
+  EXPECT_EQ(2u, manager->applyRendererChange());
+  EXPECT_FALSE(manager->isRendererChangePending());
+  EXPECT_EQ(1u, a.numSwitches);
+  EXPECT_EQ(1u, b.numSwitches);
+  EXPECT_EQ(a.renderer, b.renderer);
+
+  // switching back and forth before the idle leaves the engines alone
+  manager->setRendererPlugin(plugins[0]);
+  manager->setRendererPlugin(plugins[1]);
+  EXPECT_EQ(0u, manager->applyRendererChange());
+  EXPECT_EQ(1u, a.numSwitches);
+
+  manager->setDeferRendererChanges(false);
+  manager->setRendererPlugin(plugins[0]);
+  EXPECT_FALSE(manager->isRendererChangePending());
+  EXPECT_EQ(2u, a.numSwitches);
+  EXPECT_EQ(2u, b.numSwitches);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(RendererManager, onlyChangedEngines)
+{
+  MFileIO::newFile(true);
+  RendererManager* manager = RendererManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+  const MStringArray& plugins = RendererManager::getRendererPluginList();
+  if(plugins.length() < 2)
+  {
+    return;
+  }
+  manager->setDeferRendererChanges(false);
+  manager->setRendererPlugin(plugins[0]);
+
+  MockRendererClient withEngine, withoutEngine;
+  withoutEngine.engine = false;
+  manager->setRendererPlugin(plugins[1]);
+  EXPECT_EQ(1u, withEngine.numSwitches);
+  EXPECT_EQ(0u, withoutEngine.numSwitches);
+
+  // setting the same renderer again does not rebuild anything
+  manager->setRendererPlugin(plugins[1]);
+  EXPECT_EQ(1u, withEngine.numSwitches);
+
+  // once the engine exists, it picks up the current renderer
+  withoutEngine.engine = true;
+  manager->changeRendererPlugin(&withoutEngine, true);
+  EXPECT_EQ(1u, withoutEngine.numSwitches);
+  EXPECT_EQ(withEngine.renderer, withoutEngine.renderer);
+
+  // a new engine on the default renderer needs no switch
+  manager->setRendererPlugin(plugins[0]);
+  MockRendererClient created;
+  manager->changeRendererPlugin(&created, true);
+  EXPECT_EQ(0u, created.numSwitches);
+  // an engine recreated outside of the manager is switched back to the current renderer
+  manager->setRendererPlugin(plugins[1]);
+  EXPECT_EQ(1u, created.numSwitches);
+  created.recreateEngine();
+  manager->changeRendererPlugin(&created);
+  EXPECT_EQ(2u, created.numSwitches);
+  EXPECT_EQ(withEngine.renderer, created.renderer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(RendererManager, benchmark)
+{
+  MFileIO::newFile(true);
+  RendererManager* manager = RendererManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+  const MStringArray& plugins = RendererManager::getRendererPluginList();
+  if(plugins.length() < 2)
+  {
+    return;
+  }
+  manager->setRendererPlugin(plugins[0]);
+  manager->applyRendererChange();
+  manager->setDeferRendererChanges(true);
+
+  const uint32_t numClients = 50;
+  std::vector<std::unique_ptr<MockRendererClient>> clients;
+  for(uint32_t i = 0; i < numClients; ++i)
+  {
+    clients.emplace_back(new MockRendererClient);
+  }
+
+  const uint32_t numChanges = 1000;
+  const double changeTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t i = 0; i < numChanges; ++i)
+    {
+      manager->setRendererPlugin(plugins[(i + 1) % 2]);
+    }
+    manager->applyRendererChange();
+  });
+
+  // 1000 changes ending on plugins[0] results in no switches at all
+  for(const auto& client : clients)
+  {
+    EXPECT_EQ(0u, client->numSwitches);
+  }
+  manager->setDeferRendererChanges(false);
+
+  printTimings("RendererManager with " + std::to_string(numClients) + " proxies",
+               { { (std::to_string(numChanges) + " renderer changes").c_str(), changeTime } });
+}
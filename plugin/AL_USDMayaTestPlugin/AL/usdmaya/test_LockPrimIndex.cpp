@@ -0,0 +1,175 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <AL/usdmaya/LockPrimIndex.h>
+#include "AL/maya/test/testHelpers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace AL::usdmaya;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+namespace
+{
+SdfPathVector sorted(SdfPathVector paths)
+{
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+}
+
+TEST(LockPrimIndex, inheritance)
+{
+  LockPrimIndex index;
+  const SdfPath a("/A"), b("/A/B"), c("/A/B/C"), d("/A/D");
+
+  index.setState(a, LockPrimIndex::kLockInherited);
+  index.setState(b, LockPrimIndex::kLockInherited);
+  index.setState(c, LockPrimIndex::kLockInherited);
+  index.setState(d, LockPrimIndex::kLockTransform);
+  EXPECT_FALSE(index.isLocked(a));
+  EXPECT_FALSE(index.isLocked(b));
+  EXPECT_FALSE(index.isLocked(c));
+  EXPECT_TRUE(index.isLocked(d));
+
+  SdfPathVector changed;
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(SdfPathVector{d}, changed);
+
+  // locking the root passes the lock down the inherited chain
+  EXPECT_TRUE(index.setState(a, LockPrimIndex::kLockTransform));
+  EXPECT_TRUE(index.isLocked(a));
+  EXPECT_TRUE(index.isLocked(b));
+  EXPECT_TRUE(index.isLocked(c));
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(sorted({a, b, c}), sorted(changed));
+
+  // setting the same state again changes nothing
+  EXPECT_FALSE(index.setState(a, LockPrimIndex::kLockTransform));
+  EXPECT_EQ(0u, index.numChangedPaths());
+
+  // an unlocked (untracked) prim stops the inheritance
+  EXPECT_TRUE(index.remove(b));
+  EXPECT_TRUE(index.isLocked(a));
+  EXPECT_FALSE(index.isLocked(b));
+  EXPECT_FALSE(index.isLocked(c));
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(sorted({b, c}), sorted(changed));
+
+  EXPECT_TRUE(index.setState(b, LockPrimIndex::kLockInherited));
+  EXPECT_TRUE(index.isLocked(c));
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(sorted({b, c}), sorted(changed));
+
+  // releasing the root lock leaves the explicitly locked prim alone
+  EXPECT_TRUE(index.setState(a, LockPrimIndex::kLockInherited));
+  EXPECT_FALSE(index.isLocked(b));
+  EXPECT_FALSE(index.isLocked(c));
+  EXPECT_TRUE(index.isLocked(d));
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(sorted({a, b, c}), sorted(changed));
+}
+
+TEST(LockPrimIndex, rebuild)
+{
+  LockPrimIndex index;
+  const SdfPath a("/A"), b("/A/B"), c("/A/B/C"), x("/X");
+  index.setState(a, LockPrimIndex::kLockTransform);
+  index.setState(b, LockPrimIndex::kLockInherited);
+  index.setState(x, LockPrimIndex::kLockTransform);
+  SdfPathVector changed;
+  index.takeChangedPaths(changed);
+
+  // /X disappears, /A/B/C is new, and /A is now only inherited
+  index.beginRebuild();
+  index.setState(c, LockPrimIndex::kLockInherited);
+  index.setState(b, LockPrimIndex::kLockTransform);
+  index.setState(a, LockPrimIndex::kLockInherited);
+  index.endRebuild();
+
+  EXPECT_EQ(3u, index.size());
+  EXPECT_FALSE(index.isLocked(a));
+  EXPECT_TRUE(index.isLocked(b));
+  EXPECT_TRUE(index.isLocked(c));
+  EXPECT_FALSE(index.isLocked(x));
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(sorted({a, c, x}), sorted(changed));
+}
+
+TEST(LockPrimIndex, benchmark)
+{
+  // 100 groups of 250 prims, each with lock_inherited below a group root
+  const uint32_t numGroups = 100;
+  const uint32_t numChildren = 250;
+  SdfPathVector roots;
+  SdfPathVector leaves;
+  for(uint32_t i = 0; i < numGroups; ++i)
+  {
+    roots.push_back(SdfPath("/root/group" + std::to_string(i)));
+    for(uint32_t j = 0; j < numChildren; ++j)
+    {
+      leaves.push_back(roots.back().AppendChild(TfToken("child" + std::to_string(j))));
+    }
+  }
+
+  LockPrimIndex index;
+  const double rebuildTime = timeMilliseconds([&] ()
+  {
+    index.beginRebuild();
+    index.setState(SdfPath("/root"), LockPrimIndex::kLockInherited);
+    for(uint32_t i = 0; i < numGroups; ++i)
+    {
+      index.setState(roots[i], LockPrimIndex::kLockTransform);
+      for(uint32_t j = 0; j < numChildren; ++j)
+      {
+        index.setState(leaves[i * numChildren + j], LockPrimIndex::kLockInherited);
+      }
+    }
+    index.endRebuild();
+  });
+
+  SdfPathVector changed;
+  index.takeChangedPaths(changed);
+  EXPECT_EQ(numGroups * (numChildren + 1), changed.size());
+
+  // toggle the lock on a single group, which should only touch that group
+  const uint32_t numToggles = 1000;
+  const double toggleTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t i = 0; i < numToggles; ++i)
+    {
+      const SdfPath& root = roots[i % numGroups];
+      index.setState(root, LockPrimIndex::kLockInherited);
+      index.setState(root, LockPrimIndex::kLockTransform);
+    }
+  });
+  EXPECT_EQ(numGroups * (numChildren + 1), index.numChangedPaths());
+  for(const SdfPath& leaf : leaves)
+  {
+    EXPECT_TRUE(index.isLocked(leaf));
+  }
+
+  // a leaf that is already locked through inheritance does not report a change
+  index.takeChangedPaths(changed);
+  EXPECT_TRUE(index.setState(leaves.back(), LockPrimIndex::kLockTransform));
+  EXPECT_EQ(0u, index.numChangedPaths());
+
+  printTimings("LockPrimIndex of " + std::to_string(index.size()) + " lock annotations",
+               { { "rebuild", rebuildTime }, { (std::to_string(numToggles) + " group lock toggles").c_str(), toggleTime } });
+}
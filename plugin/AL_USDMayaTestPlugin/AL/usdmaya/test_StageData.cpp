@@ -0,0 +1,101 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "AL/usdmaya/StageData.h"
+#include "AL/maya/test/testHelpers.h"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using AL::usdmaya::StageData;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
+
+TEST(StageData, releaseAllStages)
+{
+  const size_t numBefore = StageData::numInstances();
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  {
+    std::unique_ptr<StageData> a(new StageData);
+    std::unique_ptr<StageData> b(new StageData);
+    std::unique_ptr<StageData> c(new StageData);
+    EXPECT_EQ(numBefore + 3, StageData::numInstances());
+    a->stage = stage;
+    b->stage = stage;
+    c->stage = stage;
+
+    // unlink from the middle of the list
+    b.reset();
+    EXPECT_EQ(numBefore + 2, StageData::numInstances());
+
+    StageData::releaseAllStages();
+    EXPECT_FALSE(a->stage);
+    EXPECT_FALSE(c->stage);
+  }
+  EXPECT_EQ(numBefore, StageData::numInstances());
+}
+
+TEST(StageData, stressCreateDestroy)
+{
+  const size_t numBefore = StageData::numInstances();
+  const uint32_t numInstances = 2000000;
+
+  const double serialTime = timeMilliseconds([numInstances] ()
+  {
+    for(uint32_t i = 0; i < numInstances; ++i)
+    {
+      StageData* data = (StageData*)StageData::creator();
+      delete data;
+    }
+  });
+
+  // DG evaluation creates data objects from multiple threads
+  const uint32_t numThreads = 8;
+  const double threadedTime = timeMilliseconds([numInstances, numThreads] ()
+  {
+    std::vector<std::thread> threads;
+    for(uint32_t t = 0; t < numThreads; ++t)
+    {
+      threads.emplace_back([numInstances, numThreads] ()
+      {
+        std::vector<StageData*> live;
+        live.reserve(64);
+        for(uint32_t i = 0; i < numInstances / numThreads; ++i)
+        {
+          live.push_back((StageData*)StageData::creator());
+          if(live.size() == 64)
+          {
+            for(StageData* data : live)
+              delete data;
+            live.clear();
+          }
+        }
+        for(StageData* data : live)
+          delete data;
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+  });
+
+  EXPECT_EQ(numBefore, StageData::numInstances());
+  printTimings("StageData: " + std::to_string(numInstances) + " create/destroy",
+               { { "serial", serialTime }, { ("over " + std::to_string(numThreads) + " threads").c_str(), threadedTime } });
+}
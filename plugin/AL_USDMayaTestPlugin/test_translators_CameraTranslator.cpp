@@ -21,6 +21,7 @@
 #include "AL/usdmaya/fileio/AnimationTranslator.h"
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/StageCache.h"
+#include "AL/usdmaya/utils/DgNodeHelper.h"
 
 
 #include "maya/MFileIO.h"
@@ -30,6 +31,8 @@
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usdGeom/camera.h"
 
+#include <cmath>
+
 using AL::usdmaya::fileio::ExporterParams;
 using AL::usdmaya::fileio::ImporterParams;
 using AL::usdmaya::fileio::AnimationTranslator;
@@ -37,6 +40,8 @@ using AL::maya::test::buildTempPath;
 using AL::maya::test::randomNode;
 using AL::maya::test::randomAnimatedNode;
 using AL::maya::test::compareNodes;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  Test some of the functionality of the CameraTranslator.
@@ -229,3 +234,144 @@ TEST(translators_CameraTranslator, cameraShapeName)
   ASSERT_EQ(MString("camShape"), shapeDag.name());
 }
 
+
+TEST(translators_CameraTranslator, animationKeyReduction)
+{
+  MFileIO::newFile(true);
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomCamera camera = UsdGeomCamera::Define(stage, SdfPath("/camera"));
+  UsdAttribute focalLength = camera.GetFocalLengthAttr();
+
+  // a linear ramp, followed by a hold, followed by a curve
+  for(int frame = 1; frame <= 30; ++frame)
+  {
+    const float value = frame <= 10 ? 9.0f + frame : frame <= 20 ? 19.0f : 19.0f + float((frame - 20) * (frame - 20));
+    focalLength.Set(value, UsdTimeCode(frame));
+  }
+
+  std::vector<MFnAnimCurve::TangentType> inTangents, outTangents;
+  for(const bool reduce : { false, true })
+  {
+    MDagModifier mod;
+    MObject xform = mod.createNode("transform");
+    MObject node = mod.createNode("camera", xform);
+    EXPECT_EQ(MStatus(MS::kSuccess), mod.doIt());
+
+    MFnDependencyNode fn(node);
+    MObject attr = fn.attribute("focalLength");
+    EXPECT_EQ(MStatus(MS::kSuccess), AL::usdmaya::utils::DgNodeHelper::setFloatAttrAnim(node, attr, focalLength, 1.0, reduce));
+
+    MFnAnimCurve fnCurve(MPlug(node, attr).source().node());
+    // the ramp collapses to its end points, the hold to its end point, and every key of the curve is kept
+    EXPECT_EQ(reduce ? 13u : 30u, fnCurve.numKeys());
+
+    for(int frame = 1; frame <= 30; ++frame)
+    {
+      float expected;
+      focalLength.Get(&expected, UsdTimeCode(frame));
+      EXPECT_NEAR(expected, fnCurve.evaluate(MTime(frame, MTime::kFilm)), 1e-4);
+    }
+
+    if(!reduce)
+    {
+      for(uint32_t i = 0; i < fnCurve.numKeys(); ++i)
+      {
+        inTangents.push_back(fnCurve.inTangentType(i));
+        outTangents.push_back(fnCurve.outTangentType(i));
+      }
+      continue;
+    }
+
+    // only the sides of the keys that bound a removed run (1 -> 10 and 10 -> 20) are linear, every other tangent
+    // is the same as when no keys are removed
+    EXPECT_EQ(inTangents[0], fnCurve.inTangentType(0));
+    EXPECT_EQ(MFnAnimCurve::kTangentLinear, fnCurve.outTangentType(0));
+    EXPECT_EQ(MFnAnimCurve::kTangentLinear, fnCurve.inTangentType(1));
+    EXPECT_EQ(MFnAnimCurve::kTangentLinear, fnCurve.outTangentType(1));
+    EXPECT_EQ(MFnAnimCurve::kTangentLinear, fnCurve.inTangentType(2));
+    EXPECT_EQ(outTangents[19], fnCurve.outTangentType(2));
+    for(uint32_t i = 3; i < fnCurve.numKeys(); ++i)
+    {
+      EXPECT_EQ(inTangents[i + 17], fnCurve.inTangentType(i));
+      EXPECT_EQ(outTangents[i + 17], fnCurve.outTangentType(i));
+    }
+  }
+}
+
+TEST(translators_CameraTranslator, animatedImportBenchmark)
+{
+  MFileIO::newFile(true);
+  const uint32_t numFrames = 10000;
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomCamera camera = UsdGeomCamera::Define(stage, SdfPath("/camera"));
+  const UsdAttribute attributes[] = {
+    camera.GetHorizontalApertureAttr(),
+    camera.GetVerticalApertureAttr(),
+    camera.GetHorizontalApertureOffsetAttr(),
+    camera.GetVerticalApertureOffsetAttr(),
+    camera.GetFocalLengthAttr(),
+    camera.GetFStopAttr(),
+    camera.GetFocusDistanceAttr(),
+  };
+  const char* const attributeNames[] = {
+    "horizontalFilmAperture",
+    "verticalFilmAperture",
+    "horizontalFilmOffset",
+    "verticalFilmOffset",
+    "focalLength",
+    "fStop",
+    "focusDistance",
+  };
+  const uint32_t numAttributes = sizeof(attributeNames) / sizeof(const char* const);
+  for(uint32_t frame = 1; frame <= numFrames; ++frame)
+  {
+    float value = 10.0f + std::sin(frame * 0.01f);
+    for(const UsdAttribute& attribute : attributes)
+    {
+      attribute.Set(value, UsdTimeCode(frame));
+      value += 1.0f;
+    }
+  }
+
+  MDagModifier mod;
+  MObject xform = mod.createNode("transform");
+  MObject node = mod.createNode("camera", xform);
+  MObject xformB = mod.createNode("transform");
+  EXPECT_EQ(MStatus(MS::kSuccess), mod.doIt());
+
+  // the previous approach, which read and keyed each sample in turn
+  MFnDependencyNode fn(node);
+  const double perKeyTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t i = 0; i < numAttributes; ++i)
+    {
+      MFnAnimCurve fnCurve;
+      fnCurve.create(fn.findPlug(attributeNames[i], true));
+      std::vector<double> times;
+      attributes[i].GetTimeSamples(&times);
+      float value;
+      for(const double time : times)
+      {
+        if(attributes[i].Get(&value, time) && fnCurve.animCurveType() != MFnAnimCurve::kAnimCurveUnknown)
+        {
+          fnCurve.addKey(MTime(time, MTime::kFilm), value);
+        }
+      }
+    }
+  });
+
+  AL::usdmaya::fileio::translators::TranslatorManufacture manufacture(nullptr);
+  AL::usdmaya::fileio::translators::TranslatorRefPtr xtrans = manufacture.get(TfToken("Camera"));
+  MObject nodeB;
+  const double importTime = timeMilliseconds([&] ()
+  {
+    EXPECT_EQ(MStatus(MS::kSuccess), xtrans->import(camera.GetPrim(), xformB, nodeB));
+  });
+
+  MFnDependencyNode fnB(nodeB);
+  MFnAnimCurve fnCurve(fnB.findPlug("focalLength", true).source().node());
+  EXPECT_EQ(numFrames, fnCurve.numKeys());
+
+  printTimings("CameraTranslator: " + std::to_string(numFrames) + " frames of camera animation",
+               { { "import", importTime }, { "keying each sample in turn", perKeyTime } });
+}
@@ -60,6 +60,8 @@ using AL::maya::test::randInt64;
 using AL::maya::test::randFloat;
 using AL::maya::test::randDouble;
 using AL::maya::test::comparePlugs;
+using AL::maya::test::timeMilliseconds;
+using AL::maya::test::printTimings;
 
 
 namespace {
@@ -1811,3 +1813,66 @@ TEST(translators_DgNodeTranslator, dynamicAttributesTest)
 
 
 
+
+// Float data written to a double3 array does not match the element layout, so it is written an element at a time.
+TEST(translators_DgNodeTranslator, vec3_array_fallback)
+{
+  setUp();
+  std::vector<float> orig(SIZE * 3);
+  std::vector<double> result(SIZE * 3, 0.0);
+  for(auto& value : orig)
+  {
+    value = randFloat();
+  }
+  const char* const longName = "longVec3FallbackArrayName";
+  const char* const shortName = "lv3fban";
+  const uint32_t flags = kCached | kReadable | kWritable | kStorable | kArray | kUsesArrayDataBuilder;
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addVec3dAttr(m_node, longName, shortName, flags));
+  EXPECT_EQ(MStatus(MS::kSuccess), DgNodeTranslator::setVec3Array(m_node, findAttribute(longName), orig.data(), SIZE));
+  EXPECT_EQ(MStatus(MS::kSuccess), DgNodeTranslator::getVec3Array(m_node, findAttribute(longName), result.data(), SIZE));
+  for(int i = 0 ; i < SIZE * 3; ++i)
+  {
+    EXPECT_EQ(double(orig[i]), result[i]);
+  }
+}
+
+// Writes a large array with a single plug write, compared to writing each element plug in turn.
+TEST(translators_DgNodeTranslator, large_array)
+{
+  setUp();
+  const uint32_t count = 200000;
+  std::vector<float> orig(count * 3);
+  std::vector<float> result(count * 3, 0.0f);
+  for(auto& value : orig)
+  {
+    value = randFloat();
+  }
+  const char* const longName = "longLargeVec3fArrayName";
+  const char* const shortName = "llv3fan";
+  const uint32_t flags = kCached | kReadable | kWritable | kStorable | kArray | kUsesArrayDataBuilder;
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addVec3fAttr(m_node, longName, shortName, flags));
+  const MObject attribute = findAttribute(longName);
+
+  const double arrayTime = timeMilliseconds([&] ()
+  {
+    EXPECT_EQ(MStatus(MS::kSuccess), DgNodeTranslator::setVec3Array(m_node, attribute, orig.data(), count));
+  });
+
+  EXPECT_EQ(MStatus(MS::kSuccess), DgNodeTranslator::getVec3Array(m_node, attribute, result.data(), count));
+  EXPECT_TRUE(orig == result);
+
+  MPlug plug(m_node, attribute);
+  const double elementTime = timeMilliseconds([&] ()
+  {
+    for(uint32_t i = 0, j = 0; i != count; ++i, j += 3)
+    {
+      MPlug element = plug.elementByLogicalIndex(i);
+      element.child(0).setFloat(orig[j]);
+      element.child(1).setFloat(orig[j + 1]);
+      element.child(2).setFloat(orig[j + 2]);
+    }
+  });
+
+  printTimings("DgNodeHelper::setVec3Array of " + std::to_string(count) + " elements",
+               { { "setVec3Array", arrayTime }, { "setting each element plug", elementTime } });
+}
@@ -37,6 +37,8 @@
 
 #include <pxr/usd/usd/attribute.h>
 
+#include <algorithm>
+
 
 namespace {
   // If the given source and destArrayPlug are already connected, returns the index they are
@@ -128,11 +130,27 @@ MStatus MayaReference::import(const UsdPrim& prim, MObject& parent, MObject& cre
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MayaReference::import prim=%s\n", prim.GetPath().GetText());
   MStatus status;
-  status = m_mayaReferenceLogic.LoadMayaReference(prim, parent, context());
+  // postImport is only called when importing into a proxy shape, so the import command loads each reference immediately
+  const bool batched = context() && context()->getProxyShape();
+  status = m_mayaReferenceLogic.LoadMayaReference(prim, parent, context(), batched ? &m_batch : nullptr);
 
   return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MStatus MayaReference::postImport(const UsdPrim& prim)
+{
+  // postImport is only called once every prim has been imported, so the first call loads the whole batch.
+  if(m_batch.empty())
+  {
+    m_batch.clear();
+    return MS::kSuccess;
+  }
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MayaReference::postImport prim=%s loading %zu references\n",
+                                      prim.GetPath().GetText(), m_batch.size());
+  return m_mayaReferenceLogic.loadReferences(m_batch);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MayaReference::tearDown(const SdfPath& primPath)
 {
@@ -285,10 +303,77 @@ MStatus MayaReferenceLogic::update(const UsdPrim& prim, MObject parent, MObject
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MStatus MayaReferenceLogic::LoadMayaReference(const UsdPrim& prim, MObject& parent, TranslatorContextPtr context) const
+MObject MayaReferenceLogic::findReferenceForNamespace(const MString& rigNamespace, ReferenceBatch* batch) const
+{
+  MStatus status;
+  auto primNamespace = [&status](MFnReference& fnRef, MString& result) -> bool
+  {
+    if(fnRef.isFromReferencedFile())
+      return false;
+    MPlug primNSPlug = fnRef.findPlug(MString(m_primNSAttr), true, &status);
+    if(status == MS::kInvalidParameter)
+    {
+      // No prim NS attribute. These aren't the droids we're looking for.
+      return false;
+    }
+    result = primNSPlug.asString();
+    return true;
+  };
+
+  if(!batch)
+  {
+    for(MItDependencyNodes refIter(MFn::kReference); !refIter.isDone(); refIter.next())
+    {
+      MObject referenceObject = refIter.item();
+      MFnReference tempRefFn(referenceObject);
+      MString ns;
+      if(primNamespace(tempRefFn, ns) && ns == rigNamespace)
+      {
+        return referenceObject;
+      }
+    }
+    return MObject::kNullObj;
+  }
+
+  // index the existing references once per batch, rather than scanning every reference node for every prim
+  if(!batch->m_indexed)
+  {
+    for(MItDependencyNodes refIter(MFn::kReference); !refIter.isDone(); refIter.next())
+    {
+      MObject referenceObject = refIter.item();
+      MFnReference tempRefFn(referenceObject);
+      MString ns;
+      if(primNamespace(tempRefFn, ns))
+      {
+        batch->m_referencesByNamespace.emplace(AL::maya::utils::convert(ns), MObjectHandle(referenceObject));
+      }
+    }
+    batch->m_indexed = true;
+  }
+
+  auto it = batch->m_referencesByNamespace.find(AL::maya::utils::convert(rigNamespace));
+  if(it != batch->m_referencesByNamespace.end() && it->second.isValid())
+  {
+    return it->second.object();
+  }
+  return MObject::kNullObj;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MayaReferenceLogic::setAssociatedReferenceNode(const UsdPrim& prim, MFnReference& refNode) const
+{
+  static const TfToken maya_associatedReferenceNode("maya_associatedReferenceNode");
+  // To avoid the error that USD complains about editing to same layer simultaneously from different threads,
+  // we record it as custom data instead of creating an attribute.
+  VtValue value(AL::maya::utils::convert(refNode.name()));
+  prim.SetCustomDataByKey(maya_associatedReferenceNode, value);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus MayaReferenceLogic::LoadMayaReference(const UsdPrim& prim, MObject& parent, TranslatorContextPtr context,
+                                              ReferenceBatch* batch) const
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MayaReferenceLogic::LoadMayaReference prim=%s\n", prim.GetPath().GetText());
-  const TfToken maya_associatedReferenceNode("maya_associatedReferenceNode");
   MStatus status;
 
   SdfAssetPath mayaReferenceAssetPath;
@@ -325,33 +410,17 @@ MStatus MayaReferenceLogic::LoadMayaReference(const UsdPrim& prim, MObject& pare
   MFnDagNode parentDag(parent, &status);
   AL_MAYA_CHECK_ERROR(status, "failed to attach function set to parent transform for reference.");
 
-  MObject referenceObject;
-
   // Check to see if we already have a reference matching the prim's namespace.
-  for (MItDependencyNodes refIter(MFn::kReference); !refIter.isDone(); refIter.next())
+  MObject referenceObject = findReferenceForNamespace(rigNamespaceM, batch);
+  if(!referenceObject.isNull())
   {
-    referenceObject = refIter.item();
+    // Reconnect the reference node's `associatedNode` attr before
+    // loading it, since the previous connection may be gone.
     MFnReference tempRefFn(referenceObject);
-    if (!tempRefFn.isFromReferencedFile())
-    {
-      MPlug primNSPlug = tempRefFn.findPlug(MString(m_primNSAttr), true, &status);
-      if (status == MS::kInvalidParameter)
-      {
-        // No prim NS attribute. These aren't the droids we're looking for.
-        continue;
-      }
+    connectReferenceAssociatedNode(parentDag, tempRefFn);
 
-      // Test the namespace
-      if (primNSPlug.asString() == rigNamespaceM)
-      {
-        // We found one with the same namespace - run an update instead of a load
-
-        // Reconnect the reference node's `associatedNode` attr before
-        // loading it, since the previous connection may be gone.
-        connectReferenceAssociatedNode(parentDag, tempRefFn);
-        return update(prim, parent, referenceObject);
-      }
-    }
+    // We found one with the same namespace - run an update instead of a load
+    return update(prim, parent, referenceObject);
   }
 
   // Need to create new reference (initially unloaded).
@@ -389,16 +458,6 @@ MStatus MayaReferenceLogic::LoadMayaReference(const UsdPrim& prim, MObject& pare
   MFnReference refDependNode(referenceObject);
   connectReferenceAssociatedNode(parentDag, refDependNode);
 
-  // Now load the reference to properly trigger the kAfterReferenceLoad callback
-  MFileIO::loadReferenceByNode(referenceObject, &status);
-  AL_MAYA_CHECK_ERROR(status, MString("failed to load reference: ") + referenceCommand);
-  {
-    // To avoid the error that USD complains about editing to same layer simultaneously from different threads,
-    // we record it as custom data instead of creating an attribute.
-    VtValue value(AL::maya::utils::convert(refDependNode.name()));
-    prim.SetCustomDataByKey(maya_associatedReferenceNode, value);
-  }
-
   // Add attribute to the reference node to track the namespace the prim was
   // trying to use, since the actual namespace might be different.
   MObject primNSAttr = refDependNode.attribute(MString(m_primNSAttr), &status);
@@ -428,9 +487,74 @@ MStatus MayaReferenceLogic::LoadMayaReference(const UsdPrim& prim, MObject& pare
     AL_MAYA_CHECK_ERROR(status, "failed to execute reference attr modifier");
   }
 
+  if(batch)
+  {
+    ReferenceBatch::PendingReference pending;
+    pending.m_reference = MObjectHandle(referenceObject);
+    pending.m_path = mayaReferencePath;
+    pending.m_prim = prim;
+    batch->m_assetOrder.emplace(AL::maya::utils::convert(mayaReferencePath), batch->m_assetOrder.size());
+    batch->m_pending.push_back(pending);
+    return MS::kSuccess;
+  }
+
+  // Now load the reference to properly trigger the kAfterReferenceLoad callback
+  MFileIO::loadReferenceByNode(referenceObject, &status);
+  AL_MAYA_CHECK_ERROR(status, MString("failed to load reference: ") + referenceCommand);
+  setAssociatedReferenceNode(prim, refDependNode);
+
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MStatus MayaReferenceLogic::loadReferences(ReferenceBatch& batch) const
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MayaReferenceLogic::loadReferences count=%zu assets=%zu\n",
+                                      batch.size(), batch.numAssets());
+
+  // load the references to each asset consecutively, so that the asset is only read from disk by its first load.
+  // The sort is stable, so the references to each asset are still loaded in the order their prims were imported.
+  std::vector<std::pair<size_t, ReferenceBatch::PendingReference> > pending;
+  pending.reserve(batch.m_pending.size());
+  for(auto& ref : batch.m_pending)
+  {
+    pending.emplace_back(batch.m_assetOrder[AL::maya::utils::convert(ref.m_path)], std::move(ref));
+  }
+  batch.clear();
+  std::stable_sort(pending.begin(), pending.end(),
+                   [] (const std::pair<size_t, ReferenceBatch::PendingReference>& a,
+                       const std::pair<size_t, ReferenceBatch::PendingReference>& b)
+                   { return a.first < b.first; });
+
+  MStatus result = MS::kSuccess;
+  for(auto& assetAndRef : pending)
+  {
+    const ReferenceBatch::PendingReference& ref = assetAndRef.second;
+    if(!ref.m_reference.isValid())
+    {
+      continue;
+    }
+    MObject referenceObject = ref.m_reference.object();
+    MFnReference refDependNode(referenceObject);
+
+    // Now load the reference to properly trigger the kAfterReferenceLoad callback
+    MStatus status;
+    MFileIO::loadReferenceByNode(referenceObject, &status);
+    if(!status)
+    {
+      MGlobal::displayError(MString("failed to load reference: ") + ref.m_path);
+      result = status;
+      continue;
+    }
+
+    if(ref.m_prim.IsValid())
+    {
+      setAssociatedReferenceNode(ref.m_prim, refDependNode);
+    }
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MayaReferenceLogic::UnloadMayaReference(MObject& parent) const
 {
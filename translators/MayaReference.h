@@ -21,6 +21,12 @@
 
 #include "pxr/usd/usd/stage.h"
 
+#include "maya/MObjectHandle.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
@@ -33,12 +39,67 @@ class MayaReferenceLogic
 {
 public:
 
-  MStatus LoadMayaReference(const UsdPrim& prim, MObject& parent, TranslatorContextPtr context) const;
+  //--------------------------------------------------------------------------------------------------------------------
+  /// \brief  Gathers the references created by a sequence of LoadMayaReference calls, so that they can be created
+  ///         unloaded and then loaded together in a single pass by loadReferences. Each prim still gets its own
+  ///         reference node (in its own namespace), but the references to each asset are loaded consecutively.
+  //--------------------------------------------------------------------------------------------------------------------
+  struct ReferenceBatch
+  {
+    /// a reference node that has been created (unloaded), and the prim it was created for
+    struct PendingReference
+    {
+      MObjectHandle m_reference;
+      MString m_path;
+      UsdPrim m_prim;
+    };
+
+    /// \brief  returns true if there are no references awaiting a load
+    bool empty() const
+      { return m_pending.empty(); }
+
+    /// \brief  returns the number of references awaiting a load
+    size_t size() const
+      { return m_pending.size(); }
+
+    /// \brief  returns the number of unique assets referenced by the references awaiting a load
+    size_t numAssets() const
+      { return m_assetOrder.size(); }
+
+    /// \brief  resets the batch
+    void clear()
+      { m_pending.clear(); m_assetOrder.clear(); m_referencesByNamespace.clear(); m_indexed = false; }
+
+    std::vector<PendingReference> m_pending; ///< the references awaiting a load
+    std::unordered_map<std::string, size_t> m_assetOrder; ///< maps a resolved asset path to the order in which it was first seen
+    std::unordered_map<std::string, MObjectHandle> m_referencesByNamespace; ///< the reference nodes in the scene before the batch started
+    bool m_indexed = false; ///< true once m_referencesByNamespace has been built
+  };
+
+  /// \brief  Creates (or updates) the maya reference for the prim.
+  /// \param  prim the MayaReference prim
+  /// \param  parent the transform the referenced nodes will be parented under
+  /// \param  context the translator context
+  /// \param  batch if not null, the reference is created unloaded and added to the batch. Call loadReferences to
+  ///         complete the load. If null, the reference is loaded immediately.
+  /// \return MS::kSuccess if the reference was created
+  MStatus LoadMayaReference(const UsdPrim& prim, MObject& parent, TranslatorContextPtr context,
+                            ReferenceBatch* batch = nullptr) const;
+
+  /// \brief  Loads all of the references gathered in the batch, and then clears it. The references are grouped by
+  ///         asset, so that only the first load of each asset reads it from disk, and the remaining loads of that
+  ///         asset find it in the file cache.
+  /// \param  batch the batch of references to load
+  /// \return MS::kSuccess if all of the references loaded
+  MStatus loadReferences(ReferenceBatch& batch) const;
+
   MStatus UnloadMayaReference(MObject& parent) const;
   MStatus update(const UsdPrim& prim, MObject parent, MObject refNode=MObject::kNullObj) const;
 
 private:
   MStatus connectReferenceAssociatedNode(MFnDagNode& dagNode, MFnReference& refNode) const;
+  MObject findReferenceForNamespace(const MString& rigNamespace, ReferenceBatch* batch) const;
+  void setAssociatedReferenceNode(const UsdPrim& prim, MFnReference& refNode) const;
 
   static const TfToken m_namespaceName;
   static const TfToken m_referenceName;
@@ -57,12 +118,17 @@ private:
 
   MStatus initialize() override;
   MStatus import(const UsdPrim& prim, MObject& parent, MObject& createdObj) override;
+  MStatus postImport(const UsdPrim& prim) override;
   MStatus tearDown(const SdfPath& path) override;
   MStatus update(const UsdPrim& path) override;
   bool supportsUpdate() const override 
     { return true; }
 
   MayaReferenceLogic m_mayaReferenceLogic;
+
+  /// references created by import, loaded together by the first call to postImport. Only imports into a proxy shape
+  /// are batched, since the import command has no post import pass.
+  MayaReferenceLogic::ReferenceBatch m_batch;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
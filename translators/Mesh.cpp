@@ -52,15 +52,54 @@ MStatus Mesh::initialize()
   return MStatus::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+/// the points, normals, and topology of a mesh, read in the parallel read phase of an import
+struct MeshPrimData : public TranslatorAbstract::PrimData
+{
+  AL::usdmaya::utils::MeshImportData mesh;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+UsdTimeCode Mesh::importTimeCode() const
+{
+  TranslatorContextPtr ctx = context();
+  return (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorAbstract::PrimDataPtr Mesh::readPrimData(const UsdPrim& prim)
+{
+  MeshPrimData* data = new MeshPrimData;
+  data->mesh.read(UsdGeomMesh(prim), importTimeCode());
+  return PrimDataPtr(data);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
+{
+  return importPrimData(prim, parent, createdObj, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::importPrimData(const UsdPrim& prim, MObject& parent, MObject& createdObj, const PrimData* data)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("Mesh::import prim=%s\n", prim.GetPath().GetText());
 
   const UsdGeomMesh mesh(prim);
 
   TranslatorContextPtr ctx = context();
-  UsdTimeCode timeCode = (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+  UsdTimeCode timeCode = importTimeCode();
+
+  // use the data from the parallel read phase if we have it, otherwise read it now
+  AL::usdmaya::utils::MeshImportData meshData;
+  if(data)
+  {
+    meshData = static_cast<const MeshPrimData*>(data)->mesh;
+  }
+  else
+  {
+    meshData.read(mesh, timeCode);
+  }
 
   bool parentUnmerged = false;
   TfToken val;
@@ -74,7 +113,7 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
     dagName += "Shape";
   }
 
-  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, dagName, timeCode);
+  AL::usdmaya::utils::MeshImportContext importContext(mesh, meshData, parent, dagName, timeCode);
   importContext.applyVertexNormals();
   importContext.applyHoleFaces();
   importContext.applyVertexCreases();
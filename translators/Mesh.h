@@ -33,6 +33,8 @@ public:
 private:
   MStatus initialize() override;
   MStatus import(const UsdPrim& prim, MObject& parent, MObject& createdObj) override;
+  PrimDataPtr readPrimData(const UsdPrim& prim) override;
+  MStatus importPrimData(const UsdPrim& prim, MObject& parent, MObject& createdObj, const PrimData* data) override;
   UsdPrim exportObject(UsdStageRefPtr stage, MDagPath dagPath, const SdfPath& usdPath,
                        const ExporterParams& params) override;
   MStatus tearDown(const SdfPath& path) override;
@@ -43,6 +45,8 @@ private:
     { return false; } // Turned off supportsUpdate to get tearDown working correctly
   bool importableByDefault() const override
     { return false; }
+  bool supportsParallelRead() const override
+    { return true; }
 
   ExportFlag canExport(const MObject& obj) override
     { return obj.hasFn(MFn::kMesh) ? ExportFlag::kFallbackSupport : ExportFlag::kNotSupported; }
@@ -54,6 +58,7 @@ private:
     kDynamicAttributes = 1 << 1
   };
   void writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options = kDynamicAttributes);
+  UsdTimeCode importTimeCode() const;
 
 };
 
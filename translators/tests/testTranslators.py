@@ -123,6 +123,88 @@ class TestTranslator(unittest.TestCase):
         self.assertEqual(mc.getAttr('cubeNS:pCube1.translate')[0], (4.0, 5.0, 6.0))
  
   
+    def testMayaReference_BatchedLoading(self):
+        '''Test that each prim gets its own reference, and that the references to each asset are loaded together.'''
+        import os
+        import time
+        import maya.api.OpenMaya as om
+        from pxr import Sdf
+
+        loadHistory = []
+
+        def recordRefLoad(refNodeMobj, mFileObject, clientData):
+            loadHistory.append(mFileObject.resolvedFullName())
+
+        numAssets = 4
+        assetPaths = []
+        for i in range(numAssets):
+            mc.file(new=1, f=1)
+            mc.polyCube(name='asset%d' % i)
+            assetFile = tempfile.NamedTemporaryFile(suffix='.ma', prefix='test_MayaReferenceBatchAsset_', delete=False)
+            assetFile.close()
+            mc.file(rename=assetFile.name)
+            mc.file(save=1, force=1, type='mayaAscii')
+            assetPaths.append(assetFile.name)
+
+        def importSyntheticScene(numPrims):
+            stage = Usd.Stage.CreateInMemory()
+            UsdGeom.Xform.Define(stage, '/world')
+            for i in range(numPrims):
+                prim = stage.DefinePrim('/world/rig%d' % i, 'ALMayaReference')
+                prim.CreateAttribute('mayaReference', Sdf.ValueTypeNames.Asset).Set(assetPaths[i % numAssets])
+                prim.CreateAttribute('mayaNamespace', Sdf.ValueTypeNames.String).Set('rig%d' % i)
+            tempFile = tempfile.NamedTemporaryFile(suffix='.usda', prefix='test_MayaReferenceBatch_', delete=False)
+            tempFile.close()
+            stage.Export(tempFile.name)
+
+            mc.file(new=1, f=1)
+            del loadHistory[:]
+            id = om.MSceneMessage.addReferenceCallback(om.MSceneMessage.kBeforeLoadReference, recordRefLoad)
+            start = time.time()
+            mc.AL_usdmaya_ProxyShapeImport(file=tempFile.name)
+            elapsed = time.time() - start
+            om.MMessage.removeCallback(id)
+            os.remove(tempFile.name)
+            return elapsed
+
+        def assertOneReferencePerPrim(numPrims):
+            refs = [r for r in mc.ls(type='reference') if r != 'sharedReferenceNode']
+            self.assertEqual(len(refs), numPrims)
+            for i in range(numPrims):
+                self.assertEqual(1, len(mc.ls('rig%d:asset%d' % (i, i % numAssets))))
+            # every prim's reference is loaded, and the loads of each asset are consecutive
+            self.assertEqual(len(loadHistory), numPrims)
+            self.assertEqual(len(set(loadHistory)), numAssets)
+            switches = sum(1 for a, b in zip(loadHistory, loadHistory[1:]) if a != b)
+            self.assertEqual(switches, numAssets - 1)
+
+        numPrims = 200
+        fewPrimsTime = importSyntheticScene(numAssets)
+        assertOneReferencePerPrim(numAssets)
+        manyPrimsTime = importSyntheticScene(numPrims)
+        assertOneReferencePerPrim(numPrims)
+        print('MayaReference batched loading: %d prims %fs (%fs per asset), %d prims %fs (%fs per asset, %d unique assets)' %
+              (numAssets, fewPrimsTime, fewPrimsTime / numAssets, numPrims, manyPrimsTime, manyPrimsTime / numAssets, numAssets))
+
+        # the import command has no post import pass, so its references must be loaded as they are created
+        stage = Usd.Stage.CreateInMemory()
+        prim = stage.DefinePrim('/rig', 'ALMayaReference')
+        prim.CreateAttribute('mayaReference', Sdf.ValueTypeNames.Asset).Set(assetPaths[0])
+        prim.CreateAttribute('mayaNamespace', Sdf.ValueTypeNames.String).Set('imported')
+        tempFile = tempfile.NamedTemporaryFile(suffix='.usda', prefix='test_MayaReferenceImport_', delete=False)
+        tempFile.close()
+        stage.Export(tempFile.name)
+        mc.file(new=1, f=1)
+        mc.AL_usdmaya_ImportCommand(f=tempFile.name)
+        os.remove(tempFile.name)
+        refs = [r for r in mc.ls(type='reference') if r != 'sharedReferenceNode']
+        self.assertEqual(len(refs), 1)
+        self.assertTrue(mc.referenceQuery(refs[0], isLoaded=True))
+
+        mc.file(new=1, f=1)
+        for path in assetPaths:
+            os.remove(path)
+
     def testMesh_TranslatorExists(self):
         """
         Test that the Maya Reference Translator exists
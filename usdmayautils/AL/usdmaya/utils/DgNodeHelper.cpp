@@ -37,7 +37,16 @@
 #include "maya/MFnDoubleArrayData.h"
 #include "maya/MFnFloatArrayData.h"
 #include "maya/MFloatArray.h"
+#include "maya/MTimeArray.h"
+#include "maya/MArrayDataBuilder.h"
+#include "maya/MArrayDataHandle.h"
+#include "maya/MDataHandle.h"
+#include "maya/MFnUnitAttribute.h"
 
+#include "pxr/usd/sdf/types.h"
+
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 #include <cstring>
 
@@ -168,6 +177,91 @@ MStatus DgNodeHelper::setVec3(MObject node, MObject attr, MAngle x, MAngle y, MA
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Sets all of the elements of a multi attribute with a single plug write. The elements are added to an array
+///         data builder, which is then assigned to the plug, rather than setting the value of each element plug in turn.
+/// \param  plug the array plug
+/// \param  count the number of elements to set
+/// \param  setElement a functor called with the data handle, and the index, of each element
+/// \return true if the array was set, false if the caller should fall back to setting each element plug
+//----------------------------------------------------------------------------------------------------------------------
+template<typename SetElement>
+static bool setArrayElements(MPlug& plug, const size_t count, SetElement setElement)
+{
+  MStatus status;
+  bool written = false;
+  MDataHandle handle = plug.asMDataHandle();
+  {
+    MArrayDataHandle arrayHandle(handle, &status);
+    if(status)
+    {
+      MArrayDataBuilder builder = arrayHandle.builder(&status);
+      for(size_t i = 0; status && i != count; ++i)
+      {
+        MDataHandle element = builder.addElement(i, &status);
+        if(status)
+          setElement(element, i);
+      }
+      written = status && arrayHandle.set(builder) && plug.setMDataHandle(handle);
+    }
+  }
+  plug.destructHandle(handle);
+  return written;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool isNumericAttribute(const MObject& attribute, const MFnNumericData::Type type)
+{
+  return attribute.hasFn(MFn::kNumericAttribute) && MFnNumericAttribute(attribute).unitType() == type;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool isUnitAttribute(const MObject& attribute, const MFnUnitAttribute::Type type)
+{
+  return attribute.hasFn(MFn::kUnitAttribute) && MFnUnitAttribute(attribute).unitType() == type;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Sets all of the elements of a multi attribute whose elements are compounds of numChildren numeric attributes
+///         of the specified type, with a single plug write. Any other layout (e.g. nested compounds) is left to the
+///         caller to set one element plug at a time.
+/// \param  plug the array plug
+/// \param  values the tuples of child values for each element
+/// \param  count the number of elements to set
+/// \param  numChildren the number of children in each element
+/// \param  type the numeric type of each child
+/// \param  setValue a functor that sets the data handle of a child to a value
+/// \return true if the array was set, false if the caller should fall back to setting each element plug
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, typename SetValue>
+static bool setTupleArrayElements(MPlug& plug, const T* const values, const size_t count, const uint32_t numChildren,
+                                  const MFnNumericData::Type type, SetValue setValue)
+{
+  if(!count)
+    return false;
+
+  MObject children[4];
+  const MPlug first = plug.elementByLogicalIndex(0);
+  if(first.numChildren() != numChildren)
+    return false;
+  for(uint32_t k = 0; k < numChildren; ++k)
+  {
+    children[k] = first.child(k).attribute();
+    if(!isNumericAttribute(children[k], type))
+      return false;
+  }
+
+  return setArrayElements(plug, count, [&] (MDataHandle& element, const size_t i)
+  {
+    const T* const value = values + i * numChildren;
+    for(uint32_t k = 0; k < numChildren; ++k)
+    {
+      MDataHandle child = element.child(children[k]);
+      setValue(child, value[k]);
+    }
+  });
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus DgNodeHelper::setBoolArray(MObject node, MObject attribute, const bool* const values, const size_t count)
 {
@@ -175,6 +269,10 @@ MStatus DgNodeHelper::setBoolArray(MObject node, MObject attribute, const bool*
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kBoolean) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i) { element.setBool(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0; i != count; ++i)
@@ -192,6 +290,11 @@ MStatus DgNodeHelper::setBoolArray(const MObject& node, const MObject& attribute
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kBoolean) &&
+     setArrayElements(plug, values.size(), [&values] (MDataHandle& element, const size_t i)
+       { element.setBool(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(values.size()), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, n = values.size(); i != n; ++i)
@@ -209,6 +312,10 @@ MStatus DgNodeHelper::setInt8Array(MObject node, MObject attribute, const int8_t
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kChar) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i) { element.setChar(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0; i != count; ++i)
@@ -226,6 +333,10 @@ MStatus DgNodeHelper::setInt16Array(MObject node, MObject attribute, const int16
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kShort) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i) { element.setShort(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0; i != count; ++i)
@@ -243,6 +354,10 @@ MStatus DgNodeHelper::setInt32Array(MObject node, MObject attribute, const int32
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kInt) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i) { element.setInt(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0; i != count; ++i)
@@ -260,6 +375,10 @@ MStatus DgNodeHelper::setInt64Array(MObject node, MObject attribute, const int64
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kInt64) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i) { element.setInt64(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0; i != count; ++i)
@@ -277,6 +396,11 @@ MStatus DgNodeHelper::setHalfArray(MObject node, MObject attribute, const GfHalf
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kFloat) &&
+     setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i)
+       { element.setFloat(AL::usd::utils::half2float_1f(values[i])); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   size_t count8 = count & ~0x7ULL;
@@ -340,6 +464,11 @@ MStatus DgNodeHelper::setFloatArray(MObject node, MObject attribute, const float
     }
     else
     {
+      if(isNumericAttribute(attribute, MFnNumericData::kFloat) &&
+         setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i)
+           { element.setFloat(values[i]); }))
+        return MS::kSuccess;
+
       AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
       for(size_t i = 0; i != count; ++i)
       {
@@ -374,6 +503,11 @@ MStatus DgNodeHelper::setDoubleArray(MObject node, MObject attribute, const doub
     }
     else
     {
+      if(isNumericAttribute(attribute, MFnNumericData::kDouble) &&
+         setArrayElements(plug, count, [values] (MDataHandle& element, const size_t i)
+           { element.setDouble(values[i]); }))
+        return MS::kSuccess;
+
       AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
       for(size_t i = 0; i != count; ++i)
       {
@@ -392,6 +526,10 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const int32_
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 2, MFnNumericData::kInt,
+                           [] (MDataHandle& child, const int32_t value) { child.setInt(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
@@ -411,6 +549,10 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const GfHalf
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 2, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const GfHalf value) { child.setFloat(AL::usd::utils::half2float_1f(value)); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   size_t count4 = count & ~0x3ULL;
@@ -463,6 +605,10 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const float*
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 2, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const float value) { child.setFloat(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
@@ -482,6 +628,10 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const double
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 2, MFnNumericData::kDouble,
+                           [] (MDataHandle& child, const double value) { child.setDouble(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
@@ -501,6 +651,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const int32_
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 3, MFnNumericData::kInt,
+                           [] (MDataHandle& child, const int32_t value) { child.setInt(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
   {
@@ -519,6 +673,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const GfHalf
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 3, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const GfHalf value) { child.setFloat(AL::usd::utils::half2float_1f(value)); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
   size_t count8 = count & ~0x7ULL;
   for(size_t i = 0, j = 0; i != count8; i += 8, j += 24)
@@ -561,6 +719,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const float*
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 3, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const float value) { child.setFloat(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
@@ -581,6 +743,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const double
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 3, MFnNumericData::kDouble,
+                           [] (MDataHandle& child, const double value) { child.setDouble(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
@@ -603,6 +769,10 @@ MStatus DgNodeHelper::setVec4Array(MObject node, MObject attribute, const GfHalf
     return MS::kFailure;
   }
 
+  if(setTupleArrayElements(plug, values, count, 4, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const GfHalf value) { child.setFloat(AL::usd::utils::half2float_1f(value)); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
   size_t count2 = count & ~0x1ULL;
 
@@ -642,6 +812,10 @@ MStatus DgNodeHelper::setVec4Array(MObject node, MObject attribute, const int* c
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 4, MFnNumericData::kInt,
+                           [] (MDataHandle& child, const int32_t value) { child.setInt(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 4)
@@ -663,6 +837,10 @@ MStatus DgNodeHelper::setVec4Array(MObject node, MObject attribute, const float*
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 4, MFnNumericData::kFloat,
+                           [] (MDataHandle& child, const float value) { child.setFloat(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 4)
@@ -684,6 +862,10 @@ MStatus DgNodeHelper::setVec4Array(MObject node, MObject attribute, const double
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(setTupleArrayElements(plug, values, count, 4, MFnNumericData::kDouble,
+                           [] (MDataHandle& child, const double value) { child.setDouble(value); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
   for(size_t i = 0, j = 0; i != count; ++i, j += 4)
@@ -845,6 +1027,11 @@ MStatus DgNodeHelper::setTimeArray(MObject node, MObject attribute, const float*
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isUnitAttribute(attribute, MFnUnitAttribute::kTime) &&
+     setArrayElements(plug, count, [values, unitConversion] (MDataHandle& element, const size_t i)
+       { element.setMTime(MTime(unitConversion * values[i], MTime::k6000FPS)); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
 #if AL_UTILS_ENABLE_SIMD
@@ -893,6 +1080,11 @@ MStatus DgNodeHelper::setAngleArray(MObject node, MObject attribute, const float
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isUnitAttribute(attribute, MFnUnitAttribute::kAngle) &&
+     setArrayElements(plug, count, [values, unitConversion] (MDataHandle& element, const size_t i)
+       { element.setMAngle(MAngle(unitConversion * values[i], MAngle::internalUnit())); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
 #if AL_UTILS_ENABLE_SIMD
@@ -941,6 +1133,11 @@ MStatus DgNodeHelper::setDistanceArray(MObject node, MObject attribute, const fl
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isUnitAttribute(attribute, MFnUnitAttribute::kDistance) &&
+     setArrayElements(plug, count, [values, unitConversion] (MDataHandle& element, const size_t i)
+       { element.setMDistance(MDistance(unitConversion * values[i], MDistance::internalUnit())); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
 #if AL_UTILS_ENABLE_SIMD
@@ -985,6 +1182,11 @@ MStatus DgNodeHelper::setUsdBoolArray(const MObject& node, const MObject& attrib
   if(!plug || !plug.isArray())
     return MS::kFailure;
 
+  if(isNumericAttribute(attribute, MFnNumericData::kBoolean) &&
+     setArrayElements(plug, values.size(), [&values] (MDataHandle& element, const size_t i)
+       { element.setBool(values[i]); }))
+    return MS::kSuccess;
+
   AL_MAYA_CHECK_ERROR(plug.setNumElements(values.size()), "DgNodeTranslator: attribute array could not be resized");
 
   for(size_t i = 0, n = values.size(); i != n; ++i)
@@ -996,53 +1198,161 @@ MStatus DgNodeHelper::setUsdBoolArray(const MObject& node, const MObject& attrib
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MStatus DgNodeHelper::setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op)
+template<typename T>
+static void readAnimSamples(const UsdAttributeQuery& query, const std::vector<double>& sampleTimes,
+                            std::vector<double>& times, std::vector<double>& values, const double conversionFactor)
 {
-  MStatus status;
-  const char* const errorString = "DgNodeHelper::setAngleAnim";
-
-  MPlug plug(node, attr);
-  MFnAnimCurve fnCurve;
-  fnCurve.create(plug, NULL, &status);
-  AL_MAYA_CHECK_ERROR(status, errorString);
+  T value;
+  for(auto const& timeValue: sampleTimes)
+  {
+    if(query.Get(&value, timeValue))
+    {
+      times.push_back(timeValue);
+      values.push_back(double(value) * conversionFactor);
+    }
+  }
+}
 
-  std::vector<double> times;
-  op.GetTimeSamples(&times);
+//----------------------------------------------------------------------------------------------------------------------
+static bool readAnimSamples(const UsdAttribute& usdAttr, std::vector<double>& times, std::vector<double>& values,
+                            const double conversionFactor)
+{
+  // an attribute query caches the value resolution, which would otherwise be repeated for each sample
+  UsdAttributeQuery query(usdAttr);
+  std::vector<double> sampleTimes;
+  query.GetTimeSamples(&sampleTimes);
+  times.reserve(sampleTimes.size());
+  values.reserve(sampleTimes.size());
 
-  const float conversionFactor = 0.0174533f;
+  const SdfValueTypeName typeName = usdAttr.GetTypeName();
+  if(typeName == SdfValueTypeNames->Float)
+    readAnimSamples<float>(query, sampleTimes, times, values, conversionFactor);
+  else
+  if(typeName == SdfValueTypeNames->Double)
+    readAnimSamples<double>(query, sampleTimes, times, values, conversionFactor);
+  else
+  if(typeName == SdfValueTypeNames->Half)
+    readAnimSamples<GfHalf>(query, sampleTimes, times, values, conversionFactor);
+  else
+    return false;
+  return true;
+}
 
-  float value = 0;
-  for(auto const& timeValue: times)
+//----------------------------------------------------------------------------------------------------------------------
+static bool isScalarAnimCurve(const MFnAnimCurve& fnCurve, const char* const caller)
+{
+  switch(fnCurve.animCurveType())
   {
-    const bool retValue = op.GetAs<float>(&value, timeValue);
-    if (!retValue) continue;
+    case MFnAnimCurve::kAnimCurveTL:
+    case MFnAnimCurve::kAnimCurveTA:
+    case MFnAnimCurve::kAnimCurveTU:
+      return true;
+    default:
+      std::cout << "[" << caller << "] Unexpected anim curve type: " << fnCurve.animCurveType() << std::endl;
+      break;
+  }
+  return false;
+}
 
-    MTime tm(timeValue, MTime::kFilm);
+//----------------------------------------------------------------------------------------------------------------------
+MStatus DgNodeHelper::addAnimCurveKeys(MFnAnimCurve& fnCurve, const std::vector<double>& times,
+                                       const std::vector<double>& values, bool reduceLinearKeys)
+{
+  const uint32_t count = std::min(times.size(), values.size());
+  if(!count)
+  {
+    return MS::kSuccess;
+  }
 
-    switch (fnCurve.animCurveType())
-    {
-      case MFnAnimCurve::kAnimCurveTL:
-      case MFnAnimCurve::kAnimCurveTA:
-      case MFnAnimCurve::kAnimCurveTU:
+  MTimeArray keyTimes;
+  MDoubleArray keyValues;
+  keyTimes.setSizeIncrement(count);
+  keyValues.setSizeIncrement(count);
+  keyTimes.append(MTime(times[0], MTime::kFilm));
+  keyValues.append(values[0]);
+
+  if(reduceLinearKeys)
+  {
+    // Each run of keys starts at a kept key, and extends for as long as the following keys stay on the line through
+    // the first two keys of the run. The last key of the run is then kept, and starts the next run. The indices of
+    // the kept keys that start a run from which keys were removed are recorded, so that only the tangents of those
+    // segments need to be made linear.
+    const double tolerance = 1e-6;
+    std::vector<uint32_t> collapsedRuns;
+    uint32_t start = 0;
+    while(start + 1 < count)
+    {
+      const double slope = (values[start + 1] - values[start]) / (times[start + 1] - times[start]);
+      uint32_t end = start + 1;
+      while(end + 1 < count &&
+            std::abs(values[end + 1] - (values[start] + slope * (times[end + 1] - times[start]))) <= tolerance)
       {
-        fnCurve.addKey(tm, value * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-        AL_MAYA_CHECK_ERROR(status, errorString);
-        break;
+        ++end;
       }
-      default:
+      if(end > start + 1)
       {
-        std::cout << "[DgNodeHelper::setAngleAnim] Unexpected anim curve type: " << fnCurve.animCurveType() << std::endl;
-        break;
+        collapsedRuns.push_back(keyTimes.length() - 1);
       }
+      keyTimes.append(MTime(times[end], MTime::kFilm));
+      keyValues.append(values[end]);
+      start = end;
+    }
+
+    MStatus status = fnCurve.addKeys(&keyTimes, &keyValues, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal);
+    if(!status)
+    {
+      return status;
     }
+
+    // the curve must pass through the removed keys, so each collapsed run is a straight line between its end keys
+    for(const uint32_t key : collapsedRuns)
+    {
+      fnCurve.setOutTangentType(key, MFnAnimCurve::kTangentLinear);
+      fnCurve.setInTangentType(key + 1, MFnAnimCurve::kTangentLinear);
+    }
+    return MS::kSuccess;
+  }
+
+  for(uint32_t i = 1; i < count; ++i)
+  {
+    keyTimes.append(MTime(times[i], MTime::kFilm));
+    keyValues.append(values[i]);
+  }
+  return fnCurve.addKeys(&keyTimes, &keyValues, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus DgNodeHelper::setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op, bool reduceLinearKeys)
+{
+  MStatus status;
+  const char* const errorString = "DgNodeHelper::setAngleAnim";
+
+  MPlug plug(node, attr);
+  MFnAnimCurve fnCurve;
+  fnCurve.create(plug, NULL, &status);
+  AL_MAYA_CHECK_ERROR(status, errorString);
+
+  if(!isScalarAnimCurve(fnCurve, errorString))
+  {
+    return MS::kSuccess;
+  }
+
+  const double conversionFactor = 0.0174533;
+
+  std::vector<double> times, values;
+  if(!readAnimSamples(op.GetAttr(), times, values, conversionFactor))
+  {
+    std::cout << "[DgNodeHelper::setAngleAnim] Unsupported attribute type: " << op.GetTypeName().GetAsToken().GetText() << std::endl;
+    return MS::kSuccess;
   }
 
+  AL_MAYA_CHECK_ERROR(addAnimCurveKeys(fnCurve, times, values, reduceLinearKeys), errorString);
   return MS::kSuccess;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus DgNodeHelper::setFloatAttrAnim(const MObject node, const MObject attr, UsdAttribute usdAttr,
-                                           double conversionFactor)
+                                           double conversionFactor, bool reduceLinearKeys)
 {
   if (!usdAttr.GetNumTimeSamples())
   {
@@ -1068,35 +1378,19 @@ MStatus DgNodeHelper::setFloatAttrAnim(const MObject node, const MObject attr, U
   fnCurve.create(plug, NULL, &status);
   AL_MAYA_CHECK_ERROR(status, errorString);
 
-  std::vector<double> times;
-  usdAttr.GetTimeSamples(&times);
-
-  float value;
-  for(auto const& timeValue: times)
+  if(!isScalarAnimCurve(fnCurve, errorString))
   {
-    const bool retValue = usdAttr.Get(&value, timeValue);
-    if(!retValue) continue;
-
-    MTime tm(timeValue, MTime::kFilm);
+    return MS::kSuccess;
+  }
 
-    switch(fnCurve.animCurveType())
-    {
-      case MFnAnimCurve::kAnimCurveTL:
-      case MFnAnimCurve::kAnimCurveTA:
-      case MFnAnimCurve::kAnimCurveTU:
-      {
-        fnCurve.addKey(tm, value * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-        AL_MAYA_CHECK_ERROR(status, errorString);
-        break;
-      }
-      default:
-      {
-        std::cout << "[DgNodeTranslator::setFloatAttrAnim] OTHER ANIM CURVE TYPE! = " << fnCurve.animCurveType() << std::endl;
-        break;
-      }
-    }
+  std::vector<double> times, values;
+  if(!readAnimSamples(usdAttr, times, values, conversionFactor))
+  {
+    std::cout << "[DgNodeTranslator::setFloatAttrAnim] Unsupported attribute type: " << usdAttr.GetTypeName().GetAsToken().GetText() << std::endl;
+    return MS::kSuccess;
   }
 
+  AL_MAYA_CHECK_ERROR(addAnimCurveKeys(fnCurve, times, values, reduceLinearKeys), errorString);
   return MS::kSuccess;
 }
 
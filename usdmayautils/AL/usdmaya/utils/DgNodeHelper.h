@@ -31,6 +31,7 @@
 #include "pxr/base/gf/half.h" //Just for convenient half support
 #include "pxr/pxr.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/attributeQuery.h"
 #include "pxr/usd/usdGeom/xformOp.h"
 
 #include "AL/usdmaya/utils/ForwardDeclares.h"
@@ -1211,31 +1212,49 @@ public:
   /// \name   animation
   //--------------------------------------------------------------------------------------------------------------------
 
+  /// \brief  adds all of the keys to an animation curve with a single call, rather than a call per key.
+  /// \param  fnCurve the animation curve to add the keys to. Any existing keys on the curve are replaced.
+  /// \param  times the key frame times (in MTime::kFilm units), in increasing order
+  /// \param  values the key frame values
+  /// \param  reduceLinearKeys if true, keys that lie on a straight line between their neighbours are removed. The keys
+  ///         either side of each removed run are given linear tangents on that side, so that the curve still passes
+  ///         through the removed values, and all other tangents are global. If false, every key is added with global
+  ///         tangents. This is not currently exposed as an import option.
+  /// \return MS::kSuccess on success, error code otherwise
+  AL_USDMAYA_UTILS_PUBLIC
+  static MStatus addAnimCurveKeys(MFnAnimCurve& fnCurve, const std::vector<double>& times,
+                                  const std::vector<double>& values, bool reduceLinearKeys = false);
+
   /// \brief  creates animation curves in maya for the specified attribute
   /// \param  node the node instance the animated attribute belongs to
   /// \param  attr the attribute handle
   /// \param  op the USD geometry operation that contains the animation data
   /// \param  conversionFactor a scaling factor to apply to the source key frames on import.
+  /// \param  reduceLinearKeys if true, keys that can be linearly interpolated from their neighbours are not created
   /// \return MS::kSuccess on success, error code otherwise
   template<typename T>
-  static MStatus setVec3Anim(MObject node, MObject attr, const UsdGeomXformOp op, double conversionFactor = 1.0);
+  static MStatus setVec3Anim(MObject node, MObject attr, const UsdGeomXformOp op, double conversionFactor = 1.0,
+                             bool reduceLinearKeys = false);
 
   /// \brief  creates animation curves to animate the specified angle attribute
   /// \param  node the node instance the animated attribute belongs to
   /// \param  attr the attribute handle
   /// \param  op the USD transform op that contains the keyframe data
+  /// \param  reduceLinearKeys if true, keys that can be linearly interpolated from their neighbours are not created
   /// \return MS::kSuccess on success, error code otherwise
   AL_USDMAYA_UTILS_PUBLIC
-  static MStatus setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op);
+  static MStatus setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op, bool reduceLinearKeys = false);
 
   /// \brief  creates animation curves in maya for the specified attribute
   /// \param  node the node instance the animated attribute belongs to
   /// \param  attr the attribute handle
-  /// \param  usdAttr the USD attribute that contains the keyframe data
+  /// \param  usdAttr the USD attribute that contains the keyframe data. This may be a half, float, or double attribute.
   /// \param  conversionFactor a scaling to apply to the key frames on import
+  /// \param  reduceLinearKeys if true, keys that can be linearly interpolated from their neighbours are not created
   /// \return MS::kSuccess on success, error code otherwise
   AL_USDMAYA_UTILS_PUBLIC
-  static MStatus setFloatAttrAnim(MObject node, MObject attr, UsdAttribute usdAttr, double conversionFactor = 1.0);
+  static MStatus setFloatAttrAnim(MObject node, MObject attr, UsdAttribute usdAttr, double conversionFactor = 1.0,
+                                  bool reduceLinearKeys = false);
 
   /// \brief  creates animation curves in maya for the visibility attribute
   /// \param  node the node instance the animated attribute belongs to
@@ -1947,7 +1966,8 @@ inline MStatus DgNodeHelper::setUsdDoubleArray(const MObject& node, const MObjec
 
 //----------------------------------------------------------------------------------------------------------------------
 template<typename T>
-MStatus DgNodeHelper::setVec3Anim(MObject node, MObject attr, const UsdGeomXformOp op, double conversionFactor)
+MStatus DgNodeHelper::setVec3Anim(MObject node, MObject attr, const UsdGeomXformOp op, double conversionFactor,
+                                  bool reduceLinearKeys)
 {
   MPlug plug(node, attr);
   MStatus status;
@@ -1965,44 +1985,47 @@ MStatus DgNodeHelper::setVec3Anim(MObject node, MObject attr, const UsdGeomXform
   acFnSetZ.create(plug.child(2), NULL, &status);
   AL_MAYA_CHECK_ERROR(status, xformErrorCreate);
 
-  std::vector<double> times;
-  op.GetTimeSamples(&times);
+  switch (acFnSetX.animCurveType())
+  {
+    case MFnAnimCurve::kAnimCurveTL: // time->distance: translation
+    case MFnAnimCurve::kAnimCurveTA: // time->angle: rotation
+    case MFnAnimCurve::kAnimCurveTU: // time->double: scale
+      break;
+    default:
+      return MS::kSuccess;
+  }
 
-  const char* const xformErrorKey = "DgNodeTranslator:setVec3Anim error setting key on animation curve";
+  // read all of the samples, and then hand each curve its keys in one go
+  UsdAttributeQuery query(op.GetAttr());
+  std::vector<double> sampleTimes;
+  query.GetTimeSamples(&sampleTimes);
 
-  T value(0);
-  for(auto const& timeValue: times)
+  std::vector<double> times, x, y, z;
+  times.reserve(sampleTimes.size());
+  x.reserve(sampleTimes.size());
+  y.reserve(sampleTimes.size());
+  z.reserve(sampleTimes.size());
+
+  VtValue vtValue;
+  for(auto const& timeValue: sampleTimes)
   {
-    const bool retValue = op.GetAs<T>(&value, timeValue);
-    if (!retValue) continue;
-
-    MTime tm(timeValue, MTime::kFilm);
-
-    switch (acFnSetX.animCurveType())
-    {
-      case MFnAnimCurve::kAnimCurveTL: // time->distance: translation
-      case MFnAnimCurve::kAnimCurveTA: // time->angle: rotation
-      case MFnAnimCurve::kAnimCurveTU: // time->double: scale
-      {
-        acFnSetX.addKey(tm, value[0] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-        AL_MAYA_CHECK_ERROR(status, xformErrorKey);
-        acFnSetY.addKey(tm, value[1] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-        AL_MAYA_CHECK_ERROR(status, xformErrorKey);
-        acFnSetZ.addKey(tm, value[2] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-        AL_MAYA_CHECK_ERROR(status, xformErrorKey);
-        break;
-      }
-      default:
-      {
-        break;
-      }
-    }
+    if(!query.Get(&vtValue, timeValue) || !vtValue.CanCast<T>())
+      continue;
+
+    const T value = vtValue.IsHolding<T>() ? vtValue.UncheckedGet<T>() : VtValue::Cast<T>(vtValue).UncheckedGet<T>();
+    times.push_back(timeValue);
+    x.push_back(value[0] * conversionFactor);
+    y.push_back(value[1] * conversionFactor);
+    z.push_back(value[2] * conversionFactor);
   }
 
+  const char* const xformErrorKey = "DgNodeTranslator:setVec3Anim error setting keys on animation curve";
+  AL_MAYA_CHECK_ERROR(addAnimCurveKeys(acFnSetX, times, x, reduceLinearKeys), xformErrorKey);
+  AL_MAYA_CHECK_ERROR(addAnimCurveKeys(acFnSetY, times, y, reduceLinearKeys), xformErrorKey);
+  AL_MAYA_CHECK_ERROR(addAnimCurveKeys(acFnSetZ, times, z, reduceLinearKeys), xformErrorKey);
   return MS::kSuccess;
 }
 
-
 //----------------------------------------------------------------------------------------------------------------------
 } // utils
 } // usdmaya
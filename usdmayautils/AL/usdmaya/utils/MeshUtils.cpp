@@ -180,37 +180,42 @@ void convert3DArrayTo4DArray(const float* const input, float* const output, size
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void MeshImportContext::gatherFaceConnectsAndVertices()
+void MeshImportData::read(const UsdGeomMesh& mesh, UsdTimeCode timeCode)
 {
-  VtArray<GfVec3f> pointData;
-  VtArray<GfVec3f> normalsData;
-  VtArray<int> faceVertexCounts;
-  VtArray<int> faceVertexIndices;
+  mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts, timeCode);
+  mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices, timeCode);
+  mesh.GetPointsAttr().Get(&points, timeCode);
+  hasNormals = mesh.GetNormalsAttr().HasAuthoredValueOpinion();
+  if(hasNormals)
+  {
+    mesh.GetNormalsAttr().Get(&normals, timeCode);
+    normalsInterpolation = mesh.GetNormalsInterpolation();
+  }
+  TfToken orientation;
+  leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
+}
 
-  UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-  UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+//----------------------------------------------------------------------------------------------------------------------
+void MeshImportContext::gatherFaceConnectsAndVertices(const MeshImportData& data)
+{
+  const VtArray<GfVec3f>& pointData = data.points;
+  const VtArray<GfVec3f>& normalsData = data.normals;
+  const VtArray<int>& faceVertexCounts = data.faceVertexCounts;
+  const VtArray<int>& faceVertexIndices = data.faceVertexIndices;
 
-  fvc.Get(&faceVertexCounts, m_timeCode);
   counts.setLength(faceVertexCounts.size());
-  fvi.Get(&faceVertexIndices, m_timeCode);
   connects.setLength(faceVertexIndices.size());
 
-  mesh.GetPointsAttr().Get(&pointData, m_timeCode);
-  if(mesh.GetNormalsAttr().HasAuthoredValueOpinion())
-  {
-    mesh.GetNormalsAttr().Get(&normalsData, m_timeCode);
-  }
-
   points.setLength(pointData.size());
   convert3DArrayTo4DArray((const float*)pointData.cdata(), &points[0].x, pointData.size());
 
   memcpy(&counts[0], (const int32_t*)faceVertexCounts.cdata(), sizeof(int32_t) * faceVertexCounts.size());
   memcpy(&connects[0], (const int32_t*)faceVertexIndices.cdata(), sizeof(int32_t) * faceVertexIndices.size());
 
-  if(mesh.GetNormalsAttr().HasAuthoredValueOpinion())
+  if(data.hasNormals)
   {
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->faceVarying ||
-       mesh.GetNormalsInterpolation() == UsdGeomTokens->varying)
+    if(data.normalsInterpolation == UsdGeomTokens->faceVarying ||
+       data.normalsInterpolation == UsdGeomTokens->varying)
     {
       normals.setLength(normalsData.size());
       double* const optr = &normals[0].x;
@@ -223,7 +228,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
       }
     }
     else
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->uniform)
+    if(data.normalsInterpolation == UsdGeomTokens->uniform)
     {
       const float* const iptr = (const float*)normalsData.cdata();
       normals.setLength(connects.length());
@@ -238,7 +243,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
       }
     }
     else
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->vertex)
+    if(data.normalsInterpolation == UsdGeomTokens->vertex)
     {
       const float* const iptr = (const float*)normalsData.cdata();
       normals.setLength(connects.length());
@@ -253,9 +258,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
   {
     // check for cases where data is left handed.
     // Maya fails
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, m_timeCode) && orientation == UsdGeomTokens->leftHanded);
-    if(leftHanded)
+    if(data.leftHanded)
     {
       size_t numPoints = pointData.size();
       size_t numFaces = faceVertexCounts.size();
@@ -123,6 +123,27 @@ AL_USDMAYA_UTILS_PUBLIC
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices);
 
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The USD geometry data required to construct a Maya mesh. Reading this data does not touch Maya, so it can be
+///         gathered for many meshes in parallel before the Maya meshes are created in serial.
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshImportData
+{
+  VtArray<GfVec3f> points; ///< the vertex positions
+  VtArray<GfVec3f> normals; ///< the authored normals (if any)
+  VtArray<int> faceVertexCounts; ///< the number of vertices in each face
+  VtArray<int> faceVertexIndices; ///< the vertex indices for each face-vertex
+  TfToken normalsInterpolation; ///< the interpolation of the normals
+  bool hasNormals = false; ///< true if the mesh has authored normals
+  bool leftHanded = false; ///< true if the mesh has a left handed orientation
+
+  /// \brief  reads the mesh data from USD
+  /// \param  mesh the usd geometry to read
+  /// \param  timeCode the time code at which to read the data
+  AL_USDMAYA_UTILS_PUBLIC
+  void read(const UsdGeomMesh& mesh, UsdTimeCode timeCode = UsdTimeCode::EarliestTime());
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class used to import mesh data from Usd into Maya
 //----------------------------------------------------------------------------------------------------------------------
@@ -138,7 +159,18 @@ private:
   MObject polyShape; ///< the handle to the created mesh shape
   UsdTimeCode m_timeCode; ///< the time at which to import the mesh
   AL_USDMAYA_UTILS_PUBLIC
-  void gatherFaceConnectsAndVertices();
+  void gatherFaceConnectsAndVertices(const MeshImportData& data);
+  void createMesh(const MeshImportData& data, MObject parentOrOwner, MString dagName)
+  {
+    gatherFaceConnectsAndVertices(data);
+    polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
+    fnMesh.findPlug("op", true).setBool(data.leftHanded);
+    // 
+    if(parentOrOwner.hasFn(MFn::kTransform))
+    {
+      fnMesh.setName(dagName);
+    }
+  }
 public:
 
   /// \brief  constructs the import context for the specified mesh
@@ -150,16 +182,23 @@ public:
   MeshImportContext(const UsdGeomMesh& mesh, MObject parentOrOwner, MString dagName, UsdTimeCode timeCode = UsdTimeCode::EarliestTime())
     : mesh(mesh), m_timeCode(timeCode)
   {
-    gatherFaceConnectsAndVertices();
-    polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
-    fnMesh.findPlug("op", true).setBool(leftHanded);
-    // 
-    if(parentOrOwner.hasFn(MFn::kTransform))
-    {
-      fnMesh.setName(dagName);
-    }
+    MeshImportData data;
+    data.read(mesh, timeCode);
+    createMesh(data, parentOrOwner, dagName);
+  }
+
+  /// \brief  constructs the import context for the specified mesh, from mesh data that has already been read from USD
+  /// \param  mesh the usd geometry to import
+  /// \param  data the points, normals, and topology previously read from the mesh at the timeCode
+  /// \param  parentOrOwner the maya transform that will be the parent transform of the geometry being imported, 
+  ///         or a mesh data objected created via MFnMeshData.
+  /// \param  dagName the name for the new mesh node
+  /// \param  timeCode the time code at which to gather the remaining data from USD
+  MeshImportContext(const UsdGeomMesh& mesh, const MeshImportData& data, MObject parentOrOwner, MString dagName,
+                    UsdTimeCode timeCode = UsdTimeCode::EarliestTime())
+    : mesh(mesh), m_timeCode(timeCode)
+  {
+    createMesh(data, parentOrOwner, dagName);
   }
 
   /// \brief  reads the HoleIndices attribute from the usd geometry, and assigns those values as invisible faces on